@@ -1,6 +1,9 @@
 /**
  * @file complex.c
- * @brief Defines a data structure and implements complex.h
+ * @brief Implements the PtComplex operations of complex.h
+ * 
+ * Each operation computes by value, with the corresponding 'V'
+ * operation, and allocates its result.
  * 
  * @author Bruno Silva (brunomnsilva@gmail.com)
  * @bug No known bugs.
@@ -12,20 +15,8 @@
 #include <stdlib.h>
 #include <math.h>
 
-typedef struct complex {
-    double real;
-    double imaginary;
-} Complex;
-
 PtComplex complexCreate (double re, double im) {
-    PtComplex c = (PtComplex) malloc( sizeof(Complex) );
-    
-    if( c == NULL) return NULL;
-
-    c->real = re;
-    c->imaginary = im;
-
-    return c;
+    return complexCreateV( complexV(re, im) );
 }
 
 int complexDestroy (PtComplex *ptC) {
@@ -40,6 +31,24 @@ int complexDestroy (PtComplex *ptC) {
     return COMPLEX_OK;
 }
 
+PtComplex complexCreateV (Complex value) {
+    PtComplex c = (PtComplex) malloc( sizeof(Complex) );
+    
+    if( c == NULL) return NULL;
+
+    (*c) = value;
+
+    return c;
+}
+
+int complexValue (PtComplex c, Complex *value) {
+    if( c == NULL ) return COMPLEX_NULL;
+
+    (*value) = (*c);
+
+    return COMPLEX_OK;
+}
+
 int complexRe (PtComplex c, double *re) {
     if( c == NULL ) return COMPLEX_NULL;
 
@@ -59,33 +68,19 @@ int complexIm (PtComplex c, double *im) {
 PtComplex complexAdd (PtComplex w, PtComplex z) {
     if( w == NULL || z == NULL) return NULL;
 
-    PtComplex c = (PtComplex) malloc( sizeof(Complex) );
-    
-    if( c == NULL) return NULL;
-
-    c->real = w->real + z->real;
-    c->imaginary = w->imaginary + z->imaginary;
-
-    return c;
+    return complexCreateV( complexAddV(*w, *z) );
 }
 
 PtComplex complexMultiply (PtComplex w, PtComplex z) {
     if( w == NULL || z == NULL) return NULL;
 
-    PtComplex c = complexCreate(0,0);
-    
-    if( c == NULL) return NULL;
-
-    c->real = (w->real * z->real - w->imaginary * z->imaginary);
-    c->imaginary = (w->imaginary * z->real + w->real * z->imaginary);
-
-    return c;
+    return complexCreateV( complexMultiplyV(*w, *z) );
 }
 
 int complexMod (PtComplex w, double* modulus) {
     if( w == NULL ) return COMPLEX_NULL;
 
-    (*modulus) = sqrt( w->real * w->real + w->imaginary * w->imaginary);
+    (*modulus) = complexModV(*w);
 
     return COMPLEX_OK;
 }
@@ -93,7 +88,7 @@ int complexMod (PtComplex w, double* modulus) {
 int complexArg (PtComplex w, double *argument) {
     if( w == NULL ) return COMPLEX_NULL;
 
-    (*argument) = atan2( w->real, w->imaginary );
+    (*argument) = complexArgV(*w);
 
     return COMPLEX_OK;
 }
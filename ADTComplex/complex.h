@@ -1,6 +1,13 @@
 /**
  * @file complex.h
- * @brief Defines the type PtComplex and associated operations.
+ * @brief Defines the types Complex and PtComplex and associated operations.
+ * 
+ * Complex numbers can be used by value, with the 'V' operations
+ * (e.g., complexAddV), which neither allocate memory nor fail, or
+ * through PtComplex pointers to allocated numbers, whose operations
+ * (e.g., complexAdd) compute by value and allocate the result.
+ * See also complexArena.h, to allocate many numbers and release
+ * them all at once.
  * 
  * @author Bruno Silva (brunomnsilva@gmail.com)
  * @bug No known bugs.
@@ -8,12 +15,79 @@
 
 #pragma once
 
+#include <math.h>
+
 #define COMPLEX_OK	    0
 #define COMPLEX_NULL	1
 
-struct complex;
+/** A complex number, passed and returned by value by the 'V' operations. */
+typedef struct complex {
+    double real;
+    double imaginary;
+} Complex;
+
 typedef struct complex* PtComplex;
 
+/**
+ * @brief Make a complex number, by value, from two `double`s.
+ * 
+ * @param re [in] real component
+ * @param im  [in] imaginary component
+ * 
+ * @return the complex number re + im*i
+ */
+static inline Complex complexV (double re, double im) {
+    Complex c = { re, im };
+    return c;
+}
+
+/**
+ * @brief Add two complex numbers together, by value.
+ * 
+ * @param w [in] first number
+ * @param z [in] second number
+ * 
+ * @return w + z
+ */
+static inline Complex complexAddV (Complex w, Complex z) {
+    return complexV(w.real + z.real, w.imaginary + z.imaginary);
+}
+
+/**
+ * @brief Multiply two complex numbers together, by value.
+ * 
+ * @param w [in] first number
+ * @param z [in] second number
+ * 
+ * @return w * z
+ */
+static inline Complex complexMultiplyV (Complex w, Complex z) {
+    return complexV(w.real * z.real - w.imaginary * z.imaginary,
+                    w.imaginary * z.real + w.real * z.imaginary);
+}
+
+/**
+ * @brief Take the magnitude (or modulus, or absolute) of a complex number.
+ * 
+ * @param w [in] the number
+ * 
+ * @return |w|
+ */
+static inline double complexModV (Complex w) {
+    return sqrt(w.real * w.real + w.imaginary * w.imaginary);
+}
+
+/**
+ * @brief Take the argument (or angle) of a complex number.
+ * 
+ * @param w [in] the number
+ * 
+ * @return the argument of 'w', in [-pi, pi]
+ */
+static inline double complexArgV (Complex w) {
+    return atan2(w.imaginary, w.real);
+}
+
 /**
  * @brief Create a new complex number from two `double`s.
  * 
@@ -35,6 +109,27 @@ PtComplex complexCreate (double re, double im);
 */
 int complexDestroy (PtComplex *ptC);
 
+/**
+ * @brief Create a new complex number from a value.
+ * 
+ * @param value [in] the number
+ * 
+ * @return PtComplex pointer to allocated complex number.
+ * @return NULL if unsufficient memory for allocation
+ */
+PtComplex complexCreateV (Complex value);
+
+/**
+* @brief Retrieve the value of a complex number.
+*
+* @param c [in] PtComplex pointer to the number's data structure.
+* @param value [out] Address of variable to hold result
+*
+* @return COMPLEX_OK and value assigned to '*value'
+* @return COMPLEX_NULL if 'c' is NULL
+*/
+int complexValue (PtComplex c, Complex *value);
+
 /**
 * @brief Retrieve the real part of the complex number.
 *
@@ -0,0 +1,134 @@
+/**
+ * @file complexArena.c
+ * @brief Implements complexArena.h with a list of chunks, each
+ * an array of complex numbers handed out in order.
+ * 
+ * Chunks double in size, from FIRST_CHUNK_NUMBERS up to
+ * MAX_CHUNK_NUMBERS numbers. Resetting rewinds the arena to its first
+ * chunk, so an arena that is reset after each evaluation stops
+ * allocating memory once its chunks hold the largest evaluation.
+ * 
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "complexArena.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#define FIRST_CHUNK_NUMBERS 256
+#define MAX_CHUNK_NUMBERS 65536
+
+typedef struct chunk {
+    struct chunk *next;
+    int capacity;
+    Complex numbers[];
+} Chunk;
+
+typedef struct complexArena {
+    Chunk *first;
+    Chunk *current;     /* chunk handing out numbers */
+    int used;           /* numbers of 'current' already handed out */
+} ComplexArena;
+
+static Chunk* chunkCreate (int capacity) {
+    Chunk *chunk = (Chunk*) malloc( sizeof(Chunk) + capacity * sizeof(Complex) );
+
+    if( chunk == NULL ) return NULL;
+
+    chunk->next = NULL;
+    chunk->capacity = capacity;
+
+    return chunk;
+}
+
+/** Moves to the next chunk, allocating it if needed. */
+static bool nextChunk (PtComplexArena arena) {
+    Chunk *current = arena->current;
+
+    if( current->next == NULL ) {
+        int capacity = current->capacity * 2;
+        if( capacity > MAX_CHUNK_NUMBERS ) capacity = MAX_CHUNK_NUMBERS;
+
+        current->next = chunkCreate(capacity);
+        if( current->next == NULL ) return false;
+    }
+
+    arena->current = current->next;
+    arena->used = 0;
+
+    return true;
+}
+
+PtComplexArena complexArenaCreate () {
+    PtComplexArena arena = (PtComplexArena) malloc( sizeof(ComplexArena) );
+
+    if( arena == NULL ) return NULL;
+
+    arena->first = chunkCreate(FIRST_CHUNK_NUMBERS);
+    if( arena->first == NULL ) {
+        free(arena);
+        return NULL;
+    }
+
+    arena->current = arena->first;
+    arena->used = 0;
+
+    return arena;
+}
+
+int complexArenaDestroy (PtComplexArena *ptArena) {
+    PtComplexArena arena = *ptArena;
+
+    if( arena == NULL ) return COMPLEX_NULL;
+
+    Chunk *chunk = arena->first;
+    while( chunk != NULL ) {
+        Chunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    free(arena);
+
+    *ptArena = NULL;
+
+    return COMPLEX_OK;
+}
+
+int complexArenaReset (PtComplexArena arena) {
+    if( arena == NULL ) return COMPLEX_NULL;
+
+    arena->current = arena->first;
+    arena->used = 0;
+
+    return COMPLEX_OK;
+}
+
+PtComplex complexArenaNewV (PtComplexArena arena, Complex value) {
+    if( arena == NULL ) return NULL;
+
+    if( arena->used == arena->current->capacity && !nextChunk(arena) ) return NULL;
+
+    PtComplex c = &arena->current->numbers[arena->used++];
+    (*c) = value;
+
+    return c;
+}
+
+PtComplex complexArenaNew (PtComplexArena arena, double re, double im) {
+    return complexArenaNewV( arena, complexV(re, im) );
+}
+
+PtComplex complexArenaAdd (PtComplexArena arena, PtComplex w, PtComplex z) {
+    if( w == NULL || z == NULL) return NULL;
+
+    return complexArenaNewV( arena, complexAddV(*w, *z) );
+}
+
+PtComplex complexArenaMultiply (PtComplexArena arena, PtComplex w, PtComplex z) {
+    if( w == NULL || z == NULL) return NULL;
+
+    return complexArenaNewV( arena, complexMultiplyV(*w, *z) );
+}
@@ -0,0 +1,116 @@
+/**
+ * @file complexArena.h
+ * @brief Defines the type PtComplexArena and associated operations.
+ *
+ * An arena allocates complex numbers by bumping a pointer in large
+ * chunks of memory, so that evaluating an expression does not call
+ * malloc for each temporary number. Numbers allocated from an arena
+ * must not be released with complexDestroy; they are all released at
+ * once by complexArenaReset, which keeps the chunks for reuse, or by
+ * complexArenaDestroy.
+ *
+ * Example:
+ *
+ *     PtComplexArena arena = complexArenaCreate();
+ *     for (int i = 0; i < n; i++) {
+ *         PtComplex y = complexArenaAdd(arena,
+ *                          complexArenaMultiply(arena, a, x[i]), b);
+ *         ...
+ *         complexArenaReset(arena);
+ *     }
+ *     complexArenaDestroy(&arena);
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#pragma once
+
+#include "complex.h"
+
+struct complexArena;
+typedef struct complexArena* PtComplexArena;
+
+/**
+ * @brief Create a new empty arena.
+ *
+ * @return PtComplexArena pointer to allocated arena.
+ * @return NULL if unsufficient memory for allocation
+ */
+PtComplexArena complexArenaCreate ();
+
+/**
+* @brief Release all resources of an arena, including all
+* the numbers allocated from it.
+*
+* @param ptArena [in] ADDRESS OF PtComplexArena pointer to the arena.
+*
+* @return COMPLEX_OK if the operation is successful and *ptArena = NULL
+* @return COMPLEX_NULL if '*ptArena' is NULL
+*/
+int complexArenaDestroy (PtComplexArena *ptArena);
+
+/**
+* @brief Release, in one call, all the numbers allocated from an arena.
+*
+* The arena remains usable.
+*
+* @param arena [in] PtComplexArena pointer to the arena.
+*
+* @return COMPLEX_OK if the operation is successful
+* @return COMPLEX_NULL if 'arena' is NULL
+*/
+int complexArenaReset (PtComplexArena arena);
+
+/**
+ * @brief Allocate a complex number from an arena.
+ *
+ * @param arena [in] PtComplexArena pointer to the arena.
+ * @param value [in] the number
+ *
+ * @return PtComplex pointer to allocated complex number.
+ * @return NULL if 'arena' is NULL
+ * @return NULL if unsufficient memory for allocation
+ */
+PtComplex complexArenaNewV (PtComplexArena arena, Complex value);
+
+/**
+ * @brief Allocate a complex number from an arena, from two `double`s.
+ *
+ * @param arena [in] PtComplexArena pointer to the arena.
+ * @param re [in] real component
+ * @param im  [in] imaginary component
+ *
+ * @return PtComplex pointer to allocated complex number.
+ * @return NULL if 'arena' is NULL
+ * @return NULL if unsufficient memory for allocation
+ */
+PtComplex complexArenaNew (PtComplexArena arena, double re, double im);
+
+/**
+ * @brief Add two complex numbers together, allocating the result
+ * from an arena.
+ *
+ * @param arena [in] PtComplexArena pointer to the arena.
+ * @param w [in] PtComplex pointer to the data structure of first number.
+ * @param z [in] PtComplex pointer to the data structure of second number.
+ *
+ * @return PtComplex pointer to new computed number
+ * @return NULL if 'arena', 'w' or 'z' are NULL
+ * @return NULL if unsufficient memory for allocation
+ */
+PtComplex complexArenaAdd (PtComplexArena arena, PtComplex w, PtComplex z);
+
+/**
+ * @brief Multiply two complex numbers together, allocating the result
+ * from an arena.
+ *
+ * @param arena [in] PtComplexArena pointer to the arena.
+ * @param w [in] PtComplex pointer to the data structure of first number.
+ * @param z [in] PtComplex pointer to the data structure of second number.
+ *
+ * @return PtComplex pointer to new computed number
+ * @return NULL if 'arena', 'w' or 'z' are NULL
+ * @return NULL if unsufficient memory for allocation
+ */
+PtComplex complexArenaMultiply (PtComplexArena arena, PtComplex w, PtComplex z);
@@ -0,0 +1,363 @@
+/**
+ * @file complexArray.c
+ * @brief Implements complexArray.h with a table of kernels for each
+ * instruction set, selected on first use.
+ *
+ * The SSE2 and AVX2 kernels process 2 and 4 elements per instruction,
+ * respectively, and the remaining elements with the scalar 'V'
+ * operations. They do not use fused multiply-add, so that products are
+ * rounded as in complexMultiplyV. The selection of the table is not
+ * synchronized; concurrent first calls select the same table.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "complexArray.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define COMPLEX_ARRAY_X86
+#include <immintrin.h>
+#endif
+
+typedef void (*BinaryFn)(const double*, const double*, const double*, const double*,
+                         double*, double*, int);
+typedef Complex (*DotFn)(const double*, const double*, const double*, const double*, int);
+typedef void (*ModFn)(const double*, const double*, double*, int);
+
+typedef struct kernels {
+    ComplexIsa isa;
+    BinaryFn add;
+    BinaryFn mul;
+    BinaryFn mulAdd;
+    DotFn dot;
+    ModFn mod;
+} Kernels;
+
+/* ---------------------------------------------------------------- scalar */
+
+static void addScalar (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                       double *outRe, double *outIm, int n) {
+    for(int k = 0; k < n; k++) {
+        Complex c = complexAddV( complexV(wRe[k], wIm[k]), complexV(zRe[k], zIm[k]) );
+        outRe[k] = c.real;
+        outIm[k] = c.imaginary;
+    }
+}
+
+static void mulScalar (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                       double *outRe, double *outIm, int n) {
+    for(int k = 0; k < n; k++) {
+        Complex c = complexMultiplyV( complexV(wRe[k], wIm[k]), complexV(zRe[k], zIm[k]) );
+        outRe[k] = c.real;
+        outIm[k] = c.imaginary;
+    }
+}
+
+static void mulAddScalar (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                          double *accRe, double *accIm, int n) {
+    for(int k = 0; k < n; k++) {
+        Complex product = complexMultiplyV( complexV(wRe[k], wIm[k]), complexV(zRe[k], zIm[k]) );
+        Complex c = complexAddV( complexV(accRe[k], accIm[k]), product );
+        accRe[k] = c.real;
+        accIm[k] = c.imaginary;
+    }
+}
+
+static Complex dotScalar (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                          int n) {
+    Complex sum = complexV(0, 0);
+    for(int k = 0; k < n; k++) {
+        sum = complexAddV( sum, complexMultiplyV( complexV(wRe[k], wIm[k]), complexV(zRe[k], zIm[k]) ) );
+    }
+    return sum;
+}
+
+static void modScalar (const double *re, const double *im, double *modulus, int n) {
+    for(int k = 0; k < n; k++) {
+        modulus[k] = complexModV( complexV(re[k], im[k]) );
+    }
+}
+
+static const Kernels scalarKernels = {
+    COMPLEX_ISA_SCALAR, addScalar, mulScalar, mulAddScalar, dotScalar, modScalar
+};
+
+#ifdef COMPLEX_ARRAY_X86
+
+/* ------------------------------------------------------------------ SSE2 */
+
+__attribute__((target("sse2")))
+static void addSse2 (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                     double *outRe, double *outIm, int n) {
+    int k = 0;
+    for(; k + 2 <= n; k += 2) {
+        __m128d re = _mm_add_pd( _mm_loadu_pd(wRe + k), _mm_loadu_pd(zRe + k) );
+        __m128d im = _mm_add_pd( _mm_loadu_pd(wIm + k), _mm_loadu_pd(zIm + k) );
+        _mm_storeu_pd(outRe + k, re);
+        _mm_storeu_pd(outIm + k, im);
+    }
+    addScalar(wRe + k, wIm + k, zRe + k, zIm + k, outRe + k, outIm + k, n - k);
+}
+
+__attribute__((target("sse2")))
+static void mulSse2 (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                     double *outRe, double *outIm, int n) {
+    int k = 0;
+    for(; k + 2 <= n; k += 2) {
+        __m128d a = _mm_loadu_pd(wRe + k), b = _mm_loadu_pd(wIm + k);
+        __m128d c = _mm_loadu_pd(zRe + k), d = _mm_loadu_pd(zIm + k);
+        __m128d re = _mm_sub_pd( _mm_mul_pd(a, c), _mm_mul_pd(b, d) );
+        __m128d im = _mm_add_pd( _mm_mul_pd(b, c), _mm_mul_pd(a, d) );
+        _mm_storeu_pd(outRe + k, re);
+        _mm_storeu_pd(outIm + k, im);
+    }
+    mulScalar(wRe + k, wIm + k, zRe + k, zIm + k, outRe + k, outIm + k, n - k);
+}
+
+__attribute__((target("sse2")))
+static void mulAddSse2 (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                        double *accRe, double *accIm, int n) {
+    int k = 0;
+    for(; k + 2 <= n; k += 2) {
+        __m128d a = _mm_loadu_pd(wRe + k), b = _mm_loadu_pd(wIm + k);
+        __m128d c = _mm_loadu_pd(zRe + k), d = _mm_loadu_pd(zIm + k);
+        __m128d re = _mm_sub_pd( _mm_mul_pd(a, c), _mm_mul_pd(b, d) );
+        __m128d im = _mm_add_pd( _mm_mul_pd(b, c), _mm_mul_pd(a, d) );
+        _mm_storeu_pd(accRe + k, _mm_add_pd( _mm_loadu_pd(accRe + k), re ));
+        _mm_storeu_pd(accIm + k, _mm_add_pd( _mm_loadu_pd(accIm + k), im ));
+    }
+    mulAddScalar(wRe + k, wIm + k, zRe + k, zIm + k, accRe + k, accIm + k, n - k);
+}
+
+__attribute__((target("sse2")))
+static Complex dotSse2 (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                        int n) {
+    __m128d sumRe = _mm_setzero_pd(), sumIm = _mm_setzero_pd();
+    int k = 0;
+    for(; k + 2 <= n; k += 2) {
+        __m128d a = _mm_loadu_pd(wRe + k), b = _mm_loadu_pd(wIm + k);
+        __m128d c = _mm_loadu_pd(zRe + k), d = _mm_loadu_pd(zIm + k);
+        sumRe = _mm_add_pd( sumRe, _mm_sub_pd( _mm_mul_pd(a, c), _mm_mul_pd(b, d) ) );
+        sumIm = _mm_add_pd( sumIm, _mm_add_pd( _mm_mul_pd(b, c), _mm_mul_pd(a, d) ) );
+    }
+
+    double re[2], im[2];
+    _mm_storeu_pd(re, sumRe);
+    _mm_storeu_pd(im, sumIm);
+
+    Complex sum = complexV(re[0] + re[1], im[0] + im[1]);
+    return complexAddV( sum, dotScalar(wRe + k, wIm + k, zRe + k, zIm + k, n - k) );
+}
+
+__attribute__((target("sse2")))
+static void modSse2 (const double *re, const double *im, double *modulus, int n) {
+    int k = 0;
+    for(; k + 2 <= n; k += 2) {
+        __m128d a = _mm_loadu_pd(re + k), b = _mm_loadu_pd(im + k);
+        __m128d squares = _mm_add_pd( _mm_mul_pd(a, a), _mm_mul_pd(b, b) );
+        _mm_storeu_pd(modulus + k, _mm_sqrt_pd(squares));
+    }
+    modScalar(re + k, im + k, modulus + k, n - k);
+}
+
+static const Kernels sse2Kernels = {
+    COMPLEX_ISA_SSE2, addSse2, mulSse2, mulAddSse2, dotSse2, modSse2
+};
+
+/* ------------------------------------------------------------------ AVX2 */
+
+__attribute__((target("avx2")))
+static void addAvx2 (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                     double *outRe, double *outIm, int n) {
+    int k = 0;
+    for(; k + 4 <= n; k += 4) {
+        __m256d re = _mm256_add_pd( _mm256_loadu_pd(wRe + k), _mm256_loadu_pd(zRe + k) );
+        __m256d im = _mm256_add_pd( _mm256_loadu_pd(wIm + k), _mm256_loadu_pd(zIm + k) );
+        _mm256_storeu_pd(outRe + k, re);
+        _mm256_storeu_pd(outIm + k, im);
+    }
+    addScalar(wRe + k, wIm + k, zRe + k, zIm + k, outRe + k, outIm + k, n - k);
+}
+
+__attribute__((target("avx2")))
+static void mulAvx2 (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                     double *outRe, double *outIm, int n) {
+    int k = 0;
+    for(; k + 4 <= n; k += 4) {
+        __m256d a = _mm256_loadu_pd(wRe + k), b = _mm256_loadu_pd(wIm + k);
+        __m256d c = _mm256_loadu_pd(zRe + k), d = _mm256_loadu_pd(zIm + k);
+        __m256d re = _mm256_sub_pd( _mm256_mul_pd(a, c), _mm256_mul_pd(b, d) );
+        __m256d im = _mm256_add_pd( _mm256_mul_pd(b, c), _mm256_mul_pd(a, d) );
+        _mm256_storeu_pd(outRe + k, re);
+        _mm256_storeu_pd(outIm + k, im);
+    }
+    mulScalar(wRe + k, wIm + k, zRe + k, zIm + k, outRe + k, outIm + k, n - k);
+}
+
+__attribute__((target("avx2")))
+static void mulAddAvx2 (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                        double *accRe, double *accIm, int n) {
+    int k = 0;
+    for(; k + 4 <= n; k += 4) {
+        __m256d a = _mm256_loadu_pd(wRe + k), b = _mm256_loadu_pd(wIm + k);
+        __m256d c = _mm256_loadu_pd(zRe + k), d = _mm256_loadu_pd(zIm + k);
+        __m256d re = _mm256_sub_pd( _mm256_mul_pd(a, c), _mm256_mul_pd(b, d) );
+        __m256d im = _mm256_add_pd( _mm256_mul_pd(b, c), _mm256_mul_pd(a, d) );
+        _mm256_storeu_pd(accRe + k, _mm256_add_pd( _mm256_loadu_pd(accRe + k), re ));
+        _mm256_storeu_pd(accIm + k, _mm256_add_pd( _mm256_loadu_pd(accIm + k), im ));
+    }
+    mulAddScalar(wRe + k, wIm + k, zRe + k, zIm + k, accRe + k, accIm + k, n - k);
+}
+
+__attribute__((target("avx2")))
+static Complex dotAvx2 (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                        int n) {
+    __m256d sumRe = _mm256_setzero_pd(), sumIm = _mm256_setzero_pd();
+    int k = 0;
+    for(; k + 4 <= n; k += 4) {
+        __m256d a = _mm256_loadu_pd(wRe + k), b = _mm256_loadu_pd(wIm + k);
+        __m256d c = _mm256_loadu_pd(zRe + k), d = _mm256_loadu_pd(zIm + k);
+        sumRe = _mm256_add_pd( sumRe, _mm256_sub_pd( _mm256_mul_pd(a, c), _mm256_mul_pd(b, d) ) );
+        sumIm = _mm256_add_pd( sumIm, _mm256_add_pd( _mm256_mul_pd(b, c), _mm256_mul_pd(a, d) ) );
+    }
+
+    double re[4], im[4];
+    _mm256_storeu_pd(re, sumRe);
+    _mm256_storeu_pd(im, sumIm);
+
+    Complex sum = complexV((re[0] + re[1]) + (re[2] + re[3]), (im[0] + im[1]) + (im[2] + im[3]));
+    return complexAddV( sum, dotScalar(wRe + k, wIm + k, zRe + k, zIm + k, n - k) );
+}
+
+__attribute__((target("avx2")))
+static void modAvx2 (const double *re, const double *im, double *modulus, int n) {
+    int k = 0;
+    for(; k + 4 <= n; k += 4) {
+        __m256d a = _mm256_loadu_pd(re + k), b = _mm256_loadu_pd(im + k);
+        __m256d squares = _mm256_add_pd( _mm256_mul_pd(a, a), _mm256_mul_pd(b, b) );
+        _mm256_storeu_pd(modulus + k, _mm256_sqrt_pd(squares));
+    }
+    modScalar(re + k, im + k, modulus + k, n - k);
+}
+
+static const Kernels avx2Kernels = {
+    COMPLEX_ISA_AVX2, addAvx2, mulAvx2, mulAddAvx2, dotAvx2, modAvx2
+};
+
+#endif /* COMPLEX_ARRAY_X86 */
+
+/* -------------------------------------------------------------- dispatch */
+
+static const Kernels *kernels = NULL;
+
+static bool isSupported (ComplexIsa isa) {
+    switch( isa ) {
+        case COMPLEX_ISA_SCALAR:
+            return true;
+#ifdef COMPLEX_ARRAY_X86
+        case COMPLEX_ISA_SSE2:
+            return __builtin_cpu_supports("sse2");
+        case COMPLEX_ISA_AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+static const Kernels* kernelsOf (ComplexIsa isa) {
+#ifdef COMPLEX_ARRAY_X86
+    if( isa == COMPLEX_ISA_AVX2 ) return &avx2Kernels;
+    if( isa == COMPLEX_ISA_SSE2 ) return &sse2Kernels;
+#endif
+    return &scalarKernels;
+}
+
+static const Kernels* selected () {
+    if( kernels == NULL ) {
+#ifdef COMPLEX_ARRAY_X86
+        __builtin_cpu_init();
+#endif
+        if( isSupported(COMPLEX_ISA_AVX2) ) kernels = kernelsOf(COMPLEX_ISA_AVX2);
+        else if( isSupported(COMPLEX_ISA_SSE2) ) kernels = kernelsOf(COMPLEX_ISA_SSE2);
+        else kernels = kernelsOf(COMPLEX_ISA_SCALAR);
+    }
+    return kernels;
+}
+
+ComplexIsa complexArrayIsa () {
+    return selected()->isa;
+}
+
+int complexArrayUseIsa (ComplexIsa isa) {
+    selected(); /* initializes the detection of features */
+
+    if( !isSupported(isa) ) return COMPLEX_UNSUPPORTED;
+
+    kernels = kernelsOf(isa);
+
+    return COMPLEX_OK;
+}
+
+int complexArrayAdd (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                     double *outRe, double *outIm, int n) {
+    if( wRe == NULL || wIm == NULL || zRe == NULL || zIm == NULL ||
+        outRe == NULL || outIm == NULL ) return COMPLEX_NULL;
+
+    selected()->add(wRe, wIm, zRe, zIm, outRe, outIm, n);
+
+    return COMPLEX_OK;
+}
+
+int complexArrayMul (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                     double *outRe, double *outIm, int n) {
+    if( wRe == NULL || wIm == NULL || zRe == NULL || zIm == NULL ||
+        outRe == NULL || outIm == NULL ) return COMPLEX_NULL;
+
+    selected()->mul(wRe, wIm, zRe, zIm, outRe, outIm, n);
+
+    return COMPLEX_OK;
+}
+
+int complexArrayMulAdd (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                        double *accRe, double *accIm, int n) {
+    if( wRe == NULL || wIm == NULL || zRe == NULL || zIm == NULL ||
+        accRe == NULL || accIm == NULL ) return COMPLEX_NULL;
+
+    selected()->mulAdd(wRe, wIm, zRe, zIm, accRe, accIm, n);
+
+    return COMPLEX_OK;
+}
+
+int complexArrayDot (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                     int n, Complex *result) {
+    if( wRe == NULL || wIm == NULL || zRe == NULL || zIm == NULL ||
+        result == NULL ) return COMPLEX_NULL;
+
+    (*result) = selected()->dot(wRe, wIm, zRe, zIm, n);
+
+    return COMPLEX_OK;
+}
+
+int complexArrayMod (const double *re, const double *im, double *modulus, int n) {
+    if( re == NULL || im == NULL || modulus == NULL ) return COMPLEX_NULL;
+
+    selected()->mod(re, im, modulus, n);
+
+    return COMPLEX_OK;
+}
+
+int complexArrayArg (const double *re, const double *im, double *argument, int n) {
+    if( re == NULL || im == NULL || argument == NULL ) return COMPLEX_NULL;
+
+    /* there is no vector atan2; a polynomial one would not match atan2 */
+    for(int k = 0; k < n; k++) {
+        argument[k] = complexArgV( complexV(re[k], im[k]) );
+    }
+
+    return COMPLEX_OK;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file complexArray.h
+ * @brief Defines element-wise operations over arrays of complex numbers.
+ *
+ * Arrays are given in structure-of-arrays form: the real parts of
+ * the n numbers in 're[0..n-1]' and the imaginary parts in 'im[0..n-1]'.
+ * Output arrays may be the same as input arrays (e.g., to add in place),
+ * but must not otherwise overlap them.
+ *
+ * Each operation has SSE2 and AVX2 implementations, selected at run
+ * time by the features of the processor, and a scalar one, used on
+ * other processors. complexArrayAdd, complexArrayMul, complexArrayMulAdd
+ * and complexArrayMod produce the same results, bit for bit, as the
+ * corresponding 'V' operations of complex.h on every path, provided
+ * that the compiler does not fuse multiplications and additions of the
+ * 'V' operations (GCC does so when targeting processors with FMA, e.g.,
+ * with -march=native, unless given -ffp-contract=off).
+ * complexArrayDot sums in a different order on each path, so its
+ * results may differ in the last bits. complexArrayArg is always scalar.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#pragma once
+
+#include "complex.h"
+
+#define COMPLEX_UNSUPPORTED 2
+
+/** Instruction sets of the implementations. */
+typedef enum complexIsa {
+    COMPLEX_ISA_SCALAR,
+    COMPLEX_ISA_SSE2,
+    COMPLEX_ISA_AVX2
+} ComplexIsa;
+
+/**
+ * @brief Retrieve the instruction set of the implementation in use.
+ *
+ * Unless chosen with complexArrayUseIsa, it is the best one
+ * supported by the processor.
+ *
+ * @return the instruction set
+ */
+ComplexIsa complexArrayIsa ();
+
+/**
+* @brief Choose the implementation in use, e.g., to compare them.
+*
+* @param isa [in] instruction set of the implementation
+*
+* @return COMPLEX_OK if successful
+* @return COMPLEX_UNSUPPORTED if the processor does not support 'isa'
+*/
+int complexArrayUseIsa (ComplexIsa isa);
+
+/**
+* @brief Add two arrays of complex numbers, element-wise:
+* out[k] = w[k] + z[k].
+*
+* @param wRe [in] real parts of the first array
+* @param wIm [in] imaginary parts of the first array
+* @param zRe [in] real parts of the second array
+* @param zIm [in] imaginary parts of the second array
+* @param outRe [out] real parts of the results
+* @param outIm [out] imaginary parts of the results
+* @param n [in] number of elements
+*
+* @return COMPLEX_OK if successful
+* @return COMPLEX_NULL if any array is NULL
+*/
+int complexArrayAdd (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                     double *outRe, double *outIm, int n);
+
+/**
+* @brief Multiply two arrays of complex numbers, element-wise:
+* out[k] = w[k] * z[k].
+*
+* @param wRe [in] real parts of the first array
+* @param wIm [in] imaginary parts of the first array
+* @param zRe [in] real parts of the second array
+* @param zIm [in] imaginary parts of the second array
+* @param outRe [out] real parts of the results
+* @param outIm [out] imaginary parts of the results
+* @param n [in] number of elements
+*
+* @return COMPLEX_OK if successful
+* @return COMPLEX_NULL if any array is NULL
+*/
+int complexArrayMul (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                     double *outRe, double *outIm, int n);
+
+/**
+* @brief Multiply two arrays of complex numbers and accumulate,
+* element-wise: acc[k] = acc[k] + w[k] * z[k].
+*
+* @param wRe [in] real parts of the first array
+* @param wIm [in] imaginary parts of the first array
+* @param zRe [in] real parts of the second array
+* @param zIm [in] imaginary parts of the second array
+* @param accRe [in,out] real parts of the accumulators
+* @param accIm [in,out] imaginary parts of the accumulators
+* @param n [in] number of elements
+*
+* @return COMPLEX_OK if successful
+* @return COMPLEX_NULL if any array is NULL
+*/
+int complexArrayMulAdd (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                        double *accRe, double *accIm, int n);
+
+/**
+* @brief Compute the dot product of two arrays of complex numbers,
+* without conjugation: the sum of w[k] * z[k].
+*
+* @param wRe [in] real parts of the first array
+* @param wIm [in] imaginary parts of the first array
+* @param zRe [in] real parts of the second array
+* @param zIm [in] imaginary parts of the second array
+* @param n [in] number of elements
+* @param result [out] Address of variable to hold the sum
+*
+* @return COMPLEX_OK and the sum assigned to '*result'
+* @return COMPLEX_NULL if any array or 'result' is NULL
+*/
+int complexArrayDot (const double *wRe, const double *wIm, const double *zRe, const double *zIm,
+                     int n, Complex *result);
+
+/**
+* @brief Take the magnitude of each element of an array of complex numbers.
+*
+* @param re [in] real parts of the array
+* @param im [in] imaginary parts of the array
+* @param modulus [out] magnitudes
+* @param n [in] number of elements
+*
+* @return COMPLEX_OK if successful
+* @return COMPLEX_NULL if any array is NULL
+*/
+int complexArrayMod (const double *re, const double *im, double *modulus, int n);
+
+/**
+* @brief Take the argument of each element of an array of complex numbers.
+*
+* @param re [in] real parts of the array
+* @param im [in] imaginary parts of the array
+* @param argument [out] arguments, in [-pi, pi]
+* @param n [in] number of elements
+*
+* @return COMPLEX_OK if successful
+* @return COMPLEX_NULL if any array is NULL
+*/
+int complexArrayArg (const double *re, const double *im, double *argument, int n);
@@ -0,0 +1,186 @@
+/**
+ * @file complexArrayMain.c
+ * @brief Verifies the implementations of complexArray.h against the
+ * scalar operations of complex.h, and times them against element-wise
+ * PtComplex operations.
+ *
+ * Usage: prog [n]
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "complex.h"
+#include "complexArray.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+
+#define DEFAULT_N 1000003	/* not a multiple of the vector widths */
+#define REPETITIONS 20
+
+static const char *isaNames[] = { "scalar", "sse2", "avx2" };
+
+static double seconds() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static double randomDouble() {
+	return (rand() / (double)RAND_MAX - 0.5) * 200.0;
+}
+
+static bool sameBits(const double *a, const double *b, int n) {
+	return memcmp(a, b, n * sizeof(double)) == 0;
+}
+
+/** Error of 'value', relative to 'scale', the sum of the magnitudes of the terms summed. */
+static double relativeError(double value, double expected, double scale) {
+	return fabs(value - expected) / (scale > 0 ? scale : 1);
+}
+
+int main(int argc, char **argv) {
+	int n = (argc > 1) ? atoi(argv[1]) : DEFAULT_N;
+	if( n < 1 ) {
+		printf("Usage: %s [n]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	double *wRe = malloc(n * sizeof(double)), *wIm = malloc(n * sizeof(double));
+	double *zRe = malloc(n * sizeof(double)), *zIm = malloc(n * sizeof(double));
+	double *outRe = malloc(n * sizeof(double)), *outIm = malloc(n * sizeof(double));
+	double *expRe = malloc(n * sizeof(double)), *expIm = malloc(n * sizeof(double));
+	double *out = malloc(n * sizeof(double)), *expected = malloc(n * sizeof(double));
+
+	if( !wRe || !wIm || !zRe || !zIm || !outRe || !outIm || !expRe || !expIm || !out || !expected ) {
+		printf("Could not allocate arrays.\n");
+		return EXIT_FAILURE;
+	}
+
+	srand(42);
+	for(int k = 0; k < n; k++) {
+		wRe[k] = randomDouble(); wIm[k] = randomDouble();
+		zRe[k] = randomDouble(); zIm[k] = randomDouble();
+	}
+
+	printf("Selected implementation: %s\n\n", isaNames[complexArrayIsa()]);
+
+	bool allPassed = true;
+
+	for(int isa = COMPLEX_ISA_SCALAR; isa <= COMPLEX_ISA_AVX2; isa++) {
+		if( complexArrayUseIsa(isa) != COMPLEX_OK ) {
+			printf("%-6s: not supported by this processor\n", isaNames[isa]);
+			continue;
+		}
+
+		bool passed = true;
+
+		/* element-wise operations must match the 'V' operations bit for bit */
+		for(int k = 0; k < n; k++) {
+			Complex c = complexAddV(complexV(wRe[k], wIm[k]), complexV(zRe[k], zIm[k]));
+			expRe[k] = c.real; expIm[k] = c.imaginary;
+		}
+		complexArrayAdd(wRe, wIm, zRe, zIm, outRe, outIm, n);
+		passed &= sameBits(outRe, expRe, n) && sameBits(outIm, expIm, n);
+
+		for(int k = 0; k < n; k++) {
+			Complex c = complexMultiplyV(complexV(wRe[k], wIm[k]), complexV(zRe[k], zIm[k]));
+			expRe[k] = c.real; expIm[k] = c.imaginary;
+		}
+		complexArrayMul(wRe, wIm, zRe, zIm, outRe, outIm, n);
+		passed &= sameBits(outRe, expRe, n) && sameBits(outIm, expIm, n);
+
+		/* accumulate twice over the products, starting at w */
+		memcpy(outRe, wRe, n * sizeof(double));
+		memcpy(outIm, wIm, n * sizeof(double));
+		for(int k = 0; k < n; k++) {
+			Complex product = complexMultiplyV(complexV(wRe[k], wIm[k]), complexV(zRe[k], zIm[k]));
+			Complex c = complexAddV(complexAddV(complexV(wRe[k], wIm[k]), product), product);
+			expRe[k] = c.real; expIm[k] = c.imaginary;
+		}
+		complexArrayMulAdd(wRe, wIm, zRe, zIm, outRe, outIm, n);
+		complexArrayMulAdd(wRe, wIm, zRe, zIm, outRe, outIm, n);
+		passed &= sameBits(outRe, expRe, n) && sameBits(outIm, expIm, n);
+
+		for(int k = 0; k < n; k++) expected[k] = complexModV(complexV(wRe[k], wIm[k]));
+		complexArrayMod(wRe, wIm, out, n);
+		passed &= sameBits(out, expected, n);
+
+		for(int k = 0; k < n; k++) expected[k] = complexArgV(complexV(wRe[k], wIm[k]));
+		complexArrayArg(wRe, wIm, out, n);
+		passed &= sameBits(out, expected, n);
+
+		/* the dot product sums in another order: compare within n ulps of the magnitude of the terms */
+		Complex dot, expectedDot = complexV(0, 0);
+		double scale = 0;
+		for(int k = 0; k < n; k++) {
+			Complex product = complexMultiplyV(complexV(wRe[k], wIm[k]), complexV(zRe[k], zIm[k]));
+			expectedDot = complexAddV(expectedDot, product);
+			scale += complexModV(product);
+		}
+		complexArrayDot(wRe, wIm, zRe, zIm, n, &dot);
+		double error = fmax(relativeError(dot.real, expectedDot.real, scale),
+							relativeError(dot.imaginary, expectedDot.imaginary, scale));
+		passed &= (error <= n * 2.220446049250313e-16);
+
+		printf("%-6s: %s (dot product relative error %.2e)\n", isaNames[isa],
+				passed ? "matches the scalar operations" : "MISMATCH", error);
+		allPassed &= passed;
+	}
+
+	/* timing: multiply-accumulate over all elements */
+	printf("\nTime of acc[k] += w[k] * z[k], %d elements (ns per element):\n", n);
+
+	double start = seconds();
+	PtComplex *acc = malloc(n * sizeof(PtComplex));
+	if( acc == NULL ) {
+		printf("Could not allocate arrays.\n");
+		return EXIT_FAILURE;
+	}
+	for(int k = 0; k < n; k++) acc[k] = complexCreate(0, 0);
+	for(int r = 0; r < REPETITIONS; r++) {
+		for(int k = 0; k < n; k++) {
+			PtComplex w = complexCreate(wRe[k], wIm[k]);
+			PtComplex z = complexCreate(zRe[k], zIm[k]);
+			PtComplex product = complexMultiply(w, z);
+			PtComplex sum = complexAdd(acc[k], product);
+
+			complexDestroy(&acc[k]);
+			acc[k] = sum;
+
+			complexDestroy(&w);
+			complexDestroy(&z);
+			complexDestroy(&product);
+		}
+	}
+	double elapsed = seconds() - start;
+	printf("%-8s: %7.2f\n", "PtComplex", elapsed * 1e9 / ((double)n * REPETITIONS));
+
+	for(int k = 0; k < n; k++) complexDestroy(&acc[k]);
+	free(acc);
+
+	for(int isa = COMPLEX_ISA_SCALAR; isa <= COMPLEX_ISA_AVX2; isa++) {
+		if( complexArrayUseIsa(isa) != COMPLEX_OK ) continue;
+
+		memset(outRe, 0, n * sizeof(double));
+		memset(outIm, 0, n * sizeof(double));
+
+		start = seconds();
+		for(int r = 0; r < REPETITIONS; r++) {
+			complexArrayMulAdd(wRe, wIm, zRe, zIm, outRe, outIm, n);
+		}
+		elapsed = seconds() - start;
+		printf("%-8s: %7.2f\n", isaNames[isa], elapsed * 1e9 / ((double)n * REPETITIONS));
+	}
+
+	free(wRe); free(wIm); free(zRe); free(zIm);
+	free(outRe); free(outIm); free(expRe); free(expIm);
+	free(out); free(expected);
+
+	return allPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,229 @@
+/**
+ * @file fft.c
+ * @brief Implements fft.h with a mixed-radix, decimation-in-time
+ * Cooley-Tukey transform.
+ *
+ * For n = p * m, the transform of x is computed from the transforms of
+ * size m of the p subsequences x[j], x[j + p], x[j + 2p], ..., which are
+ * combined by a butterfly of radix p. The recursion reads the input
+ * with growing strides and writes the output in order to the work
+ * buffer of the plan, which is then copied back. Radices 4 and 2 have
+ * their own butterflies; other radices use a generic one. The inverse
+ * transform conjugates its input and output around the forward one.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "fft.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/** Enough for any int: each factor is at least 2. */
+#define MAX_FACTORS 32
+
+typedef struct fftPlan {
+    int n;
+    int numFactors;
+    int radix[MAX_FACTORS];         /* radix of each stage, outermost first */
+    int remaining[MAX_FACTORS];     /* size of the sub-transforms of each stage */
+    int maxRadix;
+    Complex *twiddles;              /* exp(-2*pi*i*k/n), k in [0, n - 1] */
+    Complex *work;                  /* n numbers, the output before it is copied back */
+    Complex *scratch;               /* maxRadix numbers, used by the generic butterfly */
+} FftPlan;
+
+/** Factors 'n' into radices 4 first, then 2, 3, 5, 7, ... */
+static void factor (PtFftPlan plan) {
+    int n = plan->n;
+    int p = 4;
+
+    plan->numFactors = 0;
+    plan->maxRadix = 1;
+
+    while( n > 1 ) {
+        while( n % p != 0 ) {
+            if( p == 4 ) p = 2;
+            else if( p == 2 ) p = 3;
+            else p += 2;
+
+            if( (long)p * p > n ) p = n; /* 'n' is prime */
+        }
+
+        n /= p;
+        plan->radix[plan->numFactors] = p;
+        plan->remaining[plan->numFactors] = n;
+        plan->numFactors++;
+
+        if( p > plan->maxRadix ) plan->maxRadix = p;
+    }
+}
+
+static inline Complex conjugate (Complex c) {
+    return complexV(c.real, -c.imaginary);
+}
+
+static void butterfly2 (PtFftPlan plan, Complex *out, int stride, int m) {
+    const Complex *twiddle = plan->twiddles;
+
+    for(int k = 0; k < m; k++) {
+        Complex t = complexMultiplyV(out[k + m], twiddle[k * stride]);
+
+        out[k + m] = complexV(out[k].real - t.real, out[k].imaginary - t.imaginary);
+        out[k] = complexAddV(out[k], t);
+    }
+}
+
+static void butterfly4 (PtFftPlan plan, Complex *out, int stride, int m) {
+    const Complex *twiddle = plan->twiddles;
+
+    for(int k = 0; k < m; k++) {
+        Complex a0 = out[k];
+        Complex a1 = complexMultiplyV(out[k + m], twiddle[k * stride]);
+        Complex a2 = complexMultiplyV(out[k + 2 * m], twiddle[2 * k * stride]);
+        Complex a3 = complexMultiplyV(out[k + 3 * m], twiddle[3 * k * stride]);
+
+        Complex s02 = complexAddV(a0, a2);
+        Complex d02 = complexV(a0.real - a2.real, a0.imaginary - a2.imaginary);
+        Complex s13 = complexAddV(a1, a3);
+        Complex d13 = complexV(a1.real - a3.real, a1.imaginary - a3.imaginary);
+
+        /* multiplying d13 by -i */
+        out[k] = complexAddV(s02, s13);
+        out[k + m] = complexV(d02.real + d13.imaginary, d02.imaginary - d13.real);
+        out[k + 2 * m] = complexV(s02.real - s13.real, s02.imaginary - s13.imaginary);
+        out[k + 3 * m] = complexV(d02.real - d13.imaginary, d02.imaginary + d13.real);
+    }
+}
+
+static void butterflyGeneric (PtFftPlan plan, Complex *out, int stride, int m, int p) {
+    const Complex *twiddle = plan->twiddles;
+    Complex *scratch = plan->scratch;
+    int n = plan->n;
+
+    for(int k = 0; k < m; k++) {
+        for(int q = 0; q < p; q++) {
+            scratch[q] = out[k + q * m];
+        }
+
+        for(int q = 0; q < p; q++) {
+            int index = k + q * m;              /* output X[index] */
+            int step = (stride * index) % n;    /* exponent of the twiddle of each term */
+            int exponent = 0;
+
+            Complex sum = scratch[0];
+            for(int r = 1; r < p; r++) {
+                exponent += step;
+                if( exponent >= n ) exponent -= n;
+
+                sum = complexAddV(sum, complexMultiplyV(scratch[r], twiddle[exponent]));
+            }
+
+            out[index] = sum;
+        }
+    }
+}
+
+/**
+ * Writes to 'out' the transform of the n / stride elements of 'in'
+ * at multiples of 'stride', using stages [stage, numFactors).
+ */
+static void transform (PtFftPlan plan, Complex *out, const Complex *in, int stride, int stage) {
+    int p = plan->radix[stage];
+    int m = plan->remaining[stage];
+
+    if( m == 1 ) {
+        for(int q = 0; q < p; q++) {
+            out[q] = in[q * stride];
+        }
+    }
+    else {
+        for(int q = 0; q < p; q++) {
+            transform(plan, out + q * m, in + q * stride, stride * p, stage + 1);
+        }
+    }
+
+    switch( p ) {
+        case 2: butterfly2(plan, out, stride, m); break;
+        case 4: butterfly4(plan, out, stride, m); break;
+        default: butterflyGeneric(plan, out, stride, m, p); break;
+    }
+}
+
+PtFftPlan fftPlanCreate (int n) {
+    if( n < 1 ) return NULL;
+
+    PtFftPlan plan = (PtFftPlan) malloc( sizeof(FftPlan) );
+    if( plan == NULL ) return NULL;
+
+    plan->n = n;
+    factor(plan);
+
+    plan->twiddles = (Complex*) malloc( n * sizeof(Complex) );
+    plan->work = (Complex*) malloc( n * sizeof(Complex) );
+    plan->scratch = (Complex*) malloc( plan->maxRadix * sizeof(Complex) );
+
+    if( plan->twiddles == NULL || plan->work == NULL || plan->scratch == NULL ) {
+        fftPlanDestroy(&plan);
+        return NULL;
+    }
+
+    for(int k = 0; k < n; k++) {
+        double angle = -2.0 * M_PI * k / n;
+        plan->twiddles[k] = complexV( cos(angle), sin(angle) );
+    }
+
+    return plan;
+}
+
+int fftPlanDestroy (PtFftPlan *ptPlan) {
+    PtFftPlan plan = *ptPlan;
+
+    if( plan == NULL ) return COMPLEX_NULL;
+
+    free(plan->twiddles);
+    free(plan->work);
+    free(plan->scratch);
+    free(plan);
+
+    *ptPlan = NULL;
+
+    return COMPLEX_OK;
+}
+
+int fftPlanSize (PtFftPlan plan, int *ptN) {
+    if( plan == NULL ) return COMPLEX_NULL;
+
+    (*ptN) = plan->n;
+
+    return COMPLEX_OK;
+}
+
+int fftForward (PtFftPlan plan, Complex *data) {
+    if( plan == NULL || data == NULL ) return COMPLEX_NULL;
+
+    if( plan->numFactors == 0 ) return COMPLEX_OK; /* n == 1 */
+
+    transform(plan, plan->work, data, 1, 0);
+    memcpy(data, plan->work, plan->n * sizeof(Complex));
+
+    return COMPLEX_OK;
+}
+
+int fftInverse (PtFftPlan plan, Complex *data) {
+    if( plan == NULL || data == NULL ) return COMPLEX_NULL;
+
+    int n = plan->n;
+
+    for(int k = 0; k < n; k++) data[k] = conjugate(data[k]);
+
+    fftForward(plan, data);
+
+    for(int k = 0; k < n; k++) {
+        data[k] = complexV(data[k].real / n, -data[k].imaginary / n);
+    }
+
+    return COMPLEX_OK;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file fft.h
+ * @brief Defines the type PtFftPlan and the fast Fourier transform
+ * of arrays of complex numbers.
+ *
+ * A plan holds the factorization of a size n and the twiddle factors
+ * exp(-2*pi*i*k/n), computed once by fftPlanCreate and reused by every
+ * transform of that size. Any n >= 1 is supported: n is factored into
+ * radices 4, 2, 3, 5, ... and each stage runs in O(n * radix), so the
+ * transform takes O(n log n) time when n has small prime factors (and
+ * O(n * p) when it has a large prime factor p).
+ *
+ * The forward transform computes X[k] = sum of x[j] * exp(-2*pi*i*j*k/n);
+ * the inverse one divides by n, so fftInverse(fftForward(x)) = x.
+ * Transforms are in place, over contiguous arrays of Complex; a plan
+ * owns a work buffer, so it must not run two transforms concurrently.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#pragma once
+
+#include "complex.h"
+
+struct fftPlan;
+typedef struct fftPlan* PtFftPlan;
+
+/**
+ * @brief Create a plan for transforms of a given size.
+ *
+ * @param n [in] number of elements of the transforms
+ *
+ * @return PtFftPlan pointer to allocated plan.
+ * @return NULL if 'n' < 1
+ * @return NULL if unsufficient memory for allocation
+ */
+PtFftPlan fftPlanCreate (int n);
+
+/**
+* @brief Release all resources of a plan.
+*
+* @param ptPlan [in] ADDRESS OF PtFftPlan pointer to the plan.
+*
+* @return COMPLEX_OK if the operation is successful and *ptPlan = NULL
+* @return COMPLEX_NULL if '*ptPlan' is NULL
+*/
+int fftPlanDestroy (PtFftPlan *ptPlan);
+
+/**
+* @brief Retrieve the size of the transforms of a plan.
+*
+* @param plan [in] PtFftPlan pointer to the plan.
+* @param ptN [out] Address of variable to hold the size
+*
+* @return COMPLEX_OK and size assigned to '*ptN'
+* @return COMPLEX_NULL if 'plan' is NULL
+*/
+int fftPlanSize (PtFftPlan plan, int *ptN);
+
+/**
+* @brief Compute the forward transform of an array, in place.
+*
+* @param plan [in] PtFftPlan pointer to a plan of the size of 'data'.
+* @param data [in,out] array of n complex numbers
+*
+* @return COMPLEX_OK if successful
+* @return COMPLEX_NULL if 'plan' or 'data' are NULL
+*/
+int fftForward (PtFftPlan plan, Complex *data);
+
+/**
+* @brief Compute the inverse transform of an array, in place,
+* including the division by n.
+*
+* @param plan [in] PtFftPlan pointer to a plan of the size of 'data'.
+* @param data [in,out] array of n complex numbers
+*
+* @return COMPLEX_OK if successful
+* @return COMPLEX_NULL if 'plan' or 'data' are NULL
+*/
+int fftInverse (PtFftPlan plan, Complex *data);
@@ -0,0 +1,206 @@
+/**
+ * @file fftMain.c
+ * @brief Verifies the FFT of fft.h against a naive DFT composed of
+ * PtComplex operations, and compares their times.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "complex.h"
+#include "fft.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+
+/** Largest size of the naive DFT in the timings, as it takes O(n^2). */
+#define MAX_NAIVE_N 4096
+
+/** Minimum time measured for each size, in seconds. */
+#define MIN_SECONDS 0.2
+
+static double seconds() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * Computes the DFT of 'x' into 'X', as done by hand before fft.h:
+ * one complexMultiply and one complexAdd, each allocating, per term.
+ * Returns false if unsufficient memory for allocation.
+ */
+static bool naiveDft(PtComplex *x, PtComplex *X, int n) {
+	for(int k = 0; k < n; k++) {
+		PtComplex sum = complexCreate(0, 0);
+		if( sum == NULL ) return false;
+
+		for(int j = 0; j < n; j++) {
+			double angle = -2.0 * M_PI * ((long)j * k % n) / n;
+			PtComplex w = complexCreate(cos(angle), sin(angle));
+			PtComplex term = complexMultiply(x[j], w);
+			PtComplex newSum = complexAdd(sum, term);
+
+			complexDestroy(&w);
+			complexDestroy(&term);
+			complexDestroy(&sum);
+
+			if( newSum == NULL ) return false;
+			sum = newSum;
+		}
+
+		X[k] = sum;
+	}
+
+	return true;
+}
+
+static double randomDouble() {
+	return rand() / (double)RAND_MAX - 0.5;
+}
+
+/** Largest difference between 'a' and 'b', relative to the largest magnitude of 'b'. */
+static double maxError(const Complex *a, const Complex *b, int n) {
+	double error = 0, scale = 0;
+	for(int k = 0; k < n; k++) {
+		Complex d = complexV(a[k].real - b[k].real, a[k].imaginary - b[k].imaginary);
+		error = fmax(error, complexModV(d));
+		scale = fmax(scale, complexModV(b[k]));
+	}
+	return error / (scale > 0 ? scale : 1);
+}
+
+/** Verifies fftForward against naiveDft and fftInverse against the input. */
+static bool verify(int n) {
+	Complex *data = malloc(n * sizeof(Complex));
+	Complex *input = malloc(n * sizeof(Complex));
+	Complex *expected = malloc(n * sizeof(Complex));
+	PtComplex *x = malloc(n * sizeof(PtComplex));
+	PtComplex *X = malloc(n * sizeof(PtComplex));
+	PtFftPlan plan = fftPlanCreate(n);
+
+	if( !data || !input || !expected || !x || !X || !plan ) {
+		printf("Could not allocate memory.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for(int k = 0; k < n; k++) {
+		input[k] = data[k] = complexV(randomDouble(), randomDouble());
+		x[k] = complexCreateV(input[k]);
+	}
+
+	if( !naiveDft(x, X, n) ) {
+		printf("Could not allocate memory.\n");
+		exit(EXIT_FAILURE);
+	}
+	for(int k = 0; k < n; k++) {
+		complexValue(X[k], &expected[k]);
+		complexDestroy(&x[k]);
+		complexDestroy(&X[k]);
+	}
+
+	fftForward(plan, data);
+	double forwardError = maxError(data, expected, n);
+
+	fftInverse(plan, data);
+	double inverseError = maxError(data, input, n);
+
+	/* both the naive DFT and the FFT round, so allow some growth with n */
+	bool passed = forwardError < 1e-12 * (1 + log2(n)) * sqrt(n) && inverseError < 1e-13 * (1 + log2(n));
+
+	printf("n = %5d: forward error %.2e, inverse error %.2e %s\n",
+			n, forwardError, inverseError, passed ? "" : "FAILED");
+
+	fftPlanDestroy(&plan);
+	free(data); free(input); free(expected); free(x); free(X);
+
+	return passed;
+}
+
+/** Times the naive DFT (if 'n' is small enough) and the FFT of size 'n'. */
+static void timeSize(int n) {
+	Complex *data = malloc(n * sizeof(Complex));
+	PtFftPlan plan = fftPlanCreate(n);
+
+	if( !data || !plan ) {
+		printf("Could not allocate memory.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for(int k = 0; k < n; k++) data[k] = complexV(randomDouble(), randomDouble());
+
+	double naiveSeconds = -1;
+	if( n <= MAX_NAIVE_N ) {
+		PtComplex *x = malloc(n * sizeof(PtComplex));
+		PtComplex *X = malloc(n * sizeof(PtComplex));
+		if( !x || !X ) {
+			printf("Could not allocate memory.\n");
+			exit(EXIT_FAILURE);
+		}
+		for(int k = 0; k < n; k++) x[k] = complexCreateV(data[k]);
+
+		double start = seconds();
+		if( !naiveDft(x, X, n) ) {
+			printf("Could not allocate memory.\n");
+			exit(EXIT_FAILURE);
+		}
+		naiveSeconds = seconds() - start;
+
+		for(int k = 0; k < n; k++) {
+			complexDestroy(&x[k]);
+			complexDestroy(&X[k]);
+		}
+		free(x);
+		free(X);
+	}
+
+	/* repeat forward and inverse transforms, reusing the plan */
+	long runs = 0;
+	double start = seconds(), elapsed;
+	do {
+		fftForward(plan, data);
+		fftInverse(plan, data);
+		runs += 2;
+		elapsed = seconds() - start;
+	} while( elapsed < MIN_SECONDS );
+
+	double fftSeconds = elapsed / runs;
+
+	if( naiveSeconds >= 0 ) {
+		printf("%8d %14.3f %14.3f %10.0fx\n", n, naiveSeconds * 1e3, fftSeconds * 1e3,
+				naiveSeconds / fftSeconds);
+	}
+	else {
+		printf("%8d %14s %14.3f %11s\n", n, "-", fftSeconds * 1e3, "-");
+	}
+
+	fftPlanDestroy(&plan);
+	free(data);
+}
+
+int main() {
+	srand(7);
+
+	/* powers of two, products of small primes and primes */
+	int verifySizes[] = { 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 30, 64, 97, 100, 128, 210, 256, 360, 1000, 1024, 1031 };
+	int timeSizes[] = { 64, 256, 1000, 1024, 4096, 65536, 1000000, 1048576 };
+
+	printf("Verification against the naive DFT:\n");
+
+	bool allPassed = true;
+	for(size_t i = 0; i < sizeof(verifySizes) / sizeof(verifySizes[0]); i++) {
+		allPassed &= verify(verifySizes[i]);
+	}
+
+	printf("\nTime of one transform (ms):\n");
+	printf("%8s %14s %14s %11s\n", "n", "naive DFT", "FFT", "speedup");
+
+	for(size_t i = 0; i < sizeof(timeSizes) / sizeof(timeSizes[0]); i++) {
+		timeSize(timeSizes[i]);
+	}
+
+	return allPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
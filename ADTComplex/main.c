@@ -1,12 +1,13 @@
 /**
  * @file main.c
- * @brief Provides an example program for the PtComplex type.
+ * @brief Provides an example program for the Complex and PtComplex types.
  * 
  * @author Bruno Silva (brunomnsilva@gmail.com)
  * @bug No known bugs.
  */
 
 #include "complex.h"
+#include "complexArena.h"
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -35,6 +36,35 @@ int main() {
 	complexMod(c, &modulus);
 	printf("|c| = %.2f\n", modulus); 
 
+	double argument;
+	complexArg(c, &argument);
+	printf("arg(c) = %.4f rad\n", argument);
+
+	/* the same computation by value, without allocations */
+	Complex av = complexV(1, 4);
+	Complex bv = complexV(3, 2);
+	Complex cv = complexMultiplyV(av, bv);
+	printf("c = a * b = %.3f + %.3fi (by value), |c| = %.2f\n",
+		cv.real, cv.imaginary, complexModV(cv));
+
+	/* evaluate a*x + b for several x; temporaries come from the arena */
+	PtComplexArena arena = complexArenaCreate();
+	if( arena == NULL ) {
+		printf("Could not create arena.\n");
+		return EXIT_FAILURE;
+	}
+
+	for(int i = 0; i < 3; i++) {
+		PtComplex x = complexArenaNew(arena, i, -i);
+		PtComplex y = complexArenaAdd(arena, complexArenaMultiply(arena, a, x), b);
+
+		printf("a * (%d - %di) + b = ", i, i); complexPrint(y);
+
+		complexArenaReset(arena); /* releases x, y and a*x at once */
+	}
+
+	complexArenaDestroy(&arena);
+
 	complexDestroy(&a);
 	complexDestroy(&b);
 	complexDestroy(&c);
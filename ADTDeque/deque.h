@@ -0,0 +1,160 @@
+/**
+ * @file deque.h
+ * @brief Definition of the ADT Deque in C, a work-stealing deque.
+ *
+ * Defines the type PtDeque and associated operations.
+ *
+ * A deque has one owner thread, which pushes and pops elements at
+ * its bottom end, in LIFO order (as stackPush and stackPop), and any
+ * number of thief threads, which steal elements from its top end, in
+ * FIFO order (as queueDequeue). In a scheduler, each worker owns a
+ * deque of tasks: it runs the tasks it spawned most recently, whose
+ * data is still in its cache, while idle workers steal the oldest
+ * tasks, which are usually the largest.
+ *
+ * dequePush, dequePop and dequeStats may only be called by the owner;
+ * dequeSteal, dequeSize and dequeIsEmpty by any thread. dequeDestroy
+ * and dequePrint must not run concurrently with any other operation
+ * on the same deque.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#pragma once
+
+#define DEQUE_OK            0
+#define DEQUE_NULL          1
+#define DEQUE_NO_MEMORY     2
+#define DEQUE_EMPTY         3
+#define DEQUE_RETRY         4
+
+#include <stdbool.h>
+#include "dequeElem.h"
+#include "adtStats.h"
+
+/** Forward declaration of the data structure. */
+struct dequeImpl;
+
+/** Definition of pointer to the  data stucture. */
+typedef struct dequeImpl *PtDeque;
+
+/**
+ * @brief Creates a new empty deque.
+ *
+ * @return PtDeque pointer to allocated data structure, or
+ * @return NULL if unsufficient memory for allocation
+ */
+PtDeque dequeCreate();
+
+/**
+ * @brief Creates a new empty deque with room for a number of elements.
+ *
+ * Pushing up to 'capacity' elements onto the deque does not
+ * allocate memory.
+ *
+ * @param capacity [in] number of elements to make room for,
+ * rounded up to a power of two
+ *
+ * @return PtDeque pointer to allocated data structure, or
+ * @return NULL if 'capacity' < 1 or unsufficient memory for allocation
+ */
+PtDeque dequeCreateWithCapacity(int capacity);
+
+/**
+ * @brief Free all resources of a deque.
+ *
+ * @param ptDeque [in] ADDRESS OF pointer to the deque
+ *
+ * @return DEQUE_OK if success and *ptDeque modified to NULL, or
+ * @return DEQUE_NULL if '*ptDeque' is NULL
+ */
+int dequeDestroy(PtDeque *ptDeque);
+
+/**
+ * @brief Push an element onto the bottom of a deque (owner only).
+ *
+ * The deque grows as needed.
+ *
+ * @param deque [in] pointer to the deque
+ * @param elem  [in] element to push
+ *
+ * @return DEQUE_OK if successful, or
+ * @return DEQUE_NO_MEMORY if unsufficient memory for allocation, or
+ * @return DEQUE_NULL if 'deque' is NULL
+ */
+int dequePush(PtDeque deque, DequeElem elem);
+
+/**
+ * @brief Pop the bottom element of a deque, i.e., the one pushed
+ * last (owner only).
+ *
+ * @param deque [in] pointer to the deque
+ * @param ptElem [out] address of variable to hold the value
+ *
+ * @return DEQUE_OK if successful and value in 'ptElem', or
+ * @return DEQUE_EMPTY if the deque is empty (or its last element was stolen), or
+ * @return DEQUE_NULL if 'deque' is NULL
+ */
+int dequePop(PtDeque deque, DequeElem *ptElem);
+
+/**
+ * @brief Steal the top element of a deque, i.e., the one pushed
+ * first (any thread).
+ *
+ * @param deque [in] pointer to the deque
+ * @param ptElem [out] address of variable to hold the value
+ *
+ * @return DEQUE_OK if successful and value in 'ptElem', or
+ * @return DEQUE_EMPTY if the deque is empty, or
+ * @return DEQUE_RETRY if another thread took the element first
+ * (the deque may still have elements), or
+ * @return DEQUE_NULL if 'deque' is NULL
+ */
+int dequeSteal(PtDeque deque, DequeElem *ptElem);
+
+/**
+ * @brief Retrieves the size of a deque.
+ *
+ * While other threads operate on the deque, it is only a snapshot.
+ *
+ * @param deque [in] pointer to the deque
+ * @param ptSize [out] address of variable to hold the value
+ *
+ * @return DEQUE_OK if successful and value in 'ptSize', or
+ * @return DEQUE_NULL if 'deque' is NULL
+ */
+int dequeSize(PtDeque deque, int *ptSize);
+
+/**
+ * @brief Checks whether a deque is empty.
+ *
+ * @param deque [in] pointer to the deque
+ *
+ * @return 'true' if empty or if 'deque' is NULL, or
+ * @return 'false' it not empty
+ */
+bool dequeIsEmpty(PtDeque deque);
+
+/**
+ * @brief Retrieves the statistics of a deque (owner only).
+ *
+ * Statistics are only recorded when compiled with ADT_STATS
+ * defined (see adtStats.h); otherwise, they are all zero and
+ * 'enabled' is false. As thieves operate concurrently, only the
+ * memory allocated and the reallocations (by the owner) are recorded.
+ *
+ * @param deque [in] pointer to the deque
+ * @param ptStats [out] address of variable to hold the statistics
+ *
+ * @return DEQUE_OK if successful and statistics in 'ptStats', or
+ * @return DEQUE_NULL if 'deque' is NULL
+ */
+int dequeStats(PtDeque deque, AdtStats *ptStats);
+
+/**
+ * @brief Prints the contents of a deque, from top to bottom.
+ *
+ * @param deque [in] pointer to the deque
+ */
+void dequePrint(PtDeque deque);
@@ -0,0 +1,257 @@
+/**
+ * @file dequeChaseLev.c
+ *
+ * @brief Provides a lock-free implementation of the ADT Deque
+ * with a growable circular array (Chase-Lev deque).
+ *
+ * The owner pushes and pops at 'bottom', thieves steal at 'top', both
+ * only ever increasing (modulo the capacity, they index the array).
+ * The owner and the thieves only compete for the last element, which
+ * they claim with a CAS on 'top'. The memory orderings follow the C11
+ * version of Le, Pop, Cohen and Zappa Nardelli, "Correct and Efficient
+ * Work-Stealing for Weak Memory Models" (PPoPP 2013), except that
+ * dequePush publishes 'bottom' with a release store instead of a
+ * release fence, which is equivalent here and understood by ThreadSanitizer.
+ *
+ * When full, the owner copies the elements to an array twice as large.
+ * Thieves may still be reading the old array, so it is only freed by
+ * dequeDestroy.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "deque.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+
+#define CACHE_LINE_SIZE 64
+
+#define INITIAL_CAPACITY 32
+
+typedef struct array {
+	long capacity;					/* power of two */
+	struct array *retired;			/* smaller array it replaced, freed by dequeDestroy */
+	_Atomic(DequeElem) elements[];
+} Array;
+
+typedef struct dequeImpl {
+	_Alignas(CACHE_LINE_SIZE) atomic_long top;		/* written by thieves */
+	_Alignas(CACHE_LINE_SIZE) atomic_long bottom;	/* written by the owner */
+	_Atomic(Array*) array;
+	ADT_STATS_MEMBER								/* only memory, see dequeStats */
+} DequeImpl;
+
+static Array* arrayCreate(long capacity) {
+	Array *array = (Array*)malloc(sizeof(Array) + capacity * sizeof(DequeElem));
+	if (array == NULL) return NULL;
+
+	array->capacity = capacity;
+	array->retired = NULL;
+
+	return array;
+}
+
+static DequeElem arrayGet(Array *array, long index) {
+	return atomic_load_explicit(&array->elements[index & (array->capacity - 1)], memory_order_relaxed);
+}
+
+static void arrayPut(Array *array, long index, DequeElem elem) {
+	atomic_store_explicit(&array->elements[index & (array->capacity - 1)], elem, memory_order_relaxed);
+}
+
+/**
+ * @brief Auxiliary function to replace the array of a deque with
+ * one twice as large, holding the elements in [top, bottom).
+ *
+ * @return the new array, or
+ * @return NULL if unsufficient memory for allocation
+ */
+static Array* grow(PtDeque deque, Array *array, long top, long bottom) {
+	Array *newArray = arrayCreate(array->capacity * 2);
+	if (newArray == NULL) return NULL;
+
+	for (long i = top; i < bottom; i++) {
+		arrayPut(newArray, i, arrayGet(array, i));
+	}
+	newArray->retired = array;
+
+	atomic_store_explicit(&deque->array, newArray, memory_order_release);
+
+	ADT_STATS_REALLOC(deque->stats, sizeof(Array) + newArray->capacity * sizeof(DequeElem));
+
+	return newArray;
+}
+
+PtDeque dequeCreateWithCapacity(int capacity) {
+	if (capacity < 1) return NULL;
+
+	long roundedCapacity = 1;
+	while (roundedCapacity < capacity) roundedCapacity *= 2;
+
+	PtDeque deque = (PtDeque)aligned_alloc(CACHE_LINE_SIZE, sizeof(DequeImpl));
+	if (deque == NULL) return NULL;
+
+	Array *array = arrayCreate(roundedCapacity);
+	if (array == NULL) {
+		free(deque);
+		return NULL;
+	}
+
+	atomic_init(&deque->top, 0);
+	atomic_init(&deque->bottom, 0);
+	atomic_init(&deque->array, array);
+
+	ADT_STATS_INIT(deque->stats);
+	ADT_STATS_ALLOC(deque->stats, sizeof(DequeImpl) + sizeof(Array) + roundedCapacity * sizeof(DequeElem));
+
+	return deque;
+}
+
+PtDeque dequeCreate() {
+	return dequeCreateWithCapacity(INITIAL_CAPACITY);
+}
+
+int dequeDestroy(PtDeque *ptDeque) {
+	PtDeque deque = *ptDeque;
+	if (deque == NULL) return DEQUE_NULL;
+
+	Array *array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+	while (array != NULL) {
+		Array *retired = array->retired;
+		free(array);
+		array = retired;
+	}
+
+	free(deque);
+	*ptDeque = NULL;
+
+	return DEQUE_OK;
+}
+
+int dequePush(PtDeque deque, DequeElem elem) {
+	if (deque == NULL) return DEQUE_NULL;
+
+	long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+	long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+	Array *array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+
+	if (bottom - top > array->capacity - 1) {
+		array = grow(deque, array, top, bottom);
+		if (array == NULL) return DEQUE_NO_MEMORY;
+	}
+
+	arrayPut(array, bottom, elem);
+
+	/* publish the element with the new bottom (release, paired with the acquire in dequeSteal) */
+	atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+
+	return DEQUE_OK;
+}
+
+int dequePop(PtDeque deque, DequeElem *ptElem) {
+	if (deque == NULL) return DEQUE_NULL;
+
+	long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+	Array *array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+
+	/* reserve the bottom element, then see whether thieves got to it */
+	atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+	long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+	if (top > bottom) {
+		/* it was empty */
+		atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+		return DEQUE_EMPTY;
+	}
+
+	DequeElem elem = arrayGet(array, bottom);
+
+	if (top == bottom) {
+		/* the last element: race the thieves for it */
+		bool won = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+				memory_order_seq_cst, memory_order_relaxed);
+		atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+
+		if (!won) return DEQUE_EMPTY;
+	}
+
+	*ptElem = elem;
+
+	return DEQUE_OK;
+}
+
+int dequeSteal(PtDeque deque, DequeElem *ptElem) {
+	if (deque == NULL) return DEQUE_NULL;
+
+	long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+	atomic_thread_fence(memory_order_seq_cst);
+	long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+	if (top >= bottom) return DEQUE_EMPTY;
+
+	Array *array = atomic_load_explicit(&deque->array, memory_order_acquire);
+	DequeElem elem = arrayGet(array, top);
+
+	if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+			memory_order_seq_cst, memory_order_relaxed)) {
+		return DEQUE_RETRY;
+	}
+
+	*ptElem = elem;
+
+	return DEQUE_OK;
+}
+
+int dequeSize(PtDeque deque, int *ptSize) {
+	if (deque == NULL) return DEQUE_NULL;
+
+	/* 'top' first: 'bottom' read afterwards is at least as recent */
+	long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+	long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+	*ptSize = (int)(bottom > top ? bottom - top : 0);
+
+	return DEQUE_OK;
+}
+
+bool dequeIsEmpty(PtDeque deque) {
+	if (deque == NULL) return true;
+
+	int size;
+	dequeSize(deque, &size);
+
+	return (size == 0);
+}
+
+int dequeStats(PtDeque deque, AdtStats *ptStats) {
+	if (deque == NULL) return DEQUE_NULL;
+
+	ADT_STATS_COPY(deque->stats, ptStats);
+
+	return DEQUE_OK;
+}
+
+void dequePrint(PtDeque deque) {
+	if (deque == NULL) {
+		printf("(DEQUE NULL)\n");
+		return;
+	}
+
+	long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+	long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+	Array *array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+
+	if (top >= bottom) {
+		printf("(DEQUE EMPTY)\n");
+		return;
+	}
+
+	printf("Deque contents (top to bottom): \n");
+	for (long i = top; i < bottom; i++) {
+		dequeElemPrint(arrayGet(array, i));
+		printf("\n");
+	}
+}
@@ -0,0 +1,18 @@
+/**
+ * @file dequeElem.c
+ * @brief Implements operations for DequeElem
+ *
+ * The operations must be implemented according
+ * to the concrete type of DequeElem and changed
+ * accordingly when the type is changed.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "dequeElem.h"
+#include <stdio.h>
+
+void dequeElemPrint(DequeElem elem) {
+	printf("%p", elem);
+}
@@ -0,0 +1,30 @@
+/**
+ * @file dequeElem.h
+ * @brief Defines the type DequeElem.
+ *
+ * The DequeElem is an alias to the type of elements
+ * held by an instance of the ADT Deque (PtDeque).
+ *
+ * This alias must be changed according to the use-case.
+ * Elements are read and written atomically, so it should be
+ * a type of at most the size of a pointer, e.g., a pointer to
+ * a task, to keep the deque lock-free.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#pragma once
+
+/** Type definition. Change according to the use-case. */
+typedef void* DequeElem;
+
+/**
+ * @brief Prints an element.
+ *
+ * Must be implemented according to the concrete
+ * type of DequeElem.
+ *
+ * @param elem [in] element to print
+ */
+void dequeElemPrint(DequeElem elem);
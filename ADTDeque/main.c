@@ -0,0 +1,57 @@
+/**
+ * @file main.c
+ *
+ * @brief Provides an example program that uses the
+ * ADT Deque from a single thread. Please note that the
+ * DequeElem type must be defined as 'void*'.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "deque.h"
+
+int main() {
+
+	PtDeque d = dequeCreateWithCapacity(2);
+
+	char *words[] = { "a", "b", "c", "d", "e", "f" };
+
+	printf("Pushing strings a, b, c, d, e and f (the deque grows)... ");
+	for (int i = 0; i < 6; i++) {
+		dequePush(d, words[i]);
+	}
+	printf("Done. \n");
+
+	int size;
+	dequeSize(d, &size);
+	printf("\nDeque contains %d elements.\n\n", size);
+
+	DequeElem x;
+	printf("Stealing two elements (as a thief, oldest first): \n");
+	for (int i = 0; i < 2; i++) {
+		dequeSteal(d, &x);
+		printf("%s\n", (char*)x); //expected: a,b
+	}
+
+	printf("Popping all elements until empty (as the owner, newest first): \n");
+	while (dequePop(d, &x) == DEQUE_OK) {
+		printf("%s\n", (char*)x); //expected: f,e,d,c
+	}
+
+	dequeSize(d, &size);
+	printf("\nDeque contains %d elements.\n\n", size);
+
+	AdtStats stats;
+	dequeStats(d, &stats);
+	if (stats.enabled) {
+		adtStatsPrint(&stats);
+	}
+
+	dequeDestroy(&d);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,227 @@
+/**
+ * @file poolMain.c
+ *
+ * @brief Provides a thread-pool demo and benchmark of the ADT Deque
+ * (dequeChaseLev.c). Please note that the DequeElem type must be
+ * defined as 'void*'.
+ *
+ * Every worker owns a deque of tasks. It pops the tasks it spawned
+ * itself and, when its deque is empty, steals from the deques of
+ * randomly chosen workers. The workload is the recursive computation
+ * of fib(n): a task for n spawns the tasks for n-1 and n-2, down to a
+ * cutoff below which it computes sequentially. Tasks never wait for
+ * their children: the last child to complete adds up the results and
+ * completes its parent, and the root completes the computation.
+ *
+ * For 1, 2, 4, ... workers, the program checks the result against the
+ * sequential computation and prints the speedup over it.
+ *
+ * Usage: prog [max workers] [n] [cutoff]
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include "deque.h"
+
+#define MAX_WORKERS 64
+
+typedef struct task {
+	int n;
+	atomic_int pending;		/* children not yet completed */
+	atomic_long result;		/* sum of the results of the children */
+	struct task *parent;
+} Task;
+
+typedef struct worker {
+	pthread_t thread;
+	int id;
+	PtDeque deque;
+	uint64_t random;		/* state of xorshift64, to choose victims */
+	long steals;
+} Worker;
+
+static Worker workers[MAX_WORKERS];
+static int numWorkers;
+static int cutoff;
+static atomic_bool done;
+static long rootResult;
+
+static long fibSequential(int n) {
+	return (n < 2) ? n : fibSequential(n - 1) + fibSequential(n - 2);
+}
+
+static Task* taskCreate(int n, Task *parent) {
+	Task *task = (Task*)malloc(sizeof(Task));
+	if (task == NULL) {
+		printf("Could not create a task.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	task->n = n;
+	atomic_init(&task->pending, 0);
+	atomic_init(&task->result, 0);
+	task->parent = parent;
+
+	return task;
+}
+
+/** Completes a task with a result, and its ancestors whose children are all complete. */
+static void complete(Task *task, long result) {
+	while (true) {
+		Task *parent = task->parent;
+		free(task);
+
+		if (parent == NULL) {
+			rootResult = result;
+			atomic_store_explicit(&done, true, memory_order_release);
+			return;
+		}
+
+		atomic_fetch_add_explicit(&parent->result, result, memory_order_relaxed);
+
+		/* acq_rel: the last child sees the results added by the others */
+		if (atomic_fetch_sub_explicit(&parent->pending, 1, memory_order_acq_rel) != 1) return;
+
+		task = parent;
+		result = atomic_load_explicit(&parent->result, memory_order_relaxed);
+	}
+}
+
+static void run(Worker *worker, Task *task) {
+	if (task->n < cutoff) {
+		complete(task, fibSequential(task->n));
+		return;
+	}
+
+	atomic_store_explicit(&task->pending, 2, memory_order_relaxed);
+
+	/* the task is published to thieves by dequePush */
+	dequePush(worker->deque, taskCreate(task->n - 2, task));
+	dequePush(worker->deque, taskCreate(task->n - 1, task));
+}
+
+static uint64_t nextRandom(uint64_t *state) {
+	uint64_t x = *state;
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	return *state = x;
+}
+
+static void* work(void *arg) {
+	Worker *worker = (Worker*)arg;
+	DequeElem elem;
+
+	while (!atomic_load_explicit(&done, memory_order_acquire)) {
+		if (dequePop(worker->deque, &elem) == DEQUE_OK) {
+			run(worker, (Task*)elem);
+			continue;
+		}
+
+		if (numWorkers > 1) {
+			int victim = (int)(nextRandom(&worker->random) % (numWorkers - 1));
+			if (victim >= worker->id) victim++;
+
+			if (dequeSteal(workers[victim].deque, &elem) == DEQUE_OK) {
+				worker->steals++;
+				run(worker, (Task*)elem);
+				continue;
+			}
+		}
+
+		sched_yield();
+	}
+
+	return NULL;
+}
+
+static double elapsedSeconds(struct timespec start, struct timespec end) {
+	return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+/** Computes fib(n) with 'count' workers; returns the result and the elapsed time and steals. */
+static long parallelFib(int count, int n, double *ptSeconds, long *ptSteals) {
+	struct timespec start, end;
+
+	numWorkers = count;
+	atomic_store(&done, false);
+
+	for (int i = 0; i < count; i++) {
+		workers[i].id = i;
+		workers[i].random = 0x9E3779B97F4A7C15ull * (i + 1);
+		workers[i].steals = 0;
+		workers[i].deque = dequeCreate();
+		if (workers[i].deque == NULL) {
+			printf("Could not create the deques.\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	/* the root goes to worker 0, the others start by stealing */
+	dequePush(workers[0].deque, taskCreate(n, NULL));
+
+	for (int i = 0; i < count; i++) {
+		pthread_create(&workers[i].thread, NULL, work, &workers[i]);
+	}
+
+	*ptSteals = 0;
+	for (int i = 0; i < count; i++) {
+		pthread_join(workers[i].thread, NULL);
+		*ptSteals += workers[i].steals;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	*ptSeconds = elapsedSeconds(start, end);
+
+	for (int i = 0; i < count; i++) {
+		dequeDestroy(&workers[i].deque);
+	}
+
+	return rootResult;
+}
+
+int main(int argc, char** argv) {
+	int maxWorkers = (argc > 1) ? atoi(argv[1]) : 8;
+	int n = (argc > 2) ? atoi(argv[2]) : 36;
+	cutoff = (argc > 3) ? atoi(argv[3]) : 20;
+
+	if (maxWorkers < 1 || maxWorkers > MAX_WORKERS || n < 0 || n > 60 || cutoff < 2) {
+		printf("Usage: %s [max workers <= %d] [n <= 60] [cutoff >= 2]\n", argv[0], MAX_WORKERS);
+		return EXIT_FAILURE;
+	}
+
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	long expected = fibSequential(n);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	double sequential = elapsedSeconds(start, end);
+
+	printf("fib(%d) = %ld, cutoff: %d, sequential: %.3f s\n", n, expected, cutoff, sequential);
+	printf("%8s %12s %10s %10s\n", "workers", "time (s)", "speedup", "steals");
+
+	bool passed = true;
+	for (int count = 1; count <= maxWorkers; count *= 2) {
+		double seconds;
+		long steals;
+		long result = parallelFib(count, n, &seconds, &steals);
+
+		passed = passed && (result == expected);
+
+		printf("%8d %12.3f %10.2f %10ld\n", count, seconds, sequential / seconds, steals);
+	}
+
+	printf("%s\n", passed ? "PASSED" : "FAILED");
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
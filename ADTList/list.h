@@ -18,6 +18,7 @@
 #define LIST_INVALID_RANK	5
 
 #include "listElem.h"
+#include "adtStats.h"
 #include <stdbool.h>
 
 /** Forward declaration of the data structure. */
@@ -34,6 +35,18 @@ typedef struct listImpl *PtList;
  */
 PtList listCreate();
 
+/**
+ * @brief Creates a new empty list with memory for a number of elements.
+ * 
+ * Same as listCreate followed by listReserve.
+ * 
+ * @param capacity [in] number of elements to reserve memory for
+ * 
+ * @return PtList pointer to allocated data structure, or
+ * @return NULL if 'capacity' < 1 or unsufficient memory for allocation
+ */
+PtList listCreateWithCapacity(int capacity);
+
 /**
  * @brief Free all resources of a list.
  * 
@@ -112,6 +125,127 @@ int listGet(PtList list, int rank, ListElem *ptElem);
  */
 int listSet(PtList list, int rank, ListElem elem, ListElem *ptOldElem);
 
+/**
+ * @brief Splits a list in two at a given rank.
+ * 
+ * The specified rank must be in [0, size].
+ * The elements at ranks [rank, size - 1] are moved, in order,
+ * to a new list; 'list' keeps the elements at ranks [0, rank - 1].
+ * The new list must be destroyed with listDestroy.
+ * 
+ * @param list [in] pointer to the list
+ * @param rank [in] rank of the first element to move
+ * @param ptOther [out] address of variable to hold the new list
+ * 
+ * @return LIST_OK if successful and new list in 'ptOther', or
+ * @return LIST_INVALID_RANK if 'rank' is invalid, or
+ * @return LIST_NO_MEMORY if unsufficient memory for allocation, or
+ * @return LIST_NULL if 'list' is NULL 
+ */
+int listSplit(PtList list, int rank, PtList *ptOther);
+
+/**
+ * @brief Appends all elements of a list to another one.
+ * 
+ * The elements of 'other' are moved, in order, to the end of
+ * 'list', leaving 'other' empty (but not destroyed).
+ * Both lists must be distinct. If unsuccessful, both lists 
+ * remain unchanged.
+ * 
+ * @param list [in] pointer to the list to append to
+ * @param other [in] pointer to the list whose elements are moved
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NO_MEMORY if unsufficient memory for allocation, or
+ * @return LIST_NULL if 'list' or 'other' are NULL 
+ */
+int listConcat(PtList list, PtList other);
+
+/**
+ * @brief Adds several elements to a list.
+ * 
+ * The specified rank must be in [0, size].
+ * The 'n' elements of 'src' are inserted, in order, starting at
+ * the given rank, as if by 'n' calls to listAdd at ranks 
+ * rank, rank + 1, ..., but in O(n + size) time or better.
+ * If unsuccessful, the list remains unchanged.
+ * 
+ * @param list [in] pointer to the list
+ * @param rank [in] rank for insertion of the first element
+ * @param src [in] array with the elements to add
+ * @param n [in] number of elements to add
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_INVALID_RANK if 'rank' is invalid or 'n' is negative, or
+ * @return LIST_NO_MEMORY if unsufficient memory for allocation, or
+ * @return LIST_NULL if 'list' or 'src' are NULL 
+ */
+int listAddAll(PtList list, int rank, const ListElem *src, int n);
+
+/**
+ * @brief Removes a range of elements from a list.
+ * 
+ * Removes the elements at ranks [from, to - 1], where
+ * 0 <= from <= to <= size.
+ * 
+ * @param list [in] pointer to the list
+ * @param from [in] rank of the first element to remove
+ * @param to [in] rank after the last element to remove
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_INVALID_RANK if the range is invalid, or
+ * @return LIST_NULL if 'list' is NULL 
+ */
+int listRemoveRange(PtList list, int from, int to);
+
+/**
+ * @brief Copies a range of elements of a list to an array.
+ * 
+ * Copies the 'n' elements at ranks [from, from + n - 1], where
+ * 0 <= from and from + n <= size, to 'dst'.
+ * 
+ * @param list [in] pointer to the list
+ * @param from [in] rank of the first element to copy
+ * @param n [in] number of elements to copy
+ * @param dst [out] array with room for 'n' elements
+ * 
+ * @return LIST_OK if successful and elements in 'dst', or
+ * @return LIST_INVALID_RANK if the range is invalid, or
+ * @return LIST_NULL if 'list' or 'dst' are NULL 
+ */
+int listCopyTo(PtList list, int from, int n, ListElem *dst);
+
+/**
+ * @brief Reserves memory for a number of elements.
+ * 
+ * Allocates in advance, where the implementation allows it, the 
+ * memory needed to hold 'capacity' elements, so that the list can 
+ * grow up to that size with fewer (or no) further allocations.
+ * Does nothing if 'capacity' is not greater than the size.
+ * 
+ * @param list [in] pointer to the list
+ * @param capacity [in] number of elements to reserve memory for
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NO_MEMORY if unsufficient memory for allocation, or
+ * @return LIST_NULL if 'list' is NULL 
+ */
+int listReserve(PtList list, int capacity);
+
+/**
+ * @brief Releases the memory a list holds beyond its elements.
+ * 
+ * Frees, where the implementation allows it, the memory reserved
+ * with listReserve or kept by listClearRetain and by the removal
+ * of elements.
+ * 
+ * @param list [in] pointer to the list
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NULL if 'list' is NULL 
+ */
+int listShrinkToFit(PtList list);
+
 /**
  * @brief Retrieves the size of a list.
  * 
@@ -146,6 +280,36 @@ bool listIsEmpty(PtList list);
  */
 int listClear(PtList list);
 
+/**
+ * @brief Clears the contents of a list, keeping its memory.
+ * 
+ * Unlike listClear, which releases the memory of a large list,
+ * the list keeps, where the implementation allows it, the memory
+ * of the elements it held, so that refilling it does not allocate 
+ * memory.
+ * 
+ * @param list [in] pointer to the list
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NULL if 'list' is NULL 
+ */
+int listClearRetain(PtList list);
+
+/**
+ * @brief Retrieves the statistics of a list.
+ * 
+ * Statistics are only recorded when compiled with ADT_STATS
+ * defined (see adtStats.h); otherwise, they are all zero and 
+ * 'enabled' is false.
+ * 
+ * @param list [in] pointer to the list
+ * @param ptStats [out] address of variable to hold the statistics
+ * 
+ * @return LIST_OK if successful and statistics in 'ptStats', or
+ * @return LIST_NULL if 'list' is NULL 
+ */
+int listStats(PtList list, AdtStats *ptStats);
+
 /**
  * @brief Prints the contents of a list.
  * 
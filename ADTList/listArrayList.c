@@ -11,6 +11,7 @@
 #include "list.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define INITIAL_CAPACITY 20
 
@@ -18,6 +19,7 @@ typedef struct listImpl {
 	ListElem* elements;
 	int size; 
 	int capacity;
+	ADT_STATS_MEMBER
 } ListImpl;
 
 
@@ -31,16 +33,43 @@ static bool ensureCapacity(PtList list) {
 
 		list->elements = newArray;
 		list->capacity = newCapacity;
+
+		ADT_STATS_REALLOC(list->stats, newCapacity * sizeof(ListElem));
 	}
 	
 	return true;
 }
 
+static bool ensureCapacityFor(PtList list, int minCapacity) {
+	if (minCapacity > list->capacity) {
+		int newCapacity = list->capacity;
+		while (newCapacity < minCapacity) newCapacity *= 2;
+
+		ListElem* newArray = (ListElem*) realloc( list->elements, 
+								newCapacity * sizeof(ListElem) );
+		
+		if(newArray == NULL) return false;
+
+		list->elements = newArray;
+		list->capacity = newCapacity;
+
+		ADT_STATS_REALLOC(list->stats, newCapacity * sizeof(ListElem));
+	}
+
+	return true;
+}
+
 PtList listCreate() {
+	return listCreateWithCapacity(INITIAL_CAPACITY);
+}
+
+PtList listCreateWithCapacity(int capacity) {
+	if (capacity < 1) return NULL;
+
 	PtList list = (PtList)malloc(sizeof(ListImpl));
 	if (list == NULL) return NULL;
 
-	list->elements = (ListElem*)calloc(INITIAL_CAPACITY,
+	list->elements = (ListElem*)calloc(capacity,
 										sizeof(ListElem));
 
 	if (list->elements == NULL) {
@@ -49,7 +78,10 @@ PtList listCreate() {
 	}
 
 	list->size = 0;
-	list->capacity = INITIAL_CAPACITY;
+	list->capacity = capacity;
+
+	ADT_STATS_INIT(list->stats);
+	ADT_STATS_ALLOC(list->stats, sizeof(ListImpl) + capacity * sizeof(ListElem));
 
 	return list;
 }
@@ -70,6 +102,8 @@ int listAdd(PtList list, int rank, ListElem elem) {
 	if (list == NULL) return LIST_NULL;
 	if (rank < 0 || rank > list->size) return LIST_INVALID_RANK;
 
+	ADT_STATS_START(start);
+
 	if(!ensureCapacity(list)) return LIST_NO_MEMORY;
 
 	/* make room for new element at index 'rank' */
@@ -81,6 +115,8 @@ int listAdd(PtList list, int rank, ListElem elem) {
 
 	list->size++;
 
+	ADT_STATS_STOP(list->stats, ADT_OP_INSERT, start);
+
 	return LIST_OK;
 }
 
@@ -89,6 +125,8 @@ int listRemove(PtList list, int rank, ListElem *ptElem) {
 	if (list->size == 0) return LIST_EMPTY;
 	if (rank < 0 || rank > list->size - 1) return LIST_INVALID_RANK;
 
+	ADT_STATS_START(start);
+
 	*ptElem = list->elements[rank];
 
 	/* close the gap at this rank */
@@ -98,6 +136,8 @@ int listRemove(PtList list, int rank, ListElem *ptElem) {
 
 	list->size--;
 
+	ADT_STATS_STOP(list->stats, ADT_OP_REMOVE, start);
+
 	return LIST_OK;
 }
 
@@ -105,8 +145,12 @@ int listGet(PtList list, int rank, ListElem *ptElem) {
 	if (list == NULL) return LIST_NULL;
 	if (rank < 0 || rank > list->size - 1) return LIST_INVALID_RANK;
 
+	ADT_STATS_START(start);
+
 	*ptElem = list->elements[rank];
 
+	ADT_STATS_STOP(list->stats, ADT_OP_LOOKUP, start);
+
 	return LIST_OK;
 }
 
@@ -114,10 +158,125 @@ int listSet(PtList list, int rank, ListElem elem, ListElem *ptOldElem) {
 	if (list == NULL) return LIST_NULL;
 	if (rank < 0 || rank > list->size - 1) return LIST_INVALID_RANK;
 
+	ADT_STATS_START(start);
+
 	*ptOldElem = list->elements[rank];
 
 	list->elements[rank] = elem;
 
+	ADT_STATS_STOP(list->stats, ADT_OP_LOOKUP, start);
+
+	return LIST_OK;
+}
+
+int listSplit(PtList list, int rank, PtList *ptOther) {
+	if (list == NULL) return LIST_NULL;
+	if (rank < 0 || rank > list->size) return LIST_INVALID_RANK;
+
+	PtList other = listCreate();
+	if (other == NULL) return LIST_NO_MEMORY;
+
+	int count = list->size - rank;
+	if (!ensureCapacityFor(other, count)) {
+		listDestroy(&other);
+		return LIST_NO_MEMORY;
+	}
+
+	memcpy(other->elements, list->elements + rank, count * sizeof(ListElem));
+	other->size = count;
+	list->size = rank;
+
+	*ptOther = other;
+
+	return LIST_OK;
+}
+
+int listConcat(PtList list, PtList other) {
+	if (list == NULL || other == NULL) return LIST_NULL;
+
+	if (!ensureCapacityFor(list, list->size + other->size)) return LIST_NO_MEMORY;
+
+	memcpy(list->elements + list->size, other->elements, other->size * sizeof(ListElem));
+	list->size += other->size;
+
+	return listClear(other);
+}
+
+int listAddAll(PtList list, int rank, const ListElem *src, int n) {
+	if (list == NULL || src == NULL) return LIST_NULL;
+	if (rank < 0 || rank > list->size || n < 0) return LIST_INVALID_RANK;
+
+	if(!ensureCapacityFor(list, list->size + n)) return LIST_NO_MEMORY;
+
+	/* make room for the new elements at indices [rank, rank + n) */
+	memmove(list->elements + rank + n, list->elements + rank, 
+			(list->size - rank) * sizeof(ListElem));
+	memcpy(list->elements + rank, src, n * sizeof(ListElem));
+
+	list->size += n;
+
+	return LIST_OK;
+}
+
+int listRemoveRange(PtList list, int from, int to) {
+	if (list == NULL) return LIST_NULL;
+	if (from < 0 || from > to || to > list->size) return LIST_INVALID_RANK;
+
+	/* close the gap at indices [from, to) */
+	memmove(list->elements + from, list->elements + to, 
+			(list->size - to) * sizeof(ListElem));
+
+	list->size -= to - from;
+
+	return LIST_OK;
+}
+
+int listCopyTo(PtList list, int from, int n, ListElem *dst) {
+	if (list == NULL || dst == NULL) return LIST_NULL;
+	if (from < 0 || n < 0 || from > list->size - n) return LIST_INVALID_RANK;
+
+	memcpy(dst, list->elements + from, n * sizeof(ListElem));
+
+	return LIST_OK;
+}
+
+int listReserve(PtList list, int capacity) {
+	if (list == NULL) return LIST_NULL;
+
+	if (capacity > list->capacity) {
+		ListElem* newArray = (ListElem*) realloc( list->elements, 
+								capacity * sizeof(ListElem) );
+		
+		if(newArray == NULL) return LIST_NO_MEMORY;
+
+		list->elements = newArray;
+		list->capacity = capacity;
+
+		ADT_STATS_REALLOC(list->stats, capacity * sizeof(ListElem));
+	}
+
+	return LIST_OK;
+}
+
+int listShrinkToFit(PtList list) {
+	if (list == NULL) return LIST_NULL;
+
+	/* keep room for one element, so that the capacity can double */
+	int newCapacity = (list->size > 0) ? list->size : 1;
+
+	if (newCapacity < list->capacity) {
+		ListElem* newArray = (ListElem*) realloc( list->elements, 
+								newCapacity * sizeof(ListElem) );
+
+		/* shrinking in place should not fail; if it does, keep the array */
+		if (newArray != NULL) {
+			list->elements = newArray;
+			list->capacity = newCapacity;
+
+			ADT_STATS_REALLOC(list->stats, newCapacity * sizeof(ListElem));
+		}
+	}
+
 	return LIST_OK;
 }
 
@@ -144,10 +303,29 @@ int listClear(PtList list) {
 	if(list->capacity > INITIAL_CAPACITY) {
 		list->elements = (ListElem*)realloc(list->elements, INITIAL_CAPACITY * sizeof(ListElem));
 		list->capacity = INITIAL_CAPACITY;
+
+		ADT_STATS_REALLOC(list->stats, INITIAL_CAPACITY * sizeof(ListElem));
 	}
 
 	return LIST_OK;
 }
+
+int listClearRetain(PtList list) {
+	if (list == NULL) return LIST_NULL;
+
+	list->size = 0;
+
+	return LIST_OK;
+}
+
+int listStats(PtList list, AdtStats *ptStats) {
+	if (list == NULL) return LIST_NULL;
+
+	ADT_STATS_COPY(list->stats, ptStats);
+
+	return LIST_OK;
+}
+
 void listPrint(PtList list) {
 	if (list == NULL) {
 		printf("(List NULL)\n");
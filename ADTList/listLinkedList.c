@@ -10,6 +10,7 @@
  */
 
 #include "list.h"
+#include "nodePool.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -25,26 +26,71 @@ typedef struct listImpl {
 	PtNode header;
 	PtNode trailer;
 	unsigned int size; 
+	PtNodePool pool;	/* allocator of the element nodes */
+	ADT_STATS_MEMBER
 } ListImpl;
 
 
 static PtNode nodeAtRank(PtList list, int rank) {
 	
-	int currentRank = 0;
-	PtNode currentNode = list->header->next;
-	while (currentNode != NULL) { 
+	/* walk from the nearest sentinel; rank == size yields the trailer */
+	PtNode currentNode;
+	if (rank <= (int)list->size / 2) {
+		currentNode = list->header->next;
+		for (int i = 0; i < rank; i++) currentNode = currentNode->next;
 
-		if (currentRank == rank) return currentNode;
+		ADT_STATS_PROBES(list->stats, rank + 1);
+	}
+	else {
+		currentNode = list->trailer;
+		for (int i = list->size; i > rank; i--) currentNode = currentNode->prev;
 
-		currentRank++;
-		currentNode = currentNode->next;
+		ADT_STATS_PROBES(list->stats, (int)list->size - rank + 1);
 	}
 
-	/* may be optimized if rank > size/2 by starting at trailer */
+	return currentNode;
+}
+
 
-	return NULL;
+/** Removes the last 'count' element nodes of a list. */
+static void removeLast(PtList list, int count) {
+	for (int i = 0; i < count; i++) {
+		PtNode node = list->trailer->prev;
+		node->prev->next = list->trailer;
+		list->trailer->prev = node->prev;
+
+		nodePoolFree(list->pool, node);
+		list->size--;
+	}
 }
 
+/**
+ * Appends copies of the elements of nodes [first, end) to a list.
+ * On failure, the list is left unchanged.
+ */
+static bool appendCopies(PtList list, PtNode first, PtNode end) {
+	int appended = 0;
+
+	for (PtNode current = first; current != end; current = current->next) {
+		PtNode newNode = (PtNode)nodePoolAlloc(list->pool);
+		if (newNode == NULL) {
+			removeLast(list, appended);
+			return false;
+		}
+
+		newNode->element = current->element;
+		newNode->next = list->trailer;
+		newNode->prev = list->trailer->prev;
+
+		list->trailer->prev->next = newNode;
+		list->trailer->prev = newNode;
+
+		list->size++;
+		appended++;
+	}
+
+	return true;
+}
 
 PtList listCreate() {
 		
@@ -64,6 +110,14 @@ PtList listCreate() {
 		return NULL;
 	}
 
+	newList->pool = nodePoolCreate(sizeof(Node));
+	if(newList->pool == NULL) {
+		free(newList->trailer);
+		free(newList->header);
+		free(newList);
+		return NULL;
+	}
+
 	newList->header->prev = NULL;
 	newList->header->next = newList->trailer;
 
@@ -72,20 +126,35 @@ PtList listCreate() {
 
 	newList->size = 0;
 
+	ADT_STATS_INIT(newList->stats);
+	ADT_STATS_ALLOC(newList->stats, sizeof(ListImpl) + 2 * sizeof(Node));
+
 	return newList;
 }
 
+PtList listCreateWithCapacity(int capacity) {
+	if (capacity < 1) return NULL;
+
+	PtList list = listCreate();
+	if (list == NULL) return NULL;
+
+	if (listReserve(list, capacity) != LIST_OK) {
+		listDestroy(&list);
+		return NULL;
+	}
+
+	return list;
+}
+
 int listDestroy(PtList *ptList) {
 	PtList list = *ptList;
 	if (list == NULL) return LIST_NULL;
 
-	PtNode current = list->header;
-	while (current != NULL) {
-		PtNode remove = current;
-		current = current->next;
-		free(remove);
-	}
+	/* element nodes are released with their pool */
+	nodePoolDestroy(&list->pool);
 
+	free(list->header);
+	free(list->trailer);
 	free(list);
 
 	*ptList = NULL;
@@ -97,11 +166,13 @@ int listAdd(PtList list, int rank, ListElem elem) {
 	if (list == NULL) return LIST_NULL;
 	if (rank < 0 || rank > list->size) return LIST_INVALID_RANK;
 
+	ADT_STATS_START(start);
+
 
 	PtNode nodeCurRank = nodeAtRank(list, rank);
 	PtNode nodePrevRank = nodeCurRank->prev;
 
-	PtNode newNode = (PtNode)malloc(sizeof(Node));
+	PtNode newNode = (PtNode)nodePoolAlloc(list->pool);
 	if( newNode == NULL) return LIST_NO_MEMORY;
 	
 	newNode->element = elem;
@@ -113,6 +184,8 @@ int listAdd(PtList list, int rank, ListElem elem) {
 
 	list->size++;
 
+	ADT_STATS_STOP(list->stats, ADT_OP_INSERT, start);
+
 	return LIST_OK;
 }
 
@@ -121,6 +194,8 @@ int listRemove(PtList list, int rank, ListElem *ptElem) {
 	if (list->size == 0) return LIST_EMPTY;
 	if (rank < 0 || rank > list->size - 1) return LIST_INVALID_RANK;
 
+	ADT_STATS_START(start);
+
 	PtNode nodeCurRank = nodeAtRank(list, rank);
 	*ptElem = nodeCurRank->element;
 
@@ -129,10 +204,12 @@ int listRemove(PtList list, int rank, ListElem *ptElem) {
 	nodePrevRank->next = nodeNextRank;
 	nodeNextRank->prev = nodePrevRank;
 
-	free(nodeCurRank);
+	nodePoolFree(list->pool, nodeCurRank);
 
 	list->size--;
 
+	ADT_STATS_STOP(list->stats, ADT_OP_REMOVE, start);
+
 	return LIST_OK;
 }
 
@@ -140,11 +217,15 @@ int listGet(PtList list, int rank, ListElem *ptElem) {
 	if (list == NULL) return LIST_NULL;
 	if (rank < 0 || rank > list->size - 1) return LIST_INVALID_RANK;
 
+	ADT_STATS_START(start);
+
 	PtNode node = nodeAtRank(list, rank);
 	if (node != NULL) {
 		*ptElem = node->element;
 	}
 
+	ADT_STATS_STOP(list->stats, ADT_OP_LOOKUP, start);
+
 	return LIST_OK;
 }
 
@@ -152,12 +233,144 @@ int listSet(PtList list, int rank, ListElem elem, ListElem *ptOldElem) {
 	if (list == NULL) return LIST_NULL;
 	if (rank < 0 || rank > list->size - 1) return LIST_INVALID_RANK;
 
+	ADT_STATS_START(start);
+
 	PtNode node = nodeAtRank(list, rank);
 	if (node != NULL) {
 		*ptOldElem = node->element;
 		node->element = elem;
 	}
 
+	ADT_STATS_STOP(list->stats, ADT_OP_LOOKUP, start);
+
+	return LIST_OK;
+}
+
+int listSplit(PtList list, int rank, PtList *ptOther) {
+	if (list == NULL) return LIST_NULL;
+	if (rank < 0 || rank > list->size) return LIST_INVALID_RANK;
+
+	PtList other = listCreate();
+	if (other == NULL) return LIST_NO_MEMORY;
+
+	/* nodes belong to the pool of their list, so they are copied, not relinked */
+	if (!appendCopies(other, nodeAtRank(list, rank), list->trailer)) {
+		listDestroy(&other);
+		return LIST_NO_MEMORY;
+	}
+
+	removeLast(list, list->size - rank);
+
+	*ptOther = other;
+
+	return LIST_OK;
+}
+
+int listConcat(PtList list, PtList other) {
+	if (list == NULL || other == NULL) return LIST_NULL;
+
+	if (!appendCopies(list, other->header->next, other->trailer)) {
+		return LIST_NO_MEMORY;
+	}
+
+	return listClear(other);
+}
+
+int listAddAll(PtList list, int rank, const ListElem *src, int n) {
+	if (list == NULL || src == NULL) return LIST_NULL;
+	if (rank < 0 || rank > list->size || n < 0) return LIST_INVALID_RANK;
+
+	if (n == 0) return LIST_OK;
+
+	/* build a chain with the new nodes, then splice it in place */
+	PtNode first = NULL, last = NULL;
+	for (int i = 0; i < n; i++) {
+		PtNode newNode = (PtNode)nodePoolAlloc(list->pool);
+		if (newNode == NULL) {
+			while (last != NULL) {
+				PtNode remove = last;
+				last = last->prev;
+				nodePoolFree(list->pool, remove);
+			}
+			return LIST_NO_MEMORY;
+		}
+
+		newNode->element = src[i];
+		newNode->prev = last;
+		if (last != NULL) last->next = newNode;
+		else first = newNode;
+		last = newNode;
+	}
+
+	PtNode nodeCurRank = nodeAtRank(list, rank);
+	PtNode nodePrevRank = nodeCurRank->prev;
+
+	first->prev = nodePrevRank;
+	last->next = nodeCurRank;
+	nodePrevRank->next = first;
+	nodeCurRank->prev = last;
+
+	list->size += n;
+
+	return LIST_OK;
+}
+
+int listRemoveRange(PtList list, int from, int to) {
+	if (list == NULL) return LIST_NULL;
+	if (from < 0 || from > to || to > list->size) return LIST_INVALID_RANK;
+
+	if (from == 0 && to == list->size) return listClear(list);
+
+	PtNode nodePrevRank = nodeAtRank(list, from)->prev;
+	PtNode current = nodePrevRank->next;
+	for (int i = from; i < to; i++) {
+		PtNode remove = current;
+		current = current->next;
+		nodePoolFree(list->pool, remove);
+	}
+
+	nodePrevRank->next = current;
+	current->prev = nodePrevRank;
+
+	list->size -= to - from;
+
+	return LIST_OK;
+}
+
+int listCopyTo(PtList list, int from, int n, ListElem *dst) {
+	if (list == NULL || dst == NULL) return LIST_NULL;
+	if (from < 0 || n < 0 || from > (int)list->size - n) return LIST_INVALID_RANK;
+
+	if (n == 0) return LIST_OK;
+
+	PtNode current = nodeAtRank(list, from);
+	for (int i = 0; i < n; i++) {
+		dst[i] = current->element;
+		current = current->next;
+	}
+
+	return LIST_OK;
+}
+
+int listReserve(PtList list, int capacity) {
+	if (list == NULL) return LIST_NULL;
+
+	if (capacity > (int)list->size) {
+		if (nodePoolReserve(list->pool, capacity - list->size) != NODEPOOL_OK) {
+			return LIST_NO_MEMORY;
+		}
+	}
+
+	return LIST_OK;
+}
+
+int listShrinkToFit(PtList list) {
+	if (list == NULL) return LIST_NULL;
+
+	/* nodes in use may be spread over all chunks of the pool,
+	   so memory can only be released when there are none */
+	if (list->size == 0) nodePoolReset(list->pool);
+
 	return LIST_OK;
 }
 
@@ -178,10 +391,25 @@ bool listIsEmpty(PtList list) {
 int listClear(PtList list) {
 	if (list == NULL) return LIST_NULL;
 
+	nodePoolReset(list->pool);
+
+	list->header->next = list->trailer;
+	list->trailer->prev = list->header;
+
+	list->size = 0;
+
+	return LIST_OK;
+}
+
+int listClearRetain(PtList list) {
+	if (list == NULL) return LIST_NULL;
+
+	/* return the nodes to the pool, which keeps their memory */
 	PtNode current = list->header->next;
 	while (current != list->trailer) {
-		current = current->next;
-		free(current->prev);
+		PtNode next = current->next;
+		nodePoolFree(list->pool, current);
+		current = next;
 	}
 
 	list->header->next = list->trailer;
@@ -192,6 +420,19 @@ int listClear(PtList list) {
 	return LIST_OK;
 }
 
+int listStats(PtList list, AdtStats *ptStats) {
+	if (list == NULL) return LIST_NULL;
+
+	ADT_STATS_COPY(list->stats, ptStats);
+
+	/* the nodes of the elements are allocated by the pool */
+	if (ptStats->enabled) {
+		ptStats->bytesAllocated += nodePoolBytesAllocated(list->pool);
+	}
+
+	return LIST_OK;
+}
+
 void listPrint(PtList list) {
 	if (list == NULL) {
 		printf("(LIST NULL)\n");
@@ -0,0 +1,275 @@
+/**
+ * @file listTemplate.h
+ * @brief Generic, type-specialized version of the ADT List
+ * with an array list as the underlying data structure.
+ *
+ * DEFINE_LIST(Name, T) defines a list of elements of type T,
+ * unboxed, as the type 'Name' and the functions 'Name##Create',
+ * 'Name##Add', etc., with the same semantics and error codes as the
+ * operations of list.h (see listArrayList.c). The functions are
+ * 'static inline', so each translation unit may define several
+ * lists, of different types, without changing listElem.h.
+ *
+ * Example:
+ *
+ *     DEFINE_LIST(DoubleList, double)
+ *
+ *     DoubleList list = DoubleListCreate();
+ *     DoubleListAdd(list, 0, 3.14);
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/* same values as in list.h */
+#define LIST_OK				0
+#define LIST_NULL			1
+#define LIST_NO_MEMORY		2
+#define LIST_EMPTY			3
+#define LIST_FULL			4
+#define LIST_INVALID_RANK	5
+
+#define LIST_TEMPLATE_INITIAL_CAPACITY 20
+
+/**
+ * @brief Defines the type 'Name', a list of elements of type 'T',
+ * and its operations.
+ *
+ * @param Name name of the list type, also the prefix of its operations
+ * @param T type of the elements
+ */
+#define DEFINE_LIST(Name, T)                                                    \
+                                                                                \
+typedef struct Name##Impl {                                                     \
+	T *elements;                                                                \
+	int size;                                                                   \
+	int capacity;                                                               \
+} Name##Impl;                                                                   \
+                                                                                \
+typedef Name##Impl *Name;                                                       \
+                                                                                \
+static inline bool Name##EnsureCapacity(Name list, int minCapacity) {           \
+	if (minCapacity > list->capacity) {                                         \
+		int newCapacity = list->capacity;                                       \
+		while (newCapacity < minCapacity) newCapacity *= 2;                     \
+                                                                                \
+		T *newArray = (T*)realloc(list->elements, newCapacity * sizeof(T));     \
+		if (newArray == NULL) return false;                                     \
+                                                                                \
+		list->elements = newArray;                                              \
+		list->capacity = newCapacity;                                           \
+	}                                                                           \
+                                                                                \
+	return true;                                                                \
+}                                                                               \
+                                                                                \
+static inline Name Name##Create(void) {                                         \
+	Name list = (Name)malloc(sizeof(Name##Impl));                               \
+	if (list == NULL) return NULL;                                              \
+                                                                                \
+	list->elements = (T*)malloc(LIST_TEMPLATE_INITIAL_CAPACITY * sizeof(T));    \
+	if (list->elements == NULL) {                                               \
+		free(list);                                                             \
+		return NULL;                                                            \
+	}                                                                           \
+                                                                                \
+	list->size = 0;                                                             \
+	list->capacity = LIST_TEMPLATE_INITIAL_CAPACITY;                            \
+                                                                                \
+	return list;                                                                \
+}                                                                               \
+                                                                                \
+static inline int Name##Destroy(Name *ptList) {                                 \
+	Name list = *ptList;                                                        \
+	if (list == NULL) return LIST_NULL;                                         \
+                                                                                \
+	free(list->elements);                                                       \
+	free(list);                                                                 \
+                                                                                \
+	*ptList = NULL;                                                             \
+                                                                                \
+	return LIST_OK;                                                             \
+}                                                                               \
+                                                                                \
+static inline int Name##Add(Name list, int rank, T elem) {                      \
+	if (list == NULL) return LIST_NULL;                                         \
+	if (rank < 0 || rank > list->size) return LIST_INVALID_RANK;                \
+                                                                                \
+	if (!Name##EnsureCapacity(list, list->size + 1)) return LIST_NO_MEMORY;     \
+                                                                                \
+	memmove(list->elements + rank + 1, list->elements + rank,                   \
+			(list->size - rank) * sizeof(T));                                   \
+	list->elements[rank] = elem;                                                \
+	list->size++;                                                               \
+                                                                                \
+	return LIST_OK;                                                             \
+}                                                                               \
+                                                                                \
+static inline int Name##Remove(Name list, int rank, T *ptElem) {                \
+	if (list == NULL) return LIST_NULL;                                         \
+	if (list->size == 0) return LIST_EMPTY;                                     \
+	if (rank < 0 || rank > list->size - 1) return LIST_INVALID_RANK;            \
+                                                                                \
+	*ptElem = list->elements[rank];                                             \
+                                                                                \
+	memmove(list->elements + rank, list->elements + rank + 1,                   \
+			(list->size - rank - 1) * sizeof(T));                               \
+	list->size--;                                                               \
+                                                                                \
+	return LIST_OK;                                                             \
+}                                                                               \
+                                                                                \
+static inline int Name##Get(Name list, int rank, T *ptElem) {                   \
+	if (list == NULL) return LIST_NULL;                                         \
+	if (rank < 0 || rank > list->size - 1) return LIST_INVALID_RANK;            \
+                                                                                \
+	*ptElem = list->elements[rank];                                             \
+                                                                                \
+	return LIST_OK;                                                             \
+}                                                                               \
+                                                                                \
+static inline int Name##Set(Name list, int rank, T elem, T *ptOldElem) {        \
+	if (list == NULL) return LIST_NULL;                                         \
+	if (rank < 0 || rank > list->size - 1) return LIST_INVALID_RANK;            \
+                                                                                \
+	*ptOldElem = list->elements[rank];                                          \
+	list->elements[rank] = elem;                                                \
+                                                                                \
+	return LIST_OK;                                                             \
+}                                                                               \
+                                                                                \
+static inline int Name##AddAll(Name list, int rank, const T *src, int n) {      \
+	if (list == NULL || src == NULL) return LIST_NULL;                          \
+	if (rank < 0 || rank > list->size || n < 0) return LIST_INVALID_RANK;       \
+                                                                                \
+	if (!Name##EnsureCapacity(list, list->size + n)) return LIST_NO_MEMORY;     \
+                                                                                \
+	memmove(list->elements + rank + n, list->elements + rank,                   \
+			(list->size - rank) * sizeof(T));                                   \
+	memcpy(list->elements + rank, src, n * sizeof(T));                          \
+	list->size += n;                                                            \
+                                                                                \
+	return LIST_OK;                                                             \
+}                                                                               \
+                                                                                \
+static inline int Name##RemoveRange(Name list, int from, int to) {              \
+	if (list == NULL) return LIST_NULL;                                         \
+	if (from < 0 || from > to || to > list->size) return LIST_INVALID_RANK;     \
+                                                                                \
+	memmove(list->elements + from, list->elements + to,                         \
+			(list->size - to) * sizeof(T));                                     \
+	list->size -= to - from;                                                    \
+                                                                                \
+	return LIST_OK;                                                             \
+}                                                                               \
+                                                                                \
+static inline int Name##CopyTo(Name list, int from, int n, T *dst) {            \
+	if (list == NULL || dst == NULL) return LIST_NULL;                          \
+	if (from < 0 || n < 0 || from > list->size - n) return LIST_INVALID_RANK;   \
+                                                                                \
+	memcpy(dst, list->elements + from, n * sizeof(T));                          \
+                                                                                \
+	return LIST_OK;                                                             \
+}                                                                               \
+                                                                                \
+static inline int Name##Reserve(Name list, int capacity) {                      \
+	if (list == NULL) return LIST_NULL;                                         \
+                                                                                \
+	if (capacity > list->capacity) {                                            \
+		T *newArray = (T*)realloc(list->elements, capacity * sizeof(T));        \
+		if (newArray == NULL) return LIST_NO_MEMORY;                            \
+                                                                                \
+		list->elements = newArray;                                              \
+		list->capacity = capacity;                                              \
+	}                                                                           \
+                                                                                \
+	return LIST_OK;                                                             \
+}                                                                               \
+                                                                                \
+static inline int Name##Clear(Name list);                                       \
+                                                                                \
+static inline int Name##Split(Name list, int rank, Name *ptOther) {             \
+	if (list == NULL) return LIST_NULL;                                         \
+	if (rank < 0 || rank > list->size) return LIST_INVALID_RANK;                \
+                                                                                \
+	Name other = Name##Create();                                                \
+	if (other == NULL) return LIST_NO_MEMORY;                                   \
+                                                                                \
+	int count = list->size - rank;                                              \
+	if (Name##AddAll(other, 0, list->elements + rank, count) != LIST_OK) {      \
+		Name##Destroy(&other);                                                  \
+		return LIST_NO_MEMORY;                                                  \
+	}                                                                           \
+	list->size = rank;                                                          \
+                                                                                \
+	*ptOther = other;                                                           \
+                                                                                \
+	return LIST_OK;                                                             \
+}                                                                               \
+                                                                                \
+static inline int Name##Concat(Name list, Name other) {                         \
+	if (list == NULL || other == NULL) return LIST_NULL;                        \
+                                                                                \
+	int result = Name##AddAll(list, list->size, other->elements, other->size);  \
+	if (result != LIST_OK) return result;                                       \
+                                                                                \
+	return Name##Clear(other);                                                  \
+}                                                                               \
+                                                                                \
+static inline int Name##Size(Name list, int *ptSize) {                          \
+	if (list == NULL) return LIST_NULL;                                         \
+                                                                                \
+	*ptSize = list->size;                                                       \
+                                                                                \
+	return LIST_OK;                                                             \
+}                                                                               \
+                                                                                \
+static inline bool Name##IsEmpty(Name list) {                                   \
+	if (list == NULL) return true;                                              \
+                                                                                \
+	return (list->size == 0);                                                   \
+}                                                                               \
+                                                                                \
+static inline int Name##Clear(Name list) {                                      \
+	if (list == NULL) return LIST_NULL;                                         \
+                                                                                \
+	list->size = 0;                                                             \
+                                                                                \
+	/* housekeeping: the array can be very large, shrink to initial size */     \
+	if (list->capacity > LIST_TEMPLATE_INITIAL_CAPACITY) {                      \
+		T *newArray = (T*)realloc(list->elements,                               \
+							LIST_TEMPLATE_INITIAL_CAPACITY * sizeof(T));        \
+		if (newArray != NULL) {                                                 \
+			list->elements = newArray;                                          \
+			list->capacity = LIST_TEMPLATE_INITIAL_CAPACITY;                    \
+		}                                                                       \
+	}                                                                           \
+                                                                                \
+	return LIST_OK;                                                             \
+}                                                                               \
+                                                                                \
+/* prints by rank, with 'elemPrint' printing each element */                    \
+static inline void Name##Print(Name list, void (*elemPrint)(T)) {               \
+	if (list == NULL) {                                                         \
+		printf("(List NULL)\n");                                                \
+	}                                                                           \
+	else if (list->size == 0) {                                                 \
+		printf("(List EMPTY)\n");                                               \
+	}                                                                           \
+	else {                                                                      \
+		printf("List contents (by rank): \n");                                  \
+		for (int rank = 0; rank < list->size; rank++) {                         \
+			printf("Rank %4d: ", rank);                                         \
+			elemPrint(list->elements[rank]);                                    \
+			printf("\n");                                                       \
+		}                                                                       \
+	}                                                                           \
+	printf("\n");                                                               \
+}
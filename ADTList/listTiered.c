@@ -0,0 +1,580 @@
+/**
+ * @file listTiered.c
+ *
+ * @brief Provides an implementation of the ADT List with a
+ * tiered vector as the underlying data structure.
+ *
+ * The elements are kept in blocks of 'blockSize' elements (a power of
+ * two), each one a circular array. All blocks are full except the last
+ * one, so the element at a given rank is found in O(1) by dividing the
+ * rank by 'blockSize'. Inserting or removing an element shifts at most
+ * half a block and then moves one element in or out of each of the
+ * following blocks, by rotating them, i.e., O(blockSize + numBlocks).
+ *
+ * 'blockSize' doubles (or halves) as the list grows (or shrinks), so
+ * it stays proportional to the square root of the size, and insertion
+ * and removal take O(sqrt(n)).
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "list.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/** Must be a power of two. */
+#define MIN_BLOCK_SIZE 64
+
+typedef struct block {
+	int offset;				/* index of the first element */
+	ListElem elements[];	/* circular array of 'blockSize' elements */
+} Block;
+
+typedef struct listImpl {
+	Block **blocks;
+	int numBlocks;
+	int blocksCapacity;
+	int blockSize;
+	int blockShift;			/* log2(blockSize) */
+	int size;
+	int numAllocated;		/* blocks[numBlocks, numAllocated) are empty, kept for reuse */
+	ADT_STATS_MEMBER
+} ListImpl;
+
+/** Element at index 'i' of the circular array of 'block'. */
+#define AT(list, block, i) \
+	((block)->elements[((block)->offset + (i)) & ((list)->blockSize - 1)])
+
+/** Element at 'rank' of the list. */
+#define ELEM(list, rank) \
+	AT(list, (list)->blocks[(rank) >> (list)->blockShift], (rank) & ((list)->blockSize - 1))
+
+static Block* blockCreate(PtList list, int blockSize) {
+	Block *block = (Block*)malloc(sizeof(Block) + blockSize * sizeof(ListElem));
+	if (block == NULL) return NULL;
+
+	ADT_STATS_ALLOC(list->stats, sizeof(Block) + blockSize * sizeof(ListElem));
+
+	block->offset = 0;
+
+	return block;
+}
+
+static void freeBlocks(PtList list) {
+	for (int i = 0; i < list->numAllocated; i++) {
+		free(list->blocks[i]);
+	}
+
+	list->numBlocks = 0;
+	list->numAllocated = 0;
+}
+
+static int log2Of(int powerOfTwo) {
+	int shift = 0;
+	while ((1 << shift) < powerOfTwo) shift++;
+	return shift;
+}
+
+/**
+ * Moves all elements into blocks of 'newBlockSize' elements.
+ * On failure, the list is left unchanged.
+ */
+static bool rebuild(PtList list, int newBlockSize) {
+	int newNumBlocks = (list->size + newBlockSize - 1) / newBlockSize;
+	int newCapacity = (newNumBlocks > 0) ? newNumBlocks : 1;
+
+	Block **newBlocks = (Block**)malloc(newCapacity * sizeof(Block*));
+	if (newBlocks == NULL) return false;
+
+	for (int b = 0; b < newNumBlocks; b++) {
+		newBlocks[b] = blockCreate(list, newBlockSize);
+		if (newBlocks[b] == NULL) {
+			while (b > 0) free(newBlocks[--b]);
+			free(newBlocks);
+			return false;
+		}
+	}
+
+	for (int rank = 0; rank < list->size; rank++) {
+		newBlocks[rank / newBlockSize]->elements[rank % newBlockSize] = ELEM(list, rank);
+	}
+
+	freeBlocks(list);
+	free(list->blocks);
+
+	list->blocks = newBlocks;
+	list->numBlocks = newNumBlocks;
+	list->numAllocated = newNumBlocks;
+	list->blocksCapacity = newCapacity;
+	list->blockSize = newBlockSize;
+	list->blockShift = log2Of(newBlockSize);
+
+	ADT_STATS_REALLOC(list->stats, newCapacity * sizeof(Block*));
+
+	return true;
+}
+
+static bool addBlock(PtList list) {
+	if (list->numBlocks == list->blocksCapacity) {
+		int newCapacity = list->blocksCapacity * 2;
+		Block **newArray = (Block**)realloc(list->blocks, newCapacity * sizeof(Block*));
+
+		if (newArray == NULL) return false;
+
+		list->blocks = newArray;
+		list->blocksCapacity = newCapacity;
+
+		ADT_STATS_REALLOC(list->stats, newCapacity * sizeof(Block*));
+	}
+
+	if (list->numBlocks < list->numAllocated) {
+		list->blocks[list->numBlocks]->offset = 0;
+	}
+	else {
+		Block *block = blockCreate(list, list->blockSize);
+		if (block == NULL) return false;
+
+		list->blocks[list->numAllocated++] = block;
+	}
+
+	list->numBlocks++;
+
+	return true;
+}
+
+/** Keeps the removed block for reuse, but no more empty blocks than before. */
+static void removeLastBlock(PtList list) {
+	list->numBlocks--;
+
+	if (list->numAllocated - list->numBlocks > 1) {
+		free(list->blocks[--list->numAllocated]);
+	}
+}
+
+/**
+ * Doubles 'blockSize' until 'capacity' elements fit in at most
+ * 2 * blockSize blocks, and allocates those blocks.
+ */
+static bool reserveBlocks(PtList list, int capacity) {
+	int newBlockSize = list->blockSize;
+	while ((capacity + newBlockSize - 1) / newBlockSize > 2 * newBlockSize) {
+		newBlockSize *= 2;
+	}
+
+	if (newBlockSize != list->blockSize && !rebuild(list, newBlockSize)) return false;
+
+	int neededBlocks = (capacity + list->blockSize - 1) / list->blockSize;
+	if (neededBlocks > list->blocksCapacity) {
+		Block **newArray = (Block**)realloc(list->blocks, neededBlocks * sizeof(Block*));
+
+		if (newArray == NULL) return false;
+
+		list->blocks = newArray;
+		list->blocksCapacity = neededBlocks;
+
+		ADT_STATS_REALLOC(list->stats, neededBlocks * sizeof(Block*));
+	}
+
+	while (list->numAllocated < neededBlocks) {
+		Block *block = blockCreate(list, list->blockSize);
+		if (block == NULL) return false;
+
+		list->blocks[list->numAllocated++] = block;
+	}
+
+	return true;
+}
+
+/** Halves 'blockSize' while numBlocks < blockSize / 8. */
+static void shrinkBlocks(PtList list) {
+	int newBlockSize = list->blockSize;
+	while (newBlockSize > MIN_BLOCK_SIZE &&
+			(list->size + newBlockSize - 1) / newBlockSize < newBlockSize / 8) {
+		newBlockSize /= 2;
+	}
+
+	if (newBlockSize != list->blockSize) {
+		rebuild(list, newBlockSize); /* on failure, keep the larger blocks */
+	}
+}
+
+/** Removes the elements at ranks [newSize, size - 1]. */
+static void truncateTo(PtList list, int newSize) {
+	list->size = newSize;
+	while (list->numBlocks > 0 && list->size <= (list->numBlocks - 1) * list->blockSize) {
+		removeLastBlock(list);
+	}
+
+	shrinkBlocks(list);
+}
+
+/** Number of elements held by block 'b'. */
+static int blockCount(PtList list, int b) {
+	if (b < list->numBlocks - 1) return list->blockSize;
+	return list->size - (b << list->blockShift);
+}
+
+/** Inserts at index 'i' of a block holding 'count' < blockSize elements. */
+static void blockInsert(PtList list, Block *block, int count, int i, ListElem elem) {
+	if (i < count - i) {
+		/* shift the elements before 'i' one position to the left */
+		block->offset = (block->offset - 1) & (list->blockSize - 1);
+		for (int k = 0; k < i; k++) {
+			AT(list, block, k) = AT(list, block, k + 1);
+		}
+	}
+	else {
+		/* shift the elements from 'i' onwards one position to the right */
+		for (int k = count; k > i; k--) {
+			AT(list, block, k) = AT(list, block, k - 1);
+		}
+	}
+
+	AT(list, block, i) = elem;
+}
+
+/** Removes index 'i' of a block holding 'count' elements. */
+static ListElem blockRemove(PtList list, Block *block, int count, int i) {
+	ListElem elem = AT(list, block, i);
+
+	if (i < count / 2) {
+		for (int k = i; k > 0; k--) {
+			AT(list, block, k) = AT(list, block, k - 1);
+		}
+		block->offset = (block->offset + 1) & (list->blockSize - 1);
+	}
+	else {
+		for (int k = i; k < count - 1; k++) {
+			AT(list, block, k) = AT(list, block, k + 1);
+		}
+	}
+
+	return elem;
+}
+
+PtList listCreate() {
+	PtList list = (PtList)malloc(sizeof(ListImpl));
+	if (list == NULL) return NULL;
+
+	list->blocks = (Block**)malloc(sizeof(Block*));
+	if (list->blocks == NULL) {
+		free(list);
+		return NULL;
+	}
+
+	list->numBlocks = 0;
+	list->blocksCapacity = 1;
+	list->blockSize = MIN_BLOCK_SIZE;
+	list->blockShift = log2Of(MIN_BLOCK_SIZE);
+	list->size = 0;
+	list->numAllocated = 0;
+
+	ADT_STATS_INIT(list->stats);
+	ADT_STATS_ALLOC(list->stats, sizeof(ListImpl) + sizeof(Block*));
+
+	return list;
+}
+
+PtList listCreateWithCapacity(int capacity) {
+	if (capacity < 1) return NULL;
+
+	PtList list = listCreate();
+	if (list == NULL) return NULL;
+
+	if (listReserve(list, capacity) != LIST_OK) {
+		listDestroy(&list);
+		return NULL;
+	}
+
+	return list;
+}
+
+int listDestroy(PtList *ptList) {
+	PtList list = *ptList;
+	if (list == NULL) return LIST_NULL;
+
+	freeBlocks(list);
+	free(list->blocks);
+	free(list);
+
+	*ptList = NULL;
+
+	return LIST_OK;
+}
+
+int listAdd(PtList list, int rank, ListElem elem) {
+	if (list == NULL) return LIST_NULL;
+	if (rank < 0 || rank > list->size) return LIST_INVALID_RANK;
+
+	ADT_STATS_START(start);
+
+	if (list->size == list->numBlocks * list->blockSize) {
+		/* all blocks are full; keep numBlocks <= 2 * blockSize */
+		if (list->numBlocks + 1 > 2 * list->blockSize) {
+			if (!rebuild(list, list->blockSize * 2)) return LIST_NO_MEMORY;
+		}
+		if (list->size == list->numBlocks * list->blockSize) {
+			if (!addBlock(list)) return LIST_NO_MEMORY;
+		}
+	}
+
+	int b = rank >> list->blockShift;
+	int last = list->numBlocks - 1;
+	int count = blockCount(list, b);
+
+	/* rotate the last element of each block into the next one */
+	for (int j = last; j > b; j--) {
+		Block *block = list->blocks[j];
+		block->offset = (block->offset - 1) & (list->blockSize - 1);
+		AT(list, block, 0) = AT(list, list->blocks[j - 1], list->blockSize - 1);
+	}
+	if (b < last) count = list->blockSize - 1;
+
+	blockInsert(list, list->blocks[b], count, rank & (list->blockSize - 1), elem);
+
+	list->size++;
+
+	ADT_STATS_STOP(list->stats, ADT_OP_INSERT, start);
+
+	return LIST_OK;
+}
+
+int listRemove(PtList list, int rank, ListElem *ptElem) {
+	if (list == NULL) return LIST_NULL;
+	if (list->size == 0) return LIST_EMPTY;
+	if (rank < 0 || rank > list->size - 1) return LIST_INVALID_RANK;
+
+	ADT_STATS_START(start);
+
+	int b = rank >> list->blockShift;
+	int last = list->numBlocks - 1;
+
+	*ptElem = blockRemove(list, list->blocks[b], blockCount(list, b),
+							rank & (list->blockSize - 1));
+
+	/* rotate the first element of each following block into the previous one */
+	for (int j = b + 1; j <= last; j++) {
+		Block *block = list->blocks[j];
+		AT(list, list->blocks[j - 1], list->blockSize - 1) = AT(list, block, 0);
+		block->offset = (block->offset + 1) & (list->blockSize - 1);
+	}
+
+	truncateTo(list, list->size - 1);
+
+	ADT_STATS_STOP(list->stats, ADT_OP_REMOVE, start);
+
+	return LIST_OK;
+}
+
+int listGet(PtList list, int rank, ListElem *ptElem) {
+	if (list == NULL) return LIST_NULL;
+	if (rank < 0 || rank > list->size - 1) return LIST_INVALID_RANK;
+
+	ADT_STATS_START(start);
+
+	*ptElem = ELEM(list, rank);
+
+	ADT_STATS_STOP(list->stats, ADT_OP_LOOKUP, start);
+
+	return LIST_OK;
+}
+
+int listSet(PtList list, int rank, ListElem elem, ListElem *ptOldElem) {
+	if (list == NULL) return LIST_NULL;
+	if (rank < 0 || rank > list->size - 1) return LIST_INVALID_RANK;
+
+	ADT_STATS_START(start);
+
+	*ptOldElem = ELEM(list, rank);
+	ELEM(list, rank) = elem;
+
+	ADT_STATS_STOP(list->stats, ADT_OP_LOOKUP, start);
+
+	return LIST_OK;
+}
+
+int listSplit(PtList list, int rank, PtList *ptOther) {
+	if (list == NULL) return LIST_NULL;
+	if (rank < 0 || rank > list->size) return LIST_INVALID_RANK;
+
+	PtList other = listCreate();
+	if (other == NULL) return LIST_NO_MEMORY;
+
+	for (int i = rank; i < list->size; i++) {
+		if (listAdd(other, other->size, ELEM(list, i)) != LIST_OK) {
+			listDestroy(&other);
+			return LIST_NO_MEMORY;
+		}
+	}
+
+	truncateTo(list, rank);
+
+	*ptOther = other;
+
+	return LIST_OK;
+}
+
+int listConcat(PtList list, PtList other) {
+	if (list == NULL || other == NULL) return LIST_NULL;
+
+	int oldSize = list->size;
+
+	for (int i = 0; i < other->size; i++) {
+		if (listAdd(list, list->size, ELEM(other, i)) != LIST_OK) {
+			truncateTo(list, oldSize);
+			return LIST_NO_MEMORY;
+		}
+	}
+
+	return listClear(other);
+}
+
+int listAddAll(PtList list, int rank, const ListElem *src, int n) {
+	if (list == NULL || src == NULL) return LIST_NULL;
+	if (rank < 0 || rank > list->size || n < 0) return LIST_INVALID_RANK;
+
+	if (!reserveBlocks(list, list->size + n)) return LIST_NO_MEMORY;
+
+	int oldSize = list->size;
+	int oldNumBlocks = list->numBlocks;
+	while (list->numBlocks * list->blockSize < oldSize + n) {
+		if (!addBlock(list)) {
+			while (list->numBlocks > oldNumBlocks) removeLastBlock(list);
+			return LIST_NO_MEMORY;
+		}
+	}
+
+	list->size += n;
+
+	/* make room for the new elements at ranks [rank, rank + n) */
+	for (int i = oldSize - 1; i >= rank; i--) {
+		ELEM(list, i + n) = ELEM(list, i);
+	}
+	for (int i = 0; i < n; i++) {
+		ELEM(list, rank + i) = src[i];
+	}
+
+	return LIST_OK;
+}
+
+int listRemoveRange(PtList list, int from, int to) {
+	if (list == NULL) return LIST_NULL;
+	if (from < 0 || from > to || to > list->size) return LIST_INVALID_RANK;
+
+	/* close the gap at ranks [from, to) */
+	int removed = to - from;
+	for (int i = to; i < list->size; i++) {
+		ELEM(list, i - removed) = ELEM(list, i);
+	}
+
+	truncateTo(list, list->size - removed);
+
+	return LIST_OK;
+}
+
+int listCopyTo(PtList list, int from, int n, ListElem *dst) {
+	if (list == NULL || dst == NULL) return LIST_NULL;
+	if (from < 0 || n < 0 || from > list->size - n) return LIST_INVALID_RANK;
+
+	for (int i = 0; i < n; i++) {
+		dst[i] = ELEM(list, from + i);
+	}
+
+	return LIST_OK;
+}
+
+int listReserve(PtList list, int capacity) {
+	if (list == NULL) return LIST_NULL;
+
+	if (capacity > list->size && !reserveBlocks(list, capacity)) return LIST_NO_MEMORY;
+
+	return LIST_OK;
+}
+
+int listSize(PtList list, int *ptSize) {
+	if (list == NULL) return LIST_NULL;
+
+	*ptSize = list->size;
+
+	return LIST_OK;
+}
+
+bool listIsEmpty(PtList list) {
+	if (list == NULL) return 1;
+
+	return (list->size == 0);
+}
+
+int listClear(PtList list) {
+	if (list == NULL) return LIST_NULL;
+
+	freeBlocks(list);
+
+	list->size = 0;
+	list->blockSize = MIN_BLOCK_SIZE;
+	list->blockShift = log2Of(MIN_BLOCK_SIZE);
+
+	return LIST_OK;
+}
+
+int listClearRetain(PtList list) {
+	if (list == NULL) return LIST_NULL;
+
+	/* all blocks become empty and are kept for reuse */
+	list->numBlocks = 0;
+	list->size = 0;
+
+	return LIST_OK;
+}
+
+int listShrinkToFit(PtList list) {
+	if (list == NULL) return LIST_NULL;
+
+	while (list->numAllocated > list->numBlocks) {
+		free(list->blocks[--list->numAllocated]);
+	}
+
+	shrinkBlocks(list);
+
+	int newCapacity = (list->numBlocks > 0) ? list->numBlocks : 1;
+	if (newCapacity < list->blocksCapacity) {
+		Block **newArray = (Block**)realloc(list->blocks, newCapacity * sizeof(Block*));
+
+		/* shrinking in place should not fail; if it does, keep the array */
+		if (newArray != NULL) {
+			list->blocks = newArray;
+			list->blocksCapacity = newCapacity;
+
+			ADT_STATS_REALLOC(list->stats, newCapacity * sizeof(Block*));
+		}
+	}
+
+	return LIST_OK;
+}
+
+int listStats(PtList list, AdtStats *ptStats) {
+	if (list == NULL) return LIST_NULL;
+
+	ADT_STATS_COPY(list->stats, ptStats);
+
+	return LIST_OK;
+}
+
+void listPrint(PtList list) {
+	if (list == NULL) {
+		printf("(List NULL)\n");
+	}
+	else if (list->size == 0) {
+		printf("(List EMPTY)\n");
+	}
+	else {
+		printf("List contents (by rank): \n");
+		for(int rank = 0; rank < list->size; rank++) {
+			printf("Rank %4d: ", rank);
+			listElemPrint(ELEM(list, rank));
+			printf("\n");
+		}
+	}
+	printf("\n");
+}
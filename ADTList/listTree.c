@@ -0,0 +1,483 @@
+/**
+ * @file listTree.c
+ *
+ * @brief Provides an implementation of the ADT List with an
+ * implicit treap as the underlying data structure.
+ *
+ * The tree is ordered by rank: each node stores the size of its
+ * subtree, so the rank of a node is the number of nodes to its left,
+ * and no keys are kept. Each node also has a random priority, greater
+ * than or equal to the priorities of its children, which keeps the
+ * expected height in O(log n). Hence, listAdd, listRemove, listGet
+ * and listSet run in O(log n) expected time, as do listSplit and
+ * listConcat, which relink subtrees instead of copying elements.
+ *
+ * Nodes are allocated individually with malloc, as they move
+ * between lists on listSplit and listConcat.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "list.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+struct node;
+typedef struct node* PtNode;
+
+typedef struct node {
+	ListElem element;
+	unsigned int priority;
+	int size;				/* number of nodes in this subtree */
+	PtNode left, right;
+} Node;
+
+typedef struct listImpl {
+	PtNode root;
+	ADT_STATS_MEMBER
+} ListImpl;
+
+/**
+ * State of the priority generator. It is shared by all lists, so that
+ * nodes of different lists do not repeat priorities when concatenated.
+ */
+static unsigned int prioritySeed = 2463534242u;
+
+static int sizeOf(PtNode node) {
+	return (node == NULL) ? 0 : node->size;
+}
+
+static void updateSize(PtNode node) {
+	node->size = 1 + sizeOf(node->left) + sizeOf(node->right);
+}
+
+/** Xorshift pseudo-random generator. */
+static unsigned int nextPriority() {
+	unsigned int x = prioritySeed;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	prioritySeed = x;
+	return x;
+}
+
+/** Splits a tree into its first 'rank' nodes and the remaining ones. */
+static void split(PtNode tree, int rank, PtNode *ptLeft, PtNode *ptRight) {
+	if (tree == NULL) {
+		*ptLeft = NULL;
+		*ptRight = NULL;
+		return;
+	}
+
+	int leftSize = sizeOf(tree->left);
+	if (rank <= leftSize) {
+		split(tree->left, rank, ptLeft, &tree->left);
+		*ptRight = tree;
+	}
+	else {
+		split(tree->right, rank - leftSize - 1, &tree->right, ptRight);
+		*ptLeft = tree;
+	}
+
+	updateSize(tree);
+}
+
+/** Joins two trees, with all nodes of 'left' ranked before those of 'right'. */
+static PtNode merge(PtNode left, PtNode right) {
+	if (left == NULL) return right;
+	if (right == NULL) return left;
+
+	if (left->priority >= right->priority) {
+		left->right = merge(left->right, right);
+		updateSize(left);
+		return left;
+	}
+	else {
+		right->left = merge(left, right->left);
+		updateSize(right);
+		return right;
+	}
+}
+
+static PtNode insertAt(PtNode tree, int rank, PtNode node) {
+	if (tree == NULL) return node;
+
+	if (node->priority > tree->priority) {
+		/* 'node' becomes the root of this subtree */
+		split(tree, rank, &node->left, &node->right);
+		updateSize(node);
+		return node;
+	}
+
+	int leftSize = sizeOf(tree->left);
+	if (rank <= leftSize) {
+		tree->left = insertAt(tree->left, rank, node);
+	}
+	else {
+		tree->right = insertAt(tree->right, rank - leftSize - 1, node);
+	}
+	tree->size++;
+
+	return tree;
+}
+
+static PtNode removeAt(PtNode tree, int rank, PtNode *ptRemoved) {
+	int leftSize = sizeOf(tree->left);
+
+	if (rank == leftSize) {
+		*ptRemoved = tree;
+		return merge(tree->left, tree->right);
+	}
+
+	if (rank < leftSize) {
+		tree->left = removeAt(tree->left, rank, ptRemoved);
+	}
+	else {
+		tree->right = removeAt(tree->right, rank - leftSize - 1, ptRemoved);
+	}
+	tree->size--;
+
+	return tree;
+}
+
+static PtNode nodeAtRank(PtList list, int rank) {
+	PtNode current = list->root;
+	int visited = 0;
+
+	while (current != NULL) {
+		int leftSize = sizeOf(current->left);
+		visited++;
+
+		if (rank == leftSize) break;
+
+		if (rank < leftSize) {
+			current = current->left;
+		}
+		else {
+			rank -= leftSize + 1;
+			current = current->right;
+		}
+	}
+
+	ADT_STATS_PROBES(list->stats, visited);
+
+	return current;
+}
+
+static void freeTree(PtNode tree) {
+	if (tree == NULL) return;
+
+	freeTree(tree->left);
+	freeTree(tree->right);
+	free(tree);
+}
+
+/** Computes the subtree sizes of a tree, returning its size. */
+static int computeSizes(PtNode tree) {
+	if (tree == NULL) return 0;
+
+	tree->size = 1 + computeSizes(tree->left) + computeSizes(tree->right);
+
+	return tree->size;
+}
+
+/**
+ * Builds a treap with the 'n' > 0 elements of 'src', in O(n), by keeping
+ * the right spine of the tree built so far in a stack.
+ * Returns NULL if unsufficient memory for allocation.
+ */
+static PtNode buildTree(const ListElem *src, int n) {
+	PtNode *spine = (PtNode*)malloc(n * sizeof(PtNode));
+	if (spine == NULL) return NULL;
+
+	int top = 0;
+	for (int i = 0; i < n; i++) {
+		PtNode node = (PtNode)malloc(sizeof(Node));
+		if (node == NULL) {
+			if (top > 0) freeTree(spine[0]); /* the bottom of the spine is the root */
+			free(spine);
+			return NULL;
+		}
+
+		node->element = src[i];
+		node->priority = nextPriority();
+		node->right = NULL;
+
+		/* nodes of lower priority on the spine become the left subtree */
+		PtNode last = NULL;
+		while (top > 0 && spine[top - 1]->priority < node->priority) {
+			last = spine[--top];
+		}
+		node->left = last;
+
+		if (top > 0) spine[top - 1]->right = node;
+		spine[top++] = node;
+	}
+
+	PtNode root = spine[0];
+	free(spine);
+
+	computeSizes(root);
+
+	return root;
+}
+
+static void copyTree(PtNode tree, ListElem *dst, int *ptIndex) {
+	if (tree == NULL) return;
+
+	copyTree(tree->left, dst, ptIndex);
+	dst[(*ptIndex)++] = tree->element;
+	copyTree(tree->right, dst, ptIndex);
+}
+
+static void printTree(PtNode tree, int *ptRank) {
+	if (tree == NULL) return;
+
+	printTree(tree->left, ptRank);
+
+	printf("Rank %4d: ", (*ptRank)++);
+	listElemPrint(tree->element);
+	printf("\n");
+
+	printTree(tree->right, ptRank);
+}
+
+PtList listCreate() {
+	PtList list = (PtList)malloc(sizeof(ListImpl));
+	if (list == NULL) return NULL;
+
+	list->root = NULL;
+
+	ADT_STATS_INIT(list->stats);
+	ADT_STATS_ALLOC(list->stats, sizeof(ListImpl));
+
+	return list;
+}
+
+PtList listCreateWithCapacity(int capacity) {
+	if (capacity < 1) return NULL;
+
+	/* nodes are allocated one by one */
+	return listCreate();
+}
+
+int listDestroy(PtList *ptList) {
+	PtList list = *ptList;
+	if (list == NULL) return LIST_NULL;
+
+	freeTree(list->root);
+	free(list);
+
+	*ptList = NULL;
+
+	return LIST_OK;
+}
+
+int listAdd(PtList list, int rank, ListElem elem) {
+	if (list == NULL) return LIST_NULL;
+	if (rank < 0 || rank > sizeOf(list->root)) return LIST_INVALID_RANK;
+
+	ADT_STATS_START(start);
+
+	PtNode node = (PtNode)malloc(sizeof(Node));
+	if (node == NULL) return LIST_NO_MEMORY;
+
+	ADT_STATS_ALLOC(list->stats, sizeof(Node));
+
+	node->element = elem;
+	node->priority = nextPriority();
+	node->size = 1;
+	node->left = NULL;
+	node->right = NULL;
+
+	list->root = insertAt(list->root, rank, node);
+
+	ADT_STATS_STOP(list->stats, ADT_OP_INSERT, start);
+
+	return LIST_OK;
+}
+
+int listRemove(PtList list, int rank, ListElem *ptElem) {
+	if (list == NULL) return LIST_NULL;
+	if (list->root == NULL) return LIST_EMPTY;
+	if (rank < 0 || rank > sizeOf(list->root) - 1) return LIST_INVALID_RANK;
+
+	ADT_STATS_START(start);
+
+	PtNode removed;
+	list->root = removeAt(list->root, rank, &removed);
+
+	*ptElem = removed->element;
+	free(removed);
+
+	ADT_STATS_STOP(list->stats, ADT_OP_REMOVE, start);
+
+	return LIST_OK;
+}
+
+int listGet(PtList list, int rank, ListElem *ptElem) {
+	if (list == NULL) return LIST_NULL;
+	if (rank < 0 || rank > sizeOf(list->root) - 1) return LIST_INVALID_RANK;
+
+	ADT_STATS_START(start);
+
+	*ptElem = nodeAtRank(list, rank)->element;
+
+	ADT_STATS_STOP(list->stats, ADT_OP_LOOKUP, start);
+
+	return LIST_OK;
+}
+
+int listSet(PtList list, int rank, ListElem elem, ListElem *ptOldElem) {
+	if (list == NULL) return LIST_NULL;
+	if (rank < 0 || rank > sizeOf(list->root) - 1) return LIST_INVALID_RANK;
+
+	ADT_STATS_START(start);
+
+	PtNode node = nodeAtRank(list, rank);
+	*ptOldElem = node->element;
+	node->element = elem;
+
+	ADT_STATS_STOP(list->stats, ADT_OP_LOOKUP, start);
+
+	return LIST_OK;
+}
+
+int listSplit(PtList list, int rank, PtList *ptOther) {
+	if (list == NULL) return LIST_NULL;
+	if (rank < 0 || rank > sizeOf(list->root)) return LIST_INVALID_RANK;
+
+	PtList other = listCreate();
+	if (other == NULL) return LIST_NO_MEMORY;
+
+	split(list->root, rank, &list->root, &other->root);
+
+	*ptOther = other;
+
+	return LIST_OK;
+}
+
+int listConcat(PtList list, PtList other) {
+	if (list == NULL || other == NULL) return LIST_NULL;
+
+	list->root = merge(list->root, other->root);
+	other->root = NULL;
+
+	return LIST_OK;
+}
+
+int listAddAll(PtList list, int rank, const ListElem *src, int n) {
+	if (list == NULL || src == NULL) return LIST_NULL;
+	if (rank < 0 || rank > sizeOf(list->root) || n < 0) return LIST_INVALID_RANK;
+
+	if (n == 0) return LIST_OK;
+
+	PtNode tree = buildTree(src, n);
+	if (tree == NULL) return LIST_NO_MEMORY;
+
+	ADT_STATS_ALLOC(list->stats, n * sizeof(Node));
+
+	PtNode left, right;
+	split(list->root, rank, &left, &right);
+	list->root = merge(merge(left, tree), right);
+
+	return LIST_OK;
+}
+
+int listRemoveRange(PtList list, int from, int to) {
+	if (list == NULL) return LIST_NULL;
+	if (from < 0 || from > to || to > sizeOf(list->root)) return LIST_INVALID_RANK;
+
+	PtNode left, middle, right;
+	split(list->root, to, &left, &right);
+	split(left, from, &left, &middle);
+
+	freeTree(middle);
+	list->root = merge(left, right);
+
+	return LIST_OK;
+}
+
+int listCopyTo(PtList list, int from, int n, ListElem *dst) {
+	if (list == NULL || dst == NULL) return LIST_NULL;
+	if (from < 0 || n < 0 || from > sizeOf(list->root) - n) return LIST_INVALID_RANK;
+
+	/* detach the range, copy it in order and put it back */
+	PtNode left, middle, right;
+	split(list->root, from + n, &left, &right);
+	split(left, from, &left, &middle);
+
+	int index = 0;
+	copyTree(middle, dst, &index);
+
+	list->root = merge(merge(left, middle), right);
+
+	return LIST_OK;
+}
+
+int listReserve(PtList list, int capacity) {
+	if (list == NULL) return LIST_NULL;
+
+	(void)capacity; /* nodes are allocated one by one */
+
+	return LIST_OK;
+}
+
+int listShrinkToFit(PtList list) {
+	if (list == NULL) return LIST_NULL;
+
+	/* no memory is held beyond the nodes of the elements */
+	return LIST_OK;
+}
+
+int listSize(PtList list, int *ptSize) {
+	if (list == NULL) return LIST_NULL;
+
+	*ptSize = sizeOf(list->root);
+
+	return LIST_OK;
+}
+
+bool listIsEmpty(PtList list) {
+	if (list == NULL) return 1;
+
+	return (list->root == NULL);
+}
+
+int listClear(PtList list) {
+	if (list == NULL) return LIST_NULL;
+
+	freeTree(list->root);
+	list->root = NULL;
+
+	return LIST_OK;
+}
+
+int listClearRetain(PtList list) {
+	/* nodes are allocated one by one, so no memory is kept for them */
+	return listClear(list);
+}
+
+int listStats(PtList list, AdtStats *ptStats) {
+	if (list == NULL) return LIST_NULL;
+
+	ADT_STATS_COPY(list->stats, ptStats);
+
+	return LIST_OK;
+}
+
+void listPrint(PtList list) {
+	if (list == NULL) {
+		printf("(List NULL)\n");
+	}
+	else if (list->root == NULL) {
+		printf("(List EMPTY)\n");
+	}
+	else {
+		printf("List contents (by rank): \n");
+		int rank = 0;
+		printTree(list->root, &rank);
+	}
+	printf("\n");
+}
@@ -21,9 +21,11 @@ int main(int argc, char** argv) {
 	if(!list) return EXIT_FAILURE;
 
 	/* Populate with values*/
+	int values[9];
 	for(int i=0; i < 9; i++) {
-		listAdd(list, i, (i+1) );
+		values[i] = i + 1;
 	}
+	listAddAll(list, 0, values, 9);
 
 	printf("\n--- Initial list ---\n");
 	listPrint(list);
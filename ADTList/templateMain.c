@@ -0,0 +1,74 @@
+/**
+ * @file templateMain.c
+ * 
+ * @brief Provides an example program that uses two
+ * specializations of the ADT List, defined with DEFINE_LIST,
+ * in the same program: a list of integers and a list of doubles
+ * holding their square roots.
+ * 
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "listTemplate.h"
+
+DEFINE_LIST(IntList, int)
+DEFINE_LIST(DoubleList, double)
+
+static void intPrint(int value) {
+	printf("%d", value);
+}
+
+static void doublePrint(double value) {
+	printf("%.4f", value);
+}
+
+int main() {
+	IntList numbers = IntListCreate();
+	DoubleList roots = DoubleListCreate();
+	if (numbers == NULL || roots == NULL) {
+		printf("Could not create the lists. \n");
+		return EXIT_FAILURE;
+	}
+
+	int squares[] = { 1, 4, 9, 16, 25, 36, 49 };
+	IntListAddAll(numbers, 0, squares, 7);
+	IntListAdd(numbers, 0, 0);
+
+	/* remove 16 and 25, replace 0 by 2 */
+	int old;
+	IntListRemoveRange(numbers, 4, 6);
+	IntListSet(numbers, 0, 2, &old);
+
+	int size;
+	IntListSize(numbers, &size);
+	DoubleListReserve(roots, size);
+	for (int rank = 0; rank < size; rank++) {
+		int number;
+		IntListGet(numbers, rank, &number);
+		DoubleListAdd(roots, rank, sqrt(number));
+	}
+
+	IntListPrint(numbers, intPrint);
+	DoubleListPrint(roots, doublePrint);
+
+	/* move the roots from rank 3 onwards to another list and back */
+	DoubleList tail;
+	if (DoubleListSplit(roots, 3, &tail) == LIST_OK) {
+		DoubleListPrint(tail, doublePrint);
+		DoubleListConcat(roots, tail);
+		DoubleListDestroy(&tail);
+	}
+
+	double first[2];
+	DoubleListCopyTo(roots, 0, 2, first);
+	printf("First two roots: %.4f %.4f \n", first[0], first[1]);
+
+	IntListDestroy(&numbers);
+	DoubleListDestroy(&roots);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file concurrentMain.c
+ *
+ * @brief Provides a stress test and scaling benchmark of the
+ * thread-safe implementation of the ADT Map (mapSharded.c). Please
+ * note that the MapKey and MapValue types must be defined as 'int'.
+ *
+ * For 1, 2, 4, ... threads, every thread runs the same number of
+ * operations on random keys of a shared map, in two workloads:
+ * ingestion, where every operation counts an occurrence of its key
+ * with mapMerge, and mixed, where 90% of the operations are mapGet.
+ * At the end of each run, the program checks that no occurrence was
+ * lost, i.e., that the counts of all keys add up to the merges.
+ *
+ * Usage: prog [max threads] [operations per thread] [keys]
+ *
+ * Compiled with MAP_SHARDS=1 (e.g., 'make stress-sharded SHARDS=1'),
+ * the map is guarded by a single lock, for comparison.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "mapConcurrent.h"
+
+#define MAX_THREADS 64
+
+typedef struct worker {
+	pthread_t thread;
+	int id;
+	int readPercent;	/* operations that are mapGet, the others are mapMerge */
+	long merges;		/* merges done, to check the counts */
+} Worker;
+
+static PtMap map;
+static long operationsPerThread;
+static int keys;
+
+static MapValue add(MapValue current, MapValue value) {
+	return current + value;
+}
+
+/** Per-thread pseudo-random numbers (xorshift64). */
+static uint64_t nextRandom(uint64_t *state) {
+	uint64_t x = *state;
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	return *state = x;
+}
+
+static void* work(void *arg) {
+	Worker *worker = (Worker*)arg;
+	uint64_t state = 0x9E3779B97F4A7C15ull * (worker->id + 1);
+
+	worker->merges = 0;
+
+	for (long i = 0; i < operationsPerThread; i++) {
+		uint64_t r = nextRandom(&state);
+		MapKey key = (MapKey)((r >> 8) % keys);
+
+		if ((int)(r & 127) * 100 < worker->readPercent * 128) {
+			MapValue value;
+			mapGet(map, key, &value);
+		}
+		else {
+			mapMerge(map, key, 1, add);
+			worker->merges++;
+		}
+	}
+
+	return NULL;
+}
+
+static long total;
+static void addToTotal(MapKey key, MapValue value, void *context) {
+	(void)key;
+	(void)context;
+	total += value;
+}
+
+static double elapsedSeconds(struct timespec start, struct timespec end) {
+	return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+/** Runs a workload with 'threads' threads; returns the throughput, or -1 if a check failed. */
+static double run(int threads, int readPercent) {
+	Worker workers[MAX_THREADS];
+	struct timespec start, end;
+
+	map = mapCreateWithCapacity(keys);
+	if (map == NULL) {
+		printf("Could not create the map.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (int i = 0; i < threads; i++) {
+		workers[i].id = i;
+		workers[i].readPercent = readPercent;
+		pthread_create(&workers[i].thread, NULL, work, &workers[i]);
+	}
+
+	long merges = 0;
+	for (int i = 0; i < threads; i++) {
+		pthread_join(workers[i].thread, NULL);
+		merges += workers[i].merges;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	total = 0;
+	mapForEach(map, addToTotal, NULL);
+
+	int size;
+	mapSize(map, &size);
+
+	mapDestroy(&map);
+
+	if (total != merges || size > keys) return -1;
+
+	return threads * operationsPerThread / elapsedSeconds(start, end) / 1e6;
+}
+
+int main(int argc, char** argv) {
+	int maxThreads = (argc > 1) ? atoi(argv[1]) : MAX_THREADS;
+	operationsPerThread = (argc > 2) ? atol(argv[2]) : 1000000;
+	keys = (argc > 3) ? atoi(argv[3]) : 100000;
+
+	if (maxThreads < 1 || maxThreads > MAX_THREADS || operationsPerThread < 1 || keys < 1) {
+		printf("Usage: %s [max threads <= %d] [operations per thread] [keys]\n", argv[0], MAX_THREADS);
+		return EXIT_FAILURE;
+	}
+
+	printf("Shards: %d, keys: %d, operations per thread: %ld\n", MAP_SHARDS, keys, operationsPerThread);
+	printf("%8s %20s %20s\n", "threads", "ingest (M ops/s)", "90% reads (M ops/s)");
+
+	bool passed = true;
+	for (int threads = 1; threads <= maxThreads; threads *= 2) {
+		double ingest = run(threads, 0);
+		double mixed = run(threads, 90);
+
+		passed = passed && ingest >= 0 && mixed >= 0;
+
+		printf("%8d %20.2f %20.2f\n", threads, ingest, mixed);
+	}
+
+	printf("%s\n", passed ? "PASSED" : "FAILED");
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -30,31 +30,17 @@ int main() {
 		int number = vec[i];
 		printf("%d ", number);
 
-		if (mapContains(map, number)) { //existing number
-			mapGet(map, number, &count);
-			count++;
-			mapPut(map, number, count);
-		}
-		else {	//new number 
-			mapPut(map, number, 1);
+		// single lookup: the counter of a new number starts at 0
+		MapValue *ptCount;
+		if (mapGetOrInsertPtr(map, number, 0, &ptCount) == MAP_OK) {
+			(*ptCount)++;
 		}
 	}
 
 	/* Print in ordered tabular format */
 	int size;
 	mapSize(map, &size);
-	MapKey *numbers = mapKeys(map);
-
-	// Sort keys with, e.g., Bubble Sort
-	for(int i=0; i<size; i++) {
-		for(int j=0; j<size-i-1; j++) {
-			if( numbers[j] > numbers[j+1] ) {
-				int aux = numbers[j];
-				numbers[j] = numbers[j+1];
-				numbers[j+1] = aux;
-			}
-		}
-	}
+	MapKey *numbers = mapKeysSorted(map);
 
 	// Print key/value pairs
 	printf("\nNumber | Count \n");
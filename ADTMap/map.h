@@ -18,6 +18,7 @@
 #define MAP_UNKNOWN_KEY	  5
 
 #include "mapElem.h"
+#include "adtStats.h"
 #include <stdbool.h>
 
 /** Forward declaration of the data structure. */
@@ -26,6 +27,41 @@ struct mapImpl;
 /** Definition of pointer to the  data stucture. */
 typedef struct mapImpl *PtMap;
 
+/**
+ * @brief Function called for each key-value mapping 
+ * visited by a traversal of a map.
+ * 
+ * @param key [in] key of the mapping
+ * @param value [in] value of the mapping
+ * @param context [in] user data supplied to the traversal
+ */
+typedef void (*MapVisitFn)(MapKey key, MapValue value, void *context);
+
+/**
+ * @brief Function that combines the value currently mapped
+ * to a key with a new value, used by mapMerge.
+ * 
+ * @param current [in] value currently mapped to the key
+ * @param value [in] value being merged
+ * @return value to map to the key
+ */
+typedef MapValue (*MapCombineFn)(MapValue current, MapValue value);
+
+/**
+ * @brief Cursor over the mappings of a map.
+ * 
+ * An iterator is declared by the caller (e.g., as a local variable),
+ * so iterating allocates no memory. Its fields are managed by the
+ * implementation and must not be accessed directly.
+ * 
+ * Adding or removing mappings while iterating invalidates the iterator.
+ */
+typedef struct mapIterator {
+	PtMap map;			/**< map being iterated */
+	void *position;		/**< implementation-defined, e.g., current node */
+	int index;			/**< implementation-defined, e.g., current slot */
+} MapIterator;
+
 /**
  * @brief Creates a new empty map.
  * 
@@ -34,6 +70,18 @@ typedef struct mapImpl *PtMap;
  */
 PtMap mapCreate();
 
+/**
+ * @brief Creates a new empty map with memory for a number of mappings.
+ * 
+ * Same as mapCreate followed by mapReserve.
+ * 
+ * @param capacity [in] number of mappings to reserve memory for
+ * 
+ * @return PtMap pointer to allocated data structure, or
+ * @return NULL if 'capacity' < 1 or unsufficient memory for allocation
+ */
+PtMap mapCreateWithCapacity(int capacity);
+
 /**
  * @brief Free all resources of a map.
  * 
@@ -62,6 +110,43 @@ int mapDestroy(PtMap *ptMap);
  */
 int mapPut(PtMap map, MapKey key, MapValue value);
 
+/**
+ * @brief Retrieves the address of the value associated with
+ * a key, adding a mapping to a default value if the key doesn't exist.
+ * 
+ * The value can be read and modified through '*ptValue' with a single
+ * lookup, e.g., to increment a counter. The address remains valid only
+ * until the next operation that adds or removes mappings of the map.
+ * 
+ * @param map [in] pointer to the map
+ * @param key [in] key for retrieval
+ * @param defaultValue [in] value to map to 'key' if it doesn't exist
+ * @param ptValue [out] address of variable to hold the address of the value
+ * 
+ * @return MAP_OK if successful and address in 'ptValue', or
+ * @return MAP_NO_MEMORY if unsufficient memory for allocation, or
+ * @return MAP_NULL if 'map' is NULL 
+ */
+int mapGetOrInsertPtr(PtMap map, MapKey key, MapValue defaultValue, MapValue **ptValue);
+
+/**
+ * @brief Merges a value into the mapping of a key.
+ * 
+ * If 'key' doesn't exist, it is mapped to 'value'; otherwise
+ * it is mapped to 'combine(current, value)'. A single lookup
+ * is performed.
+ * 
+ * @param map [in] pointer to the map
+ * @param key [in] key 
+ * @param value [in] value to merge
+ * @param combine [in] function combining the current value with 'value'
+ * 
+ * @return MAP_OK if successful, or
+ * @return MAP_NO_MEMORY if unsufficient memory for allocation, or
+ * @return MAP_NULL if 'map' is NULL 
+ */
+int mapMerge(PtMap map, MapKey key, MapValue value, MapCombineFn combine);
+
 /**
  * @brief Removes a mapping from a map.
  * 
@@ -144,6 +229,139 @@ MapKey* mapKeys(PtMap map);
  */
 MapValue* mapValues(PtMap map);
 
+/**
+ * @brief Retrieves the keys of a map in ascending order.
+ * 
+ * This function returns a dynamically allocated array
+ * with length equal to the size of the map, containing
+ * the keys of the map ordered according to mapKeyCompare.
+ * 
+ * The caller is responsible for deallocating 
+ * (freeing) the array. 
+ * 
+ * @param map [in] pointer to the map
+ * 
+ * @return array containing the ordered keys
+ * @return NULL if 'map' is empty or NULL
+ */
+MapKey* mapKeysSorted(PtMap map);
+
+/**
+ * @brief Retrieves the greatest key of a map that is 
+ * less than or equal to a given key.
+ * 
+ * @param map [in] pointer to the map
+ * @param key [in] key to search for
+ * @param ptFloorKey [out] address of variable to hold the key
+ * 
+ * @return MAP_OK if successful and key in 'ptFloorKey', or
+ * @return MAP_UNKNOWN_KEY if no such key exists, or
+ * @return MAP_EMPTY if the map is empty, or
+ * @return MAP_NULL if 'map' is NULL 
+ */
+int mapFloor(PtMap map, MapKey key, MapKey *ptFloorKey);
+
+/**
+ * @brief Retrieves the least key of a map that is 
+ * greater than or equal to a given key.
+ * 
+ * @param map [in] pointer to the map
+ * @param key [in] key to search for
+ * @param ptCeilingKey [out] address of variable to hold the key
+ * 
+ * @return MAP_OK if successful and key in 'ptCeilingKey', or
+ * @return MAP_UNKNOWN_KEY if no such key exists, or
+ * @return MAP_EMPTY if the map is empty, or
+ * @return MAP_NULL if 'map' is NULL 
+ */
+int mapCeiling(PtMap map, MapKey key, MapKey *ptCeilingKey);
+
+/**
+ * @brief Visits, in ascending key order, every mapping 
+ * whose key lies in the interval [lo, hi].
+ * 
+ * The map must not be modified by 'visit'.
+ * 
+ * @param map [in] pointer to the map
+ * @param lo [in] lower bound of the interval (inclusive)
+ * @param hi [in] upper bound of the interval (inclusive)
+ * @param visit [in] function called for each mapping in range
+ * @param context [in] user data passed to 'visit'
+ * 
+ * @return MAP_OK if successful, or
+ * @return MAP_NO_MEMORY if unsufficient memory for allocation, or
+ * @return MAP_NULL if 'map' is NULL 
+ */
+int mapRange(PtMap map, MapKey lo, MapKey hi, MapVisitFn visit, void *context);
+
+/**
+ * @brief Positions an iterator before the first mapping of a map.
+ * 
+ * Mappings are visited in no particular order, except for
+ * ordered implementations, which visit them in ascending key order.
+ * Typical usage:
+ * 
+ *     MapIterator it;
+ *     mapIterBegin(map, &it);
+ *     while (mapIterNext(&it)) {
+ *         ... mapIterKey(&it) ... mapIterValue(&it) ...
+ *     }
+ * 
+ * @param map [in] pointer to the map
+ * @param it [out] address of the iterator
+ * 
+ * @return MAP_OK if successful, or
+ * @return MAP_NULL if 'map' or 'it' is NULL 
+ */
+int mapIterBegin(PtMap map, MapIterator *it);
+
+/**
+ * @brief Advances an iterator to the next mapping.
+ * 
+ * @param it [in] address of the iterator
+ * 
+ * @return 'true' if the iterator is positioned at a mapping, or
+ * @return 'false' if there are no more mappings or 'it' is NULL
+ */
+bool mapIterNext(MapIterator *it);
+
+/**
+ * @brief Retrieves the key of the mapping at an iterator.
+ * 
+ * The last call to mapIterNext must have returned 'true'.
+ * 
+ * @param it [in] address of the iterator
+ * 
+ * @return key of the current mapping
+ */
+MapKey mapIterKey(const MapIterator *it);
+
+/**
+ * @brief Retrieves the value of the mapping at an iterator.
+ * 
+ * The last call to mapIterNext must have returned 'true'.
+ * 
+ * @param it [in] address of the iterator
+ * 
+ * @return value of the current mapping
+ */
+MapValue mapIterValue(const MapIterator *it);
+
+/**
+ * @brief Visits every mapping of a map.
+ * 
+ * Mappings are visited in the same order as with an iterator.
+ * The map must not be modified by 'visit'.
+ * 
+ * @param map [in] pointer to the map
+ * @param visit [in] function called for each mapping
+ * @param context [in] user data passed to 'visit'
+ * 
+ * @return MAP_OK if successful, or
+ * @return MAP_NULL if 'map' is NULL 
+ */
+int mapForEach(PtMap map, MapVisitFn visit, void *context);
+
 /**
  * @brief Retrieves the size of a map.
  * 
@@ -178,6 +396,66 @@ bool mapIsEmpty(PtMap map);
  */
 int mapClear(PtMap map);
 
+/**
+ * @brief Clears the contents of a map, keeping its memory.
+ * 
+ * Unlike mapClear, which releases the memory of a large map,
+ * the map keeps, where the implementation allows it, the memory
+ * of the mappings it held, so that refilling it does not allocate 
+ * memory.
+ * 
+ * @param map [in] pointer to the map
+ * 
+ * @return MAP_OK if successful, or
+ * @return MAP_NULL if 'map' is NULL 
+ */
+int mapClearRetain(PtMap map);
+
+/**
+ * @brief Reserves memory for a number of mappings.
+ * 
+ * Allocates in advance, where the implementation allows it, the 
+ * memory needed to hold 'capacity' mappings, so that the map can 
+ * grow up to that size without further allocations.
+ * Does nothing if 'capacity' is not greater than the size.
+ * 
+ * @param map [in] pointer to the map
+ * @param capacity [in] number of mappings to reserve memory for
+ * 
+ * @return MAP_OK if successful, or
+ * @return MAP_NO_MEMORY if unsufficient memory for allocation, or
+ * @return MAP_NULL if 'map' is NULL 
+ */
+int mapReserve(PtMap map, int capacity);
+
+/**
+ * @brief Releases the memory a map holds beyond its mappings.
+ * 
+ * Frees, where the implementation allows it, the memory reserved
+ * with mapReserve or kept by mapClearRetain and by removals.
+ * 
+ * @param map [in] pointer to the map
+ * 
+ * @return MAP_OK if successful, or
+ * @return MAP_NULL if 'map' is NULL 
+ */
+int mapShrinkToFit(PtMap map);
+
+/**
+ * @brief Retrieves the statistics of a map.
+ * 
+ * Statistics are only recorded when compiled with ADT_STATS
+ * defined (see adtStats.h); otherwise, they are all zero and 
+ * 'enabled' is false.
+ * 
+ * @param map [in] pointer to the map
+ * @param ptStats [out] address of variable to hold the statistics
+ * 
+ * @return MAP_OK if successful and statistics in 'ptStats', or
+ * @return MAP_NULL if 'map' is NULL 
+ */
+int mapStats(PtMap map, AdtStats *ptStats);
+
 /**
  * @brief Prints the contents of a map.
  * 
@@ -23,6 +23,7 @@ typedef struct mapImpl {
 	KeyValue *elements;
 	int capacity;
 	int size;
+	ADT_STATS_MEMBER
 } MapImpl;
 
 /**
@@ -40,39 +41,73 @@ static int findIndexOfKey(PtMap map, MapKey key) {
 
 	for (int i = 0; i < map->size; i++) {
 		if (mapKeyCompare(map->elements[i].key, key) == 0) {
+			ADT_STATS_PROBES(map->stats, i + 1);
 			return i;
 		}
 	}
+
+	ADT_STATS_PROBES(map->stats, map->size);
 	return -1;
 }
 
+/**
+ * @brief Auxiliary comparison function of keys, for use with qsort.
+ */
+static int compareKeys(const void *key1, const void *key2) {
+	return mapKeyCompare(*(const MapKey*)key1, *(const MapKey*)key2);
+}
+
+/**
+ * @brief Auxiliary comparison function of key-value pairs by key, 
+ * for use with qsort.
+ */
+static int compareKeyValues(const void *kv1, const void *kv2) {
+	return mapKeyCompare(((const KeyValue*)kv1)->key, ((const KeyValue*)kv2)->key);
+}
+
+static bool resize(PtMap map, int newCapacity) {
+	KeyValue* newArray = (KeyValue*) realloc( map->elements, 
+								newCapacity * sizeof(KeyValue) );
+	
+	if(newArray == NULL) return false;
+
+	map->elements = newArray;
+	map->capacity = newCapacity;
+
+	ADT_STATS_REALLOC(map->stats, newCapacity * sizeof(KeyValue));
+
+	return true;
+}
+
 static bool ensureCapacity(PtMap map) {
 	if (map->size == map->capacity) {
-		int newCapacity = map->capacity * 2;
-		KeyValue* newArray = (KeyValue*) realloc( map->elements, 
-									newCapacity * sizeof(KeyValue) );
-		
-		if(newArray == NULL) return false;
-
-		map->elements = newArray;
-		map->capacity = newCapacity;
+		return resize(map, map->capacity * 2);
 	}
 	
 	return true;
 }
 
 PtMap mapCreate() {
+	return mapCreateWithCapacity(INITIAL_CAPACITY);
+}
+
+PtMap mapCreateWithCapacity(int capacity) {
+	if (capacity < 1) return NULL;
+
 	PtMap newMap = (PtMap)malloc(sizeof(MapImpl));
 	if (newMap == NULL) return NULL;
 
-	newMap->elements = (KeyValue*)calloc(INITIAL_CAPACITY, sizeof(KeyValue));
+	newMap->elements = (KeyValue*)calloc(capacity, sizeof(KeyValue));
 	if (newMap->elements == NULL) {
 		free(newMap);
 		return NULL;
 	}
 
 	newMap->size = 0;
-	newMap->capacity = INITIAL_CAPACITY;
+	newMap->capacity = capacity;
+
+	ADT_STATS_INIT(newMap->stats);
+	ADT_STATS_ALLOC(newMap->stats, sizeof(MapImpl) + capacity * sizeof(KeyValue));
 
 	return newMap;
 }
@@ -90,29 +125,88 @@ int mapDestroy(PtMap *ptMap) {
 	return MAP_OK;
 }
 
+/**
+ * @brief Auxiliary function to find the index of a specific key,
+ * appending a mapping to 'value' if the key doesn't exist. 
+ * 
+ * @param map [in] pointer to the map
+ * @param key [in] key to find
+ * @param value [in] value to map to 'key' if it is appended
+ * @param ptInserted [out] address of variable set to whether 'key' was appended
+ * @return index of 'elements' containing 'key', or
+ * @return -1 if unsufficient memory for allocation
+ */
+static int findOrInsertKey(PtMap map, MapKey key, MapValue value, bool *ptInserted) {
+	int index = findIndexOfKey(map, key);
+	*ptInserted = (index == -1);
+	if (index != -1) return index;
+
+	if (!ensureCapacity(map)) return -1;
+
+	index = map->size;
+	map->elements[index].key = key;
+	map->elements[index].value = value;
+	map->size++;
+
+	return index;
+}
+
 int mapPut(PtMap map, MapKey key, MapValue value) {
 	if (map == NULL) return MAP_NULL;
 
-	int index = findIndexOfKey(map, key);
-	if (index != -1) {
-		map->elements[index].value = value;
-		return MAP_OK;
-	}
-	else {
-		if (!ensureCapacity(map)) return MAP_NO_MEMORY;
-		
-		map->elements[map->size].key = key;
-		map->elements[map->size].value = value;
-		map->size++;
+	ADT_STATS_START(start);
+
+	bool inserted;
+	int index = findOrInsertKey(map, key, value, &inserted);
+	if (index == -1) return MAP_NO_MEMORY;
+
+	map->elements[index].value = value;
+
+	ADT_STATS_STOP(map->stats, ADT_OP_INSERT, start);
 
-		return MAP_OK;
+	return MAP_OK;
+}
+
+int mapGetOrInsertPtr(PtMap map, MapKey key, MapValue defaultValue, MapValue **ptValue) {
+	if (map == NULL) return MAP_NULL;
+
+	ADT_STATS_START(start);
+
+	bool inserted;
+	int index = findOrInsertKey(map, key, defaultValue, &inserted);
+	if (index == -1) return MAP_NO_MEMORY;
+
+	*ptValue = &map->elements[index].value;
+
+	ADT_STATS_STOP(map->stats, ADT_OP_INSERT, start);
+
+	return MAP_OK;
+}
+
+int mapMerge(PtMap map, MapKey key, MapValue value, MapCombineFn combine) {
+	if (map == NULL) return MAP_NULL;
+
+	ADT_STATS_START(start);
+
+	bool inserted;
+	int index = findOrInsertKey(map, key, value, &inserted);
+	if (index == -1) return MAP_NO_MEMORY;
+
+	if (!inserted) {
+		map->elements[index].value = combine(map->elements[index].value, value);
 	}
+
+	ADT_STATS_STOP(map->stats, ADT_OP_INSERT, start);
+
+	return MAP_OK;
 }
 
 int mapRemove(PtMap map, MapKey key, MapValue *ptValue) {
 	if (map == NULL) return MAP_NULL;
 	if (map->size == 0) return MAP_EMPTY;
 
+	ADT_STATS_START(start);
+
 	int index = findIndexOfKey(map, key);
 	if (index == -1) return MAP_UNKNOWN_KEY;
 
@@ -120,24 +214,36 @@ int mapRemove(PtMap map, MapKey key, MapValue *ptValue) {
 	map->elements[index] = map->elements[map->size - 1];
 	map->size--;
 	
+	ADT_STATS_STOP(map->stats, ADT_OP_REMOVE, start);
+
 	return MAP_OK;
 }
 
 bool mapContains(PtMap map, MapKey key) {
 	if (map == NULL) return 0;
 
-	return findIndexOfKey(map, key) != -1;
+	ADT_STATS_START(start);
+
+	bool found = findIndexOfKey(map, key) != -1;
+
+	ADT_STATS_STOP(map->stats, ADT_OP_LOOKUP, start);
+
+	return found;
 }
 
 int mapGet(PtMap map, MapKey key, MapValue *ptValue) {
 	if (map == NULL) return MAP_NULL;
 	if (map->size == 0) return MAP_EMPTY;
 
+	ADT_STATS_START(start);
+
 	int index = findIndexOfKey(map, key);
 	if (index == -1) return MAP_UNKNOWN_KEY;
 
 	*ptValue = map->elements[index].value;
 	
+	ADT_STATS_STOP(map->stats, ADT_OP_LOOKUP, start);
+
 	return MAP_OK;
 }
 
@@ -165,6 +271,118 @@ MapValue* mapValues(PtMap map) {
 	return values;
 }
 
+MapKey* mapKeysSorted(PtMap map) {
+	MapKey *keys = mapKeys(map);
+	if (keys == NULL) return NULL;
+
+	qsort(keys, map->size, sizeof(MapKey), compareKeys);
+
+	return keys;
+}
+
+int mapFloor(PtMap map, MapKey key, MapKey *ptFloorKey) {
+	if (map == NULL) return MAP_NULL;
+	if (map->size == 0) return MAP_EMPTY;
+
+	/* array is unordered: keep the greatest key not above 'key' */
+	int best = -1;
+	for (int i = 0; i < map->size; i++) {
+		MapKey current = map->elements[i].key;
+		if (mapKeyCompare(current, key) <= 0 &&
+			(best == -1 || mapKeyCompare(current, map->elements[best].key) > 0)) {
+			best = i;
+		}
+	}
+	if (best == -1) return MAP_UNKNOWN_KEY;
+
+	*ptFloorKey = map->elements[best].key;
+
+	return MAP_OK;
+}
+
+int mapCeiling(PtMap map, MapKey key, MapKey *ptCeilingKey) {
+	if (map == NULL) return MAP_NULL;
+	if (map->size == 0) return MAP_EMPTY;
+
+	/* array is unordered: keep the least key not below 'key' */
+	int best = -1;
+	for (int i = 0; i < map->size; i++) {
+		MapKey current = map->elements[i].key;
+		if (mapKeyCompare(current, key) >= 0 &&
+			(best == -1 || mapKeyCompare(current, map->elements[best].key) < 0)) {
+			best = i;
+		}
+	}
+	if (best == -1) return MAP_UNKNOWN_KEY;
+
+	*ptCeilingKey = map->elements[best].key;
+
+	return MAP_OK;
+}
+
+int mapRange(PtMap map, MapKey lo, MapKey hi, MapVisitFn visit, void *context) {
+	if (map == NULL) return MAP_NULL;
+	if (map->size == 0) return MAP_OK;
+
+	/* gather the mappings in range and sort them by key */
+	KeyValue *inRange = (KeyValue*)malloc(map->size * sizeof(KeyValue));
+	if (inRange == NULL) return MAP_NO_MEMORY;
+
+	int count = 0;
+	for (int i = 0; i < map->size; i++) {
+		MapKey current = map->elements[i].key;
+		if (mapKeyCompare(current, lo) >= 0 && mapKeyCompare(current, hi) <= 0) {
+			inRange[count++] = map->elements[i];
+		}
+	}
+
+	qsort(inRange, count, sizeof(KeyValue), compareKeyValues);
+
+	for (int i = 0; i < count; i++) {
+		visit(inRange[i].key, inRange[i].value, context);
+	}
+
+	free(inRange);
+
+	return MAP_OK;
+}
+
+int mapIterBegin(PtMap map, MapIterator *it) {
+	if (map == NULL || it == NULL) return MAP_NULL;
+
+	it->map = map;
+	it->position = NULL;
+	it->index = -1;
+
+	return MAP_OK;
+}
+
+bool mapIterNext(MapIterator *it) {
+	if (it == NULL || it->map == NULL) return false;
+
+	if (it->index < it->map->size) it->index++;
+
+	return it->index < it->map->size;
+}
+
+MapKey mapIterKey(const MapIterator *it) {
+	return it->map->elements[it->index].key;
+}
+
+MapValue mapIterValue(const MapIterator *it) {
+	return it->map->elements[it->index].value;
+}
+
+int mapForEach(PtMap map, MapVisitFn visit, void *context) {
+	if (map == NULL) return MAP_NULL;
+
+	for (int i = 0; i < map->size; i++) {
+		visit(map->elements[i].key, map->elements[i].value, context);
+	}
+
+	return MAP_OK;
+}
+
 int mapSize(PtMap map, int *ptSize) {
 	if (map == NULL) return MAP_NULL;
 	*ptSize = map->size;
@@ -184,11 +402,51 @@ int mapClear(PtMap map) {
 	if(map->capacity > INITIAL_CAPACITY) {
 		map->elements = (KeyValue*)realloc(map->elements, INITIAL_CAPACITY * sizeof(KeyValue));
 		map->capacity = INITIAL_CAPACITY;
+
+		ADT_STATS_REALLOC(map->stats, INITIAL_CAPACITY * sizeof(KeyValue));
+	}
+
+	return MAP_OK;
+}
+
+int mapClearRetain(PtMap map) {
+	if (map == NULL) return MAP_NULL;
+
+	map->size = 0;
+
+	return MAP_OK;
+}
+
+int mapReserve(PtMap map, int capacity) {
+	if (map == NULL) return MAP_NULL;
+
+	if (capacity > map->capacity && !resize(map, capacity)) {
+		return MAP_NO_MEMORY;
 	}
 
 	return MAP_OK;
 }
 
+int mapShrinkToFit(PtMap map) {
+	if (map == NULL) return MAP_NULL;
+
+	/* keep room for one mapping, so that the capacity can double */
+	int newCapacity = (map->size > 0) ? map->size : 1;
+
+	/* shrinking in place should not fail; if it does, keep the array */
+	if (newCapacity < map->capacity) resize(map, newCapacity);
+
+	return MAP_OK;
+}
+
+int mapStats(PtMap map, AdtStats *ptStats) {
+	if (map == NULL) return MAP_NULL;
+
+	ADT_STATS_COPY(map->stats, ptStats);
+
+	return MAP_OK;
+}
+
 void mapPrint(PtMap map) {
 	if (map == NULL) {
 		printf("(MAP NULL)\n");
@@ -0,0 +1,878 @@
+/**
+ * @file mapBTree.c
+ *
+ * @brief Provides an implementation of the ADT Map with a B-tree
+ * as the underlying data structure.
+ *
+ * Keys are kept ordered according to mapKeyCompare. Each node holds
+ * many keys in a contiguous array sized to a few cache lines, so
+ * the tree is shallow and the binary search within a node touches
+ * few cache lines. Lookups, insertions, removals, floor/ceiling
+ * queries are O(log n); ordered traversals are O(n).
+ *
+ * Insertion and removal follow the single-pass algorithms of
+ * Cormen et al., splitting full nodes on the way down (insertion) and
+ * ensuring a node has more than the minimum keys before descending
+ * into it (removal).
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "map.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+#define CACHE_LINE_SIZE 64
+
+/** Number of cache lines spanned by the keys of a node. */
+#define NODE_CACHE_LINES 2
+
+#define KEYS_PER_NODE_LINES (NODE_CACHE_LINES * CACHE_LINE_SIZE / sizeof(MapKey))
+
+/** Minimum degree: every node but the root holds [MIN_DEGREE - 1, MAX_KEYS] keys. */
+#define MIN_DEGREE ((int)(KEYS_PER_NODE_LINES / 2 > 2 ? KEYS_PER_NODE_LINES / 2 : 2))
+
+#define MAX_KEYS (2 * MIN_DEGREE - 1)
+
+struct node;
+typedef struct node* PtNode;
+
+typedef struct node {
+	int count;					/* number of keys in use */
+	bool leaf;
+	PtNode parent;				/* NULL for the root */
+	MapKey keys[MAX_KEYS];
+	MapValue values[MAX_KEYS];
+	PtNode children[];			/* MAX_KEYS + 1 entries, none for leaves */
+} Node;
+
+typedef struct mapImpl {
+	PtNode root;
+	int size;
+	ADT_STATS_MEMBER
+} MapImpl;
+
+/**
+ * @brief Auxiliary function to allocate a node.
+ *
+ * Leaves never have children, so their allocation
+ * omits the 'children' array.
+ *
+ * @param map [in] pointer to the map that will hold the node
+ * @param leaf [in] whether the node is a leaf
+ * @return PtNode pointer to allocated node, or
+ * @return NULL if unsufficient memory for allocation
+ */
+static PtNode nodeCreate(PtMap map, bool leaf) {
+	size_t bytes = sizeof(Node) + (leaf ? 0 : (MAX_KEYS + 1) * sizeof(PtNode));
+
+	PtNode node = (PtNode)malloc(bytes);
+	if (node == NULL) return NULL;
+
+	ADT_STATS_ALLOC(map->stats, bytes);
+
+	node->count = 0;
+	node->leaf = leaf;
+	node->parent = NULL;
+
+	return node;
+}
+
+static void nodeDestroyAll(PtNode node) {
+	if (!node->leaf) {
+		for (int i = 0; i <= node->count; i++) {
+			nodeDestroyAll(node->children[i]);
+		}
+	}
+	free(node);
+}
+
+/**
+ * @brief Auxiliary function to find the first position of a node
+ * whose key is not less than a specific key (binary search).
+ *
+ * @param node [in] node to search
+ * @param key [in] key to find
+ * @return index in [0, count]
+ */
+static int lowerBound(PtNode node, MapKey key) {
+	int lo = 0, hi = node->count;
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (mapKeyCompare(node->keys[mid], key) < 0) {
+			lo = mid + 1;
+		}
+		else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+/**
+ * @brief Auxiliary function to find the node and position of a specific key.
+ *
+ * @param map [in] pointer to the map
+ * @param key [in] key to find
+ * @param ptIndex [out] address of variable to hold the position of 'key'
+ * @return PtNode pointer of node containing 'key', or
+ * @return NULL if no node contains 'key'
+ */
+static PtNode findNodeOfKey(PtMap map, MapKey key, int *ptIndex) {
+	if (map == NULL) return NULL;
+
+	PtNode node = map->root;
+	int visited = 0;
+	while (true) {
+		int i = lowerBound(node, key);
+		visited++;
+		if (i < node->count && mapKeyCompare(node->keys[i], key) == 0) {
+			ADT_STATS_PROBES(map->stats, visited);
+			*ptIndex = i;
+			return node;
+		}
+		if (node->leaf) {
+			ADT_STATS_PROBES(map->stats, visited);
+			return NULL;
+		}
+
+		node = node->children[i];
+	}
+}
+
+static void shiftRight(PtNode node, int from) {
+	for (int i = node->count; i > from; i--) {
+		node->keys[i] = node->keys[i - 1];
+		node->values[i] = node->values[i - 1];
+	}
+	if (!node->leaf) {
+		for (int i = node->count + 1; i > from + 1; i--) {
+			node->children[i] = node->children[i - 1];
+		}
+	}
+}
+
+static void shiftLeft(PtNode node, int from) {
+	for (int i = from; i < node->count - 1; i++) {
+		node->keys[i] = node->keys[i + 1];
+		node->values[i] = node->values[i + 1];
+	}
+	if (!node->leaf) {
+		for (int i = from + 1; i < node->count; i++) {
+			node->children[i] = node->children[i + 1];
+		}
+	}
+}
+
+/**
+ * @brief Auxiliary function to split the full i-th child of a node.
+ *
+ * The median key of the child moves up into 'parent' at position 'i'
+ * and the upper half of the child moves to a new right sibling.
+ *
+ * @return 'true' if successful, or
+ * @return 'false' if unsufficient memory for allocation
+ */
+static bool splitChild(PtMap map, PtNode parent, int i) {
+	PtNode child = parent->children[i];
+	PtNode sibling = nodeCreate(map, child->leaf);
+	if (sibling == NULL) return false;
+
+	sibling->count = MIN_DEGREE - 1;
+	sibling->parent = parent;
+	for (int j = 0; j < MIN_DEGREE - 1; j++) {
+		sibling->keys[j] = child->keys[j + MIN_DEGREE];
+		sibling->values[j] = child->values[j + MIN_DEGREE];
+	}
+	if (!child->leaf) {
+		for (int j = 0; j < MIN_DEGREE; j++) {
+			sibling->children[j] = child->children[j + MIN_DEGREE];
+			sibling->children[j]->parent = sibling;
+		}
+	}
+	child->count = MIN_DEGREE - 1;
+
+	shiftRight(parent, i);
+	parent->keys[i] = child->keys[MIN_DEGREE - 1];
+	parent->values[i] = child->values[MIN_DEGREE - 1];
+	parent->children[i + 1] = sibling;
+	parent->count++;
+
+	return true;
+}
+
+/**
+ * @brief Auxiliary function to merge the i-th child of a node, the
+ * key at position 'i' and the (i+1)-th child into the i-th child.
+ *
+ * Both children must hold MIN_DEGREE - 1 keys.
+ */
+static void mergeChildren(PtNode parent, int i) {
+	PtNode left = parent->children[i];
+	PtNode right = parent->children[i + 1];
+
+	left->keys[left->count] = parent->keys[i];
+	left->values[left->count] = parent->values[i];
+
+	for (int j = 0; j < right->count; j++) {
+		left->keys[left->count + 1 + j] = right->keys[j];
+		left->values[left->count + 1 + j] = right->values[j];
+	}
+	if (!left->leaf) {
+		for (int j = 0; j <= right->count; j++) {
+			left->children[left->count + 1 + j] = right->children[j];
+			right->children[j]->parent = left;
+		}
+	}
+	left->count += right->count + 1;
+
+	shiftLeft(parent, i);
+	parent->count--;
+
+	free(right);
+}
+
+/**
+ * @brief Auxiliary function to move one key from the left sibling of
+ * the i-th child, through the parent, into that child.
+ */
+static void borrowFromLeft(PtNode parent, int i) {
+	PtNode child = parent->children[i];
+	PtNode sibling = parent->children[i - 1];
+
+	shiftRight(child, 0);
+	if (!child->leaf) {
+		child->children[1] = child->children[0];
+		child->children[0] = sibling->children[sibling->count];
+		child->children[0]->parent = child;
+	}
+	child->keys[0] = parent->keys[i - 1];
+	child->values[0] = parent->values[i - 1];
+	child->count++;
+
+	parent->keys[i - 1] = sibling->keys[sibling->count - 1];
+	parent->values[i - 1] = sibling->values[sibling->count - 1];
+	sibling->count--;
+}
+
+/**
+ * @brief Auxiliary function to move one key from the right sibling of
+ * the i-th child, through the parent, into that child.
+ */
+static void borrowFromRight(PtNode parent, int i) {
+	PtNode child = parent->children[i];
+	PtNode sibling = parent->children[i + 1];
+
+	child->keys[child->count] = parent->keys[i];
+	child->values[child->count] = parent->values[i];
+	if (!child->leaf) {
+		child->children[child->count + 1] = sibling->children[0];
+		child->children[child->count + 1]->parent = child;
+	}
+	child->count++;
+
+	parent->keys[i] = sibling->keys[0];
+	parent->values[i] = sibling->values[0];
+
+	if (!sibling->leaf) {
+		sibling->children[0] = sibling->children[1];
+	}
+	shiftLeft(sibling, 0);
+	sibling->count--;
+}
+
+/**
+ * @brief Auxiliary function to remove a key known to exist
+ * in the subtree rooted at 'node'.
+ *
+ * Unless 'node' is the root, it holds at least MIN_DEGREE keys.
+ */
+static void removeFromSubtree(PtNode node, MapKey key) {
+	int i = lowerBound(node, key);
+	bool found = (i < node->count && mapKeyCompare(node->keys[i], key) == 0);
+
+	if (found && node->leaf) {
+		shiftLeft(node, i);
+		node->count--;
+		return;
+	}
+
+	if (found) {
+		PtNode left = node->children[i];
+		PtNode right = node->children[i + 1];
+
+		if (left->count >= MIN_DEGREE) {
+			/* replace by predecessor and remove it from the left subtree */
+			PtNode pred = left;
+			while (!pred->leaf) pred = pred->children[pred->count];
+
+			node->keys[i] = pred->keys[pred->count - 1];
+			node->values[i] = pred->values[pred->count - 1];
+			removeFromSubtree(left, node->keys[i]);
+		}
+		else if (right->count >= MIN_DEGREE) {
+			/* replace by successor and remove it from the right subtree */
+			PtNode succ = right;
+			while (!succ->leaf) succ = succ->children[0];
+
+			node->keys[i] = succ->keys[0];
+			node->values[i] = succ->values[0];
+			removeFromSubtree(right, node->keys[i]);
+		}
+		else {
+			mergeChildren(node, i);
+			removeFromSubtree(left, key);
+		}
+		return;
+	}
+
+	if (node->leaf) return; /* not found */
+
+	/* key lies in the subtree of children[i]; make sure it can lose a key */
+	if (node->children[i]->count == MIN_DEGREE - 1) {
+		if (i > 0 && node->children[i - 1]->count >= MIN_DEGREE) {
+			borrowFromLeft(node, i);
+		}
+		else if (i < node->count && node->children[i + 1]->count >= MIN_DEGREE) {
+			borrowFromRight(node, i);
+		}
+		else if (i < node->count) {
+			mergeChildren(node, i);
+		}
+		else {
+			mergeChildren(node, i - 1);
+			i--;
+		}
+	}
+
+	removeFromSubtree(node->children[i], key);
+}
+
+/**
+ * @brief Auxiliary function to visit, in order, the mappings of a
+ * subtree whose keys lie in [lo, hi].
+ *
+ * @return 'false' once a key greater than 'hi' was found, or
+ * @return 'true' otherwise
+ */
+static bool visitRange(PtNode node, MapKey lo, MapKey hi, MapVisitFn visit, void *context) {
+	for (int i = lowerBound(node, lo); i <= node->count; i++) {
+		if (!node->leaf && !visitRange(node->children[i], lo, hi, visit, context)) {
+			return false;
+		}
+		if (i == node->count) break;
+
+		if (mapKeyCompare(node->keys[i], hi) > 0) return false;
+		visit(node->keys[i], node->values[i], context);
+	}
+	return true;
+}
+
+/**
+ * @brief Auxiliary function to copy, in order, the keys and/or values
+ * of a subtree into arrays, starting at position '*ptNext'.
+ */
+static void collectInOrder(PtNode node, MapKey *keys, MapValue *values, int *ptNext) {
+	for (int i = 0; i <= node->count; i++) {
+		if (!node->leaf) collectInOrder(node->children[i], keys, values, ptNext);
+		if (i == node->count) break;
+
+		if (keys != NULL) keys[*ptNext] = node->keys[i];
+		if (values != NULL) values[*ptNext] = node->values[i];
+		(*ptNext)++;
+	}
+}
+
+static void visitInOrder(PtNode node, MapVisitFn visit, void *context) {
+	for (int i = 0; i <= node->count; i++) {
+		if (!node->leaf) visitInOrder(node->children[i], visit, context);
+		if (i == node->count) break;
+
+		visit(node->keys[i], node->values[i], context);
+	}
+}
+
+static PtNode leftmostLeaf(PtNode node) {
+	while (!node->leaf) node = node->children[0];
+	return node;
+}
+
+static void printInOrder(PtNode node) {
+	for (int i = 0; i <= node->count; i++) {
+		if (!node->leaf) printInOrder(node->children[i]);
+		if (i == node->count) break;
+
+		mapKeyPrint(node->keys[i]);
+		printf(" : ");
+		mapValuePrint(node->values[i]);
+		printf("\n");
+	}
+}
+
+PtMap mapCreate() {
+	PtMap newMap = (PtMap)malloc(sizeof(MapImpl));
+	if (newMap == NULL) return NULL;
+
+	ADT_STATS_INIT(newMap->stats);
+	ADT_STATS_ALLOC(newMap->stats, sizeof(MapImpl));
+
+	newMap->root = nodeCreate(newMap, true);
+	if (newMap->root == NULL) {
+		free(newMap);
+		return NULL;
+	}
+
+	newMap->size = 0;
+
+	return newMap;
+}
+
+PtMap mapCreateWithCapacity(int capacity) {
+	if (capacity < 1) return NULL;
+
+	/* nodes are allocated as the tree grows */
+	return mapCreate();
+}
+
+int mapDestroy(PtMap *ptMap) {
+	PtMap map = *ptMap;
+
+	if (map == NULL) return MAP_NULL;
+
+	nodeDestroyAll(map->root);
+	free(map);
+
+	*ptMap = NULL;
+
+	return MAP_OK;
+}
+
+/**
+ * @brief Auxiliary function to find the node and position of a specific key,
+ * inserting a mapping to 'value' if the key doesn't exist. 
+ * 
+ * Full nodes met on the way down are split, so the leaf that
+ * receives a new key always has room for it.
+ * 
+ * @param map [in] pointer to the map
+ * @param key [in] key to find
+ * @param value [in] value to map to 'key' if it is inserted
+ * @param ptIndex [out] address of variable to hold the position of 'key'
+ * @param ptInserted [out] address of variable set to whether 'key' was inserted
+ * @return PtNode pointer of node containing 'key', or
+ * @return NULL if unsufficient memory for allocation
+ */
+static PtNode findOrInsertKey(PtMap map, MapKey key, MapValue value, int *ptIndex, bool *ptInserted) {
+	*ptInserted = false;
+
+	if (map->root->count == MAX_KEYS) {
+		/* grow the tree in height: the full root becomes the child of a new root */
+		PtNode newRoot = nodeCreate(map, false);
+		if (newRoot == NULL) return NULL;
+
+		newRoot->children[0] = map->root;
+		if (!splitChild(map, newRoot, 0)) {
+			free(newRoot);
+			return NULL;
+		}
+		map->root->parent = newRoot;
+		map->root = newRoot;
+	}
+
+	PtNode node = map->root;
+	int visited = 0;
+	while (true) {
+		int i = lowerBound(node, key);
+		visited++;
+		if (i < node->count && mapKeyCompare(node->keys[i], key) == 0) {
+			ADT_STATS_PROBES(map->stats, visited);
+			*ptIndex = i;
+			return node;
+		}
+
+		if (node->leaf) {
+			ADT_STATS_PROBES(map->stats, visited);
+
+			shiftRight(node, i);
+			node->keys[i] = key;
+			node->values[i] = value;
+			node->count++;
+
+			map->size++;
+
+			*ptIndex = i;
+			*ptInserted = true;
+			return node;
+		}
+
+		if (node->children[i]->count == MAX_KEYS) {
+			if (!splitChild(map, node, i)) return NULL;
+
+			int cmp = mapKeyCompare(key, node->keys[i]);
+			if (cmp == 0) {
+				ADT_STATS_PROBES(map->stats, visited);
+				*ptIndex = i;
+				return node;
+			}
+			if (cmp > 0) i++;
+		}
+
+		node = node->children[i];
+	}
+}
+
+int mapPut(PtMap map, MapKey key, MapValue value) {
+	if (map == NULL) return MAP_NULL;
+
+	ADT_STATS_START(start);
+
+	int index;
+	bool inserted;
+	PtNode node = findOrInsertKey(map, key, value, &index, &inserted);
+	if (node == NULL) return MAP_NO_MEMORY;
+
+	/* replace current value mapped to this key */
+	node->values[index] = value;
+
+	ADT_STATS_STOP(map->stats, ADT_OP_INSERT, start);
+
+	return MAP_OK;
+}
+
+int mapGetOrInsertPtr(PtMap map, MapKey key, MapValue defaultValue, MapValue **ptValue) {
+	if (map == NULL) return MAP_NULL;
+
+	ADT_STATS_START(start);
+
+	int index;
+	bool inserted;
+	PtNode node = findOrInsertKey(map, key, defaultValue, &index, &inserted);
+	if (node == NULL) return MAP_NO_MEMORY;
+
+	*ptValue = &node->values[index];
+
+	ADT_STATS_STOP(map->stats, ADT_OP_INSERT, start);
+
+	return MAP_OK;
+}
+
+int mapMerge(PtMap map, MapKey key, MapValue value, MapCombineFn combine) {
+	if (map == NULL) return MAP_NULL;
+
+	ADT_STATS_START(start);
+
+	int index;
+	bool inserted;
+	PtNode node = findOrInsertKey(map, key, value, &index, &inserted);
+	if (node == NULL) return MAP_NO_MEMORY;
+
+	if (!inserted) {
+		node->values[index] = combine(node->values[index], value);
+	}
+
+	ADT_STATS_STOP(map->stats, ADT_OP_INSERT, start);
+
+	return MAP_OK;
+}
+
+int mapRemove(PtMap map, MapKey key, MapValue *ptValue) {
+	if (map == NULL) return MAP_NULL;
+	if (map->size == 0) return MAP_EMPTY;
+
+	ADT_STATS_START(start);
+
+	int index;
+	PtNode node = findNodeOfKey(map, key, &index);
+	if (node == NULL) return MAP_UNKNOWN_KEY;
+
+	*ptValue = node->values[index];
+
+	removeFromSubtree(map->root, key);
+
+	/* shrink the tree in height if the root was emptied by a merge */
+	if (map->root->count == 0 && !map->root->leaf) {
+		PtNode oldRoot = map->root;
+		map->root = oldRoot->children[0];
+		map->root->parent = NULL;
+		free(oldRoot);
+	}
+
+	map->size--;
+
+	ADT_STATS_STOP(map->stats, ADT_OP_REMOVE, start);
+
+	return MAP_OK;
+}
+
+bool mapContains(PtMap map, MapKey key) {
+	if (map == NULL) return false;
+
+	ADT_STATS_START(start);
+
+	int index;
+	bool found = findNodeOfKey(map, key, &index) != NULL;
+
+	ADT_STATS_STOP(map->stats, ADT_OP_LOOKUP, start);
+
+	return found;
+}
+
+int mapGet(PtMap map, MapKey key, MapValue *ptValue) {
+	if (map == NULL) return MAP_NULL;
+	if (map->size == 0) return MAP_EMPTY;
+
+	ADT_STATS_START(start);
+
+	int index;
+	PtNode node = findNodeOfKey(map, key, &index);
+	if (node == NULL) return MAP_UNKNOWN_KEY;
+
+	*ptValue = node->values[index];
+
+	ADT_STATS_STOP(map->stats, ADT_OP_LOOKUP, start);
+
+	return MAP_OK;
+}
+
+MapKey* mapKeys(PtMap map) {
+	if (map == NULL || map->size == 0) return NULL;
+
+	MapKey *keys = (MapKey*)calloc(map->size, sizeof(MapKey));
+	if (keys == NULL) return NULL;
+
+	int next = 0;
+	collectInOrder(map->root, keys, NULL, &next);
+
+	return keys;
+}
+
+MapValue* mapValues(PtMap map) {
+	if (map == NULL || map->size == 0) return NULL;
+
+	MapValue *values = (MapValue*)calloc(map->size, sizeof(MapValue));
+	if (values == NULL) return NULL;
+
+	int next = 0;
+	collectInOrder(map->root, NULL, values, &next);
+
+	return values;
+}
+
+MapKey* mapKeysSorted(PtMap map) {
+	/* in-order traversal already yields ascending keys */
+	return mapKeys(map);
+}
+
+int mapFloor(PtMap map, MapKey key, MapKey *ptFloorKey) {
+	if (map == NULL) return MAP_NULL;
+	if (map->size == 0) return MAP_EMPTY;
+
+	bool found = false;
+	PtNode node = map->root;
+	while (true) {
+		int i = lowerBound(node, key);
+		if (i < node->count && mapKeyCompare(node->keys[i], key) == 0) {
+			*ptFloorKey = node->keys[i];
+			return MAP_OK;
+		}
+		if (i > 0) {
+			/* best candidate so far; deeper ones are greater */
+			*ptFloorKey = node->keys[i - 1];
+			found = true;
+		}
+		if (node->leaf) break;
+
+		node = node->children[i];
+	}
+
+	return found ? MAP_OK : MAP_UNKNOWN_KEY;
+}
+
+int mapCeiling(PtMap map, MapKey key, MapKey *ptCeilingKey) {
+	if (map == NULL) return MAP_NULL;
+	if (map->size == 0) return MAP_EMPTY;
+
+	bool found = false;
+	PtNode node = map->root;
+	while (true) {
+		int i = lowerBound(node, key);
+		if (i < node->count) {
+			/* best candidate so far; deeper ones are smaller */
+			*ptCeilingKey = node->keys[i];
+			found = true;
+
+			if (mapKeyCompare(node->keys[i], key) == 0) return MAP_OK;
+		}
+		if (node->leaf) break;
+
+		node = node->children[i];
+	}
+
+	return found ? MAP_OK : MAP_UNKNOWN_KEY;
+}
+
+int mapRange(PtMap map, MapKey lo, MapKey hi, MapVisitFn visit, void *context) {
+	if (map == NULL) return MAP_NULL;
+
+	visitRange(map->root, lo, hi, visit, context);
+
+	return MAP_OK;
+}
+
+int mapIterBegin(PtMap map, MapIterator *it) {
+	if (map == NULL || it == NULL) return MAP_NULL;
+
+	/* 'position' NULL with 'index' -1: before the first mapping */
+	it->map = map;
+	it->position = NULL;
+	it->index = -1;
+
+	return MAP_OK;
+}
+
+bool mapIterNext(MapIterator *it) {
+	if (it == NULL || it->map == NULL) return false;
+
+	PtNode node = (PtNode)it->position;
+	int i = it->index;
+
+	if (node == NULL) {
+		if (i != -1) return false; /* past the last mapping */
+
+		node = leftmostLeaf(it->map->root);
+		i = 0;
+		if (node->count == 0) node = NULL;
+	}
+	else if (!node->leaf) {
+		/* successor is the least key of the right subtree */
+		node = leftmostLeaf(node->children[i + 1]);
+		i = 0;
+	}
+	else if (i + 1 < node->count) {
+		i++;
+	}
+	else {
+		/* climb until coming up from a child that has a key to its right */
+		while (true) {
+			PtNode parent = node->parent;
+			if (parent == NULL) {
+				node = NULL;
+				break;
+			}
+
+			int j = 0;
+			while (parent->children[j] != node) j++;
+
+			node = parent;
+			if (j < parent->count) {
+				i = j;
+				break;
+			}
+		}
+	}
+
+	if (node == NULL) {
+		it->position = NULL;
+		it->index = 0;
+		return false;
+	}
+
+	it->position = node;
+	it->index = i;
+	return true;
+}
+
+MapKey mapIterKey(const MapIterator *it) {
+	return ((PtNode)it->position)->keys[it->index];
+}
+
+MapValue mapIterValue(const MapIterator *it) {
+	return ((PtNode)it->position)->values[it->index];
+}
+
+int mapForEach(PtMap map, MapVisitFn visit, void *context) {
+	if (map == NULL) return MAP_NULL;
+
+	visitInOrder(map->root, visit, context);
+
+	return MAP_OK;
+}
+
+int mapSize(PtMap map, int *ptSize) {
+	if (map == NULL) return MAP_NULL;
+	*ptSize = map->size;
+	return MAP_OK;
+}
+
+bool mapIsEmpty(PtMap map) {
+	if (map == NULL) return true;
+	return (map->size == 0);
+}
+
+int mapClear(PtMap map) {
+	if (map == NULL) return MAP_NULL;
+
+	PtNode emptyRoot = nodeCreate(map, true);
+	if (emptyRoot == NULL) return MAP_NO_MEMORY;
+
+	nodeDestroyAll(map->root);
+	map->root = emptyRoot;
+	map->size = 0;
+
+	return MAP_OK;
+}
+
+int mapClearRetain(PtMap map) {
+	if (map == NULL) return MAP_NULL;
+
+	/* the root becomes an empty leaf, so no allocation is needed */
+	PtNode root = map->root;
+	if (!root->leaf) {
+		for (int i = 0; i <= root->count; i++) {
+			nodeDestroyAll(root->children[i]);
+		}
+	}
+	root->count = 0;
+	root->leaf = true;
+
+	map->size = 0;
+
+	return MAP_OK;
+}
+
+int mapReserve(PtMap map, int capacity) {
+	if (map == NULL) return MAP_NULL;
+
+	(void)capacity; /* nodes are allocated as the tree grows */
+
+	return MAP_OK;
+}
+
+int mapShrinkToFit(PtMap map) {
+	if (map == NULL) return MAP_NULL;
+
+	/* every node but the root is at least half full after removals */
+	return MAP_OK;
+}
+
+int mapStats(PtMap map, AdtStats *ptStats) {
+	if (map == NULL) return MAP_NULL;
+
+	ADT_STATS_COPY(map->stats, ptStats);
+
+	return MAP_OK;
+}
+
+void mapPrint(PtMap map) {
+	if (map == NULL) {
+		printf("(MAP NULL)\n");
+	}
+	else if (mapIsEmpty(map)) {
+		printf("(MAP EMPTY)\n");
+	}
+	else {
+		printf("Map contents(<key> : <value>): \n");
+		printInOrder(map->root);
+	}
+}
@@ -0,0 +1,59 @@
+/**
+ * @file mapConcurrent.h
+ * @brief Additional operations of the thread-safe implementation
+ * of the ADT Map.
+ *
+ * This implementation (mapSharded.c) provides all operations of map.h
+ * over MAP_SHARDS open-addressing hash tables (shards), each guarded
+ * by its own lock. A key always belongs to the same shard, chosen by
+ * its hash code, so threads working on keys of different shards do not
+ * wait for each other, and every single-key operation (mapPut, mapGet,
+ * mapRemove, mapContains, mapMerge, mapMergeAndGet) is atomic. In
+ * particular, mapMerge is an atomic upsert, e.g., to count occurrences
+ * from several threads.
+ *
+ * The size of each shard is kept by the shard itself (striped), so
+ * mapSize and mapIsEmpty take no lock and only return a snapshot while
+ * other threads add or remove mappings.
+ *
+ * mapKeys, mapValues, mapKeysSorted, mapFloor, mapCeiling, mapRange,
+ * mapClear, mapClearRetain and mapPrint lock all shards (in order), so
+ * they see, or act on, a consistent state of the whole map. mapForEach
+ * locks one shard at a time, while visiting its mappings, so 'visit'
+ * must not call operations of the same map.
+ *
+ * The pointer given by mapGetOrInsertPtr is only valid until other
+ * mappings are added to or removed from the map: when threads share
+ * the map, use mapMerge or mapMergeAndGet instead. Iterators and
+ * mapDestroy must not run concurrently with any other operation on
+ * the same map.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#pragma once
+
+#include "map.h"
+
+/** Number of shards of each map, e.g., 'make stress-sharded SHARDS=1' for a single lock. */
+#ifndef MAP_SHARDS
+#define MAP_SHARDS 64
+#endif
+
+/**
+ * @brief Maps a key to a value combined with the current one, or
+ * to the value itself if the key is new, and retrieves the result,
+ * atomically.
+ *
+ * @param map [in] pointer to the map
+ * @param key [in] key
+ * @param value [in] value to merge
+ * @param combine [in] function combining the current value with 'value'
+ * @param ptResult [out] address of variable to hold the value now mapped to 'key'
+ *
+ * @return MAP_OK if successful, or
+ * @return MAP_NO_MEMORY if unsufficient memory for allocation, or
+ * @return MAP_NULL if 'map' is NULL
+ */
+int mapMergeAndGet(PtMap map, MapKey key, MapValue value, MapCombineFn combine, MapValue *ptResult);
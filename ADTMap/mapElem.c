@@ -18,6 +18,17 @@ void mapValuePrint(MapValue value) {
 }
 
 int mapKeyCompare(MapKey key1, MapKey key2) {
-	// in case of integer keys:
-	return (key1 - key2); 
+	// in case of integer keys (a plain subtraction could overflow):
+	return (key1 > key2) - (key1 < key2);
+}
+
+unsigned int mapKeyHash(MapKey key) {
+	// in case of integer keys (finalizer of MurmurHash3):
+	unsigned int hash = (unsigned int)key;
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6b;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35;
+	hash ^= hash >> 16;
+	return hash;
 }
\ No newline at end of file
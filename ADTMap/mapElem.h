@@ -58,3 +58,14 @@ void mapValuePrint(MapValue value);
  */
 int mapKeyCompare(MapKey key1, MapKey key2);
 
+/**
+ * @brief Computes the hash code of a key.
+ * 
+ * Must be implemented according to the concrete
+ * type of MapKey. Keys that are equal according to 
+ * mapKeyCompare must produce the same hash code.
+ * 
+ * @param key [in] key to hash
+ * @return hash code of 'key'
+ */
+unsigned int mapKeyHash(MapKey key);
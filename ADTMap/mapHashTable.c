@@ -0,0 +1,608 @@
+/**
+ * @file mapHashTable.c
+ *
+ * @brief Provides an implementation of the ADT Map with an
+ * open-addressing hash table (Robin Hood hashing) as the
+ * underlying data structure.
+ *
+ * Keys are placed by their hash code (mapKeyHash) and collisions
+ * are resolved by linear probing. On insertion, an entry that is
+ * farther from its home slot than the resident entry takes that slot
+ * ("robs the rich"), which keeps probe sequences short and allows
+ * lookups to stop early. Removals use backward-shift deletion,
+ * so no tombstones are needed.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "map.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+/** Must be a power of two, so that 'hash & (capacity - 1)' selects a slot. */
+#define INITIAL_CAPACITY 16
+
+/** Marks a slot that holds no entry. */
+#define EMPTY_SLOT -1
+
+typedef struct keyValue {
+	MapKey key;
+	MapValue value;
+} KeyValue;
+
+typedef struct slot {
+	KeyValue element;
+	unsigned int hash;	/* cached hash code of the key */
+	int distance;		/* distance from home slot, or EMPTY_SLOT */
+} Slot;
+
+typedef struct mapImpl {
+	Slot *slots;
+	int capacity;
+	int size;
+	ADT_STATS_MEMBER
+} MapImpl;
+
+/**
+ * @brief Auxiliary function to find the slot of a specific key.
+ *
+ * Keys are compared by using mapKeyCompare function. The probe
+ * stops as soon as it reaches an empty slot or an entry closer to its
+ * home slot than 'key' would be, since 'key' would have displaced it.
+ *
+ * @param map [in] pointer to the map
+ * @param key [in] key to find
+ * @return index of 'slots' containing 'key', or
+ * @return -1 if no slot contains 'key'
+ */
+static int findSlotOfKey(PtMap map, MapKey key) {
+	if (map == NULL) return -1;
+
+	unsigned int hash = mapKeyHash(key);
+	int mask = map->capacity - 1;
+	int index = hash & mask;
+
+	for (int distance = 0; ; distance++) {
+		Slot *slot = &map->slots[index];
+
+		if (slot->distance == EMPTY_SLOT || slot->distance < distance) {
+			ADT_STATS_PROBES(map->stats, distance + 1);
+			return -1;
+		}
+		if (slot->hash == hash && mapKeyCompare(slot->element.key, key) == 0) {
+			ADT_STATS_PROBES(map->stats, distance + 1);
+			return index;
+		}
+
+		index = (index + 1) & mask;
+	}
+}
+
+/**
+ * @brief Auxiliary function to place an entry whose key is known
+ * not to exist in the table.
+ *
+ * The table must have at least one empty slot.
+ *
+ * @param slots [in] array of slots
+ * @param capacity [in] number of slots (power of two)
+ * @param element [in] key-value pair to place
+ * @param hash [in] hash code of the key
+ * @return index of the slot where 'element' was placed
+ */
+static int placeEntry(Slot *slots, int capacity, KeyValue element, unsigned int hash) {
+	int mask = capacity - 1;
+	int index = hash & mask;
+	int placedAt = -1;
+
+	Slot incoming = { element, hash, 0 };
+
+	while (true) {
+		Slot *slot = &slots[index];
+
+		if (slot->distance == EMPTY_SLOT) {
+			*slot = incoming;
+			return (placedAt == -1) ? index : placedAt;
+		}
+
+		if (slot->distance < incoming.distance) {
+			/* take from the rich: swap and keep placing the evicted entry */
+			Slot evicted = *slot;
+			*slot = incoming;
+			incoming = evicted;
+
+			if (placedAt == -1) placedAt = index;
+		}
+
+		index = (index + 1) & mask;
+		incoming.distance++;
+	}
+}
+
+/**
+ * @brief Auxiliary comparison function of keys, for use with qsort.
+ */
+static int compareKeys(const void *key1, const void *key2) {
+	return mapKeyCompare(*(const MapKey*)key1, *(const MapKey*)key2);
+}
+
+/**
+ * @brief Auxiliary comparison function of key-value pairs by key, 
+ * for use with qsort.
+ */
+static int compareKeyValues(const void *kv1, const void *kv2) {
+	return mapKeyCompare(((const KeyValue*)kv1)->key, ((const KeyValue*)kv2)->key);
+}
+
+static bool rehash(PtMap map, int newCapacity) {
+	Slot *newSlots = (Slot*)malloc(newCapacity * sizeof(Slot));
+	if (newSlots == NULL) return false;
+
+	for (int i = 0; i < newCapacity; i++) {
+		newSlots[i].distance = EMPTY_SLOT;
+	}
+
+	for (int i = 0; i < map->capacity; i++) {
+		Slot *slot = &map->slots[i];
+		if (slot->distance != EMPTY_SLOT) {
+			placeEntry(newSlots, newCapacity, slot->element, slot->hash);
+		}
+	}
+
+	free(map->slots);
+	map->slots = newSlots;
+	map->capacity = newCapacity;
+
+	ADT_STATS_REALLOC(map->stats, newCapacity * sizeof(Slot));
+
+	return true;
+}
+
+static bool ensureCapacity(PtMap map) {
+	/* keep load factor at or below 7/8 */
+	if ((map->size + 1) * 8 > map->capacity * 7) {
+		return rehash(map, map->capacity * 2);
+	}
+
+	return true;
+}
+
+/** Smallest number of slots (a power of two) that holds 'count' entries. */
+static int slotsFor(int count) {
+	int slots = 1;
+	while (count * 8 > slots * 7) slots *= 2;
+	return slots;
+}
+
+static void markAllEmpty(Slot *slots, int capacity) {
+	for (int i = 0; i < capacity; i++) {
+		slots[i].distance = EMPTY_SLOT;
+	}
+}
+
+static PtMap createWithSlots(int capacity) {
+	PtMap newMap = (PtMap)malloc(sizeof(MapImpl));
+	if (newMap == NULL) return NULL;
+
+	newMap->slots = (Slot*)malloc(capacity * sizeof(Slot));
+	if (newMap->slots == NULL) {
+		free(newMap);
+		return NULL;
+	}
+	markAllEmpty(newMap->slots, capacity);
+
+	newMap->size = 0;
+	newMap->capacity = capacity;
+
+	ADT_STATS_INIT(newMap->stats);
+	ADT_STATS_ALLOC(newMap->stats, sizeof(MapImpl) + capacity * sizeof(Slot));
+
+	return newMap;
+}
+
+PtMap mapCreate() {
+	return createWithSlots(INITIAL_CAPACITY);
+}
+
+PtMap mapCreateWithCapacity(int capacity) {
+	if (capacity < 1) return NULL;
+
+	return createWithSlots(slotsFor(capacity));
+}
+
+int mapDestroy(PtMap *ptMap) {
+	PtMap map = *ptMap;
+
+	if (map == NULL) return MAP_NULL;
+
+	free(map->slots);
+	free(map);
+
+	*ptMap = NULL;
+
+	return MAP_OK;
+}
+
+/**
+ * @brief Auxiliary function to find the slot of a specific key,
+ * placing a mapping to 'value' if the key doesn't exist. 
+ * 
+ * @param map [in] pointer to the map
+ * @param key [in] key to find
+ * @param value [in] value to map to 'key' if it is placed
+ * @param ptInserted [out] address of variable set to whether 'key' was placed
+ * @return index of 'slots' containing 'key', or
+ * @return -1 if unsufficient memory for allocation
+ */
+static int findOrInsertKey(PtMap map, MapKey key, MapValue value, bool *ptInserted) {
+	int index = findSlotOfKey(map, key);
+	*ptInserted = (index == -1);
+	if (index != -1) return index;
+
+	if (!ensureCapacity(map)) return -1;
+
+	KeyValue tuple = {key, value};
+	index = placeEntry(map->slots, map->capacity, tuple, mapKeyHash(key));
+	map->size++;
+
+	return index;
+}
+
+int mapPut(PtMap map, MapKey key, MapValue value) {
+	if (map == NULL) return MAP_NULL;
+
+	ADT_STATS_START(start);
+
+	bool inserted;
+	int index = findOrInsertKey(map, key, value, &inserted);
+	if (index == -1) return MAP_NO_MEMORY;
+
+	map->slots[index].element.value = value;
+
+	ADT_STATS_STOP(map->stats, ADT_OP_INSERT, start);
+
+	return MAP_OK;
+}
+
+int mapGetOrInsertPtr(PtMap map, MapKey key, MapValue defaultValue, MapValue **ptValue) {
+	if (map == NULL) return MAP_NULL;
+
+	ADT_STATS_START(start);
+
+	bool inserted;
+	int index = findOrInsertKey(map, key, defaultValue, &inserted);
+	if (index == -1) return MAP_NO_MEMORY;
+
+	*ptValue = &map->slots[index].element.value;
+
+	ADT_STATS_STOP(map->stats, ADT_OP_INSERT, start);
+
+	return MAP_OK;
+}
+
+int mapMerge(PtMap map, MapKey key, MapValue value, MapCombineFn combine) {
+	if (map == NULL) return MAP_NULL;
+
+	ADT_STATS_START(start);
+
+	bool inserted;
+	int index = findOrInsertKey(map, key, value, &inserted);
+	if (index == -1) return MAP_NO_MEMORY;
+
+	if (!inserted) {
+		Slot *slot = &map->slots[index];
+		slot->element.value = combine(slot->element.value, value);
+	}
+
+	ADT_STATS_STOP(map->stats, ADT_OP_INSERT, start);
+
+	return MAP_OK;
+}
+
+int mapRemove(PtMap map, MapKey key, MapValue *ptValue) {
+	if (map == NULL) return MAP_NULL;
+	if (map->size == 0) return MAP_EMPTY;
+
+	ADT_STATS_START(start);
+
+	int index = findSlotOfKey(map, key);
+	if (index == -1) return MAP_UNKNOWN_KEY;
+
+	*ptValue = map->slots[index].element.value;
+
+	/* backward-shift the following displaced entries one slot closer to home */
+	int mask = map->capacity - 1;
+	int next = (index + 1) & mask;
+	while (map->slots[next].distance > 0) {
+		map->slots[index] = map->slots[next];
+		map->slots[index].distance--;
+
+		index = next;
+		next = (next + 1) & mask;
+	}
+	map->slots[index].distance = EMPTY_SLOT;
+
+	map->size--;
+
+	ADT_STATS_STOP(map->stats, ADT_OP_REMOVE, start);
+
+	return MAP_OK;
+}
+
+bool mapContains(PtMap map, MapKey key) {
+	if (map == NULL) return false;
+
+	ADT_STATS_START(start);
+
+	bool found = findSlotOfKey(map, key) != -1;
+
+	ADT_STATS_STOP(map->stats, ADT_OP_LOOKUP, start);
+
+	return found;
+}
+
+int mapGet(PtMap map, MapKey key, MapValue *ptValue) {
+	if (map == NULL) return MAP_NULL;
+	if (map->size == 0) return MAP_EMPTY;
+
+	ADT_STATS_START(start);
+
+	int index = findSlotOfKey(map, key);
+	if (index == -1) return MAP_UNKNOWN_KEY;
+
+	*ptValue = map->slots[index].element.value;
+
+	ADT_STATS_STOP(map->stats, ADT_OP_LOOKUP, start);
+
+	return MAP_OK;
+}
+
+MapKey* mapKeys(PtMap map) {
+	if (map == NULL || map->size == 0) return NULL;
+
+	MapKey *keys = (MapKey*)calloc(map->size, sizeof(MapKey));
+	if (keys == NULL) return NULL;
+
+	int k = 0;
+	for (int i = 0; i < map->capacity; i++) {
+		if (map->slots[i].distance != EMPTY_SLOT) {
+			keys[k++] = map->slots[i].element.key;
+		}
+	}
+
+	return keys;
+}
+
+MapValue* mapValues(PtMap map) {
+	if (map == NULL || map->size == 0) return NULL;
+
+	MapValue *values = (MapValue*)calloc(map->size, sizeof(MapValue));
+	if (values == NULL) return NULL;
+
+	int k = 0;
+	for (int i = 0; i < map->capacity; i++) {
+		if (map->slots[i].distance != EMPTY_SLOT) {
+			values[k++] = map->slots[i].element.value;
+		}
+	}
+
+	return values;
+}
+
+MapKey* mapKeysSorted(PtMap map) {
+	MapKey *keys = mapKeys(map);
+	if (keys == NULL) return NULL;
+
+	qsort(keys, map->size, sizeof(MapKey), compareKeys);
+
+	return keys;
+}
+
+int mapFloor(PtMap map, MapKey key, MapKey *ptFloorKey) {
+	if (map == NULL) return MAP_NULL;
+	if (map->size == 0) return MAP_EMPTY;
+
+	/* hashing does not preserve order: keep the greatest key not above 'key' */
+	int best = -1;
+	for (int i = 0; i < map->capacity; i++) {
+		if (map->slots[i].distance == EMPTY_SLOT) continue;
+
+		MapKey current = map->slots[i].element.key;
+		if (mapKeyCompare(current, key) <= 0 &&
+			(best == -1 || mapKeyCompare(current, map->slots[best].element.key) > 0)) {
+			best = i;
+		}
+	}
+	if (best == -1) return MAP_UNKNOWN_KEY;
+
+	*ptFloorKey = map->slots[best].element.key;
+
+	return MAP_OK;
+}
+
+int mapCeiling(PtMap map, MapKey key, MapKey *ptCeilingKey) {
+	if (map == NULL) return MAP_NULL;
+	if (map->size == 0) return MAP_EMPTY;
+
+	/* hashing does not preserve order: keep the least key not below 'key' */
+	int best = -1;
+	for (int i = 0; i < map->capacity; i++) {
+		if (map->slots[i].distance == EMPTY_SLOT) continue;
+
+		MapKey current = map->slots[i].element.key;
+		if (mapKeyCompare(current, key) >= 0 &&
+			(best == -1 || mapKeyCompare(current, map->slots[best].element.key) < 0)) {
+			best = i;
+		}
+	}
+	if (best == -1) return MAP_UNKNOWN_KEY;
+
+	*ptCeilingKey = map->slots[best].element.key;
+
+	return MAP_OK;
+}
+
+int mapRange(PtMap map, MapKey lo, MapKey hi, MapVisitFn visit, void *context) {
+	if (map == NULL) return MAP_NULL;
+	if (map->size == 0) return MAP_OK;
+
+	/* gather the mappings in range and sort them by key */
+	KeyValue *inRange = (KeyValue*)malloc(map->size * sizeof(KeyValue));
+	if (inRange == NULL) return MAP_NO_MEMORY;
+
+	int count = 0;
+	for (int i = 0; i < map->capacity; i++) {
+		if (map->slots[i].distance == EMPTY_SLOT) continue;
+
+		MapKey current = map->slots[i].element.key;
+		if (mapKeyCompare(current, lo) >= 0 && mapKeyCompare(current, hi) <= 0) {
+			inRange[count++] = map->slots[i].element;
+		}
+	}
+
+	qsort(inRange, count, sizeof(KeyValue), compareKeyValues);
+
+	for (int i = 0; i < count; i++) {
+		visit(inRange[i].key, inRange[i].value, context);
+	}
+
+	free(inRange);
+
+	return MAP_OK;
+}
+
+int mapIterBegin(PtMap map, MapIterator *it) {
+	if (map == NULL || it == NULL) return MAP_NULL;
+
+	it->map = map;
+	it->position = NULL;
+	it->index = -1;
+
+	return MAP_OK;
+}
+
+bool mapIterNext(MapIterator *it) {
+	if (it == NULL || it->map == NULL) return false;
+
+	PtMap map = it->map;
+	do {
+		it->index++;
+	} while (it->index < map->capacity && map->slots[it->index].distance == EMPTY_SLOT);
+
+	if (it->index >= map->capacity) {
+		it->index = map->capacity;
+		return false;
+	}
+	return true;
+}
+
+MapKey mapIterKey(const MapIterator *it) {
+	return it->map->slots[it->index].element.key;
+}
+
+MapValue mapIterValue(const MapIterator *it) {
+	return it->map->slots[it->index].element.value;
+}
+
+int mapForEach(PtMap map, MapVisitFn visit, void *context) {
+	if (map == NULL) return MAP_NULL;
+
+	for (int i = 0; i < map->capacity; i++) {
+		if (map->slots[i].distance == EMPTY_SLOT) continue;
+
+		visit(map->slots[i].element.key, map->slots[i].element.value, context);
+	}
+
+	return MAP_OK;
+}
+
+int mapSize(PtMap map, int *ptSize) {
+	if (map == NULL) return MAP_NULL;
+	*ptSize = map->size;
+	return MAP_OK;
+}
+
+bool mapIsEmpty(PtMap map) {
+	if (map == NULL) return true;
+	return (map->size == 0);
+}
+
+int mapClear(PtMap map) {
+	if (map == NULL) return MAP_NULL;
+	map->size = 0;
+
+	// Housekeeping. Table can be very large at this point, realloc to initial size
+	if (map->capacity > INITIAL_CAPACITY) {
+		Slot *newSlots = (Slot*)realloc(map->slots, INITIAL_CAPACITY * sizeof(Slot));
+		if (newSlots != NULL) {
+			map->slots = newSlots;
+			map->capacity = INITIAL_CAPACITY;
+
+			ADT_STATS_REALLOC(map->stats, INITIAL_CAPACITY * sizeof(Slot));
+		}
+	}
+	markAllEmpty(map->slots, map->capacity);
+
+	return MAP_OK;
+}
+
+int mapClearRetain(PtMap map) {
+	if (map == NULL) return MAP_NULL;
+
+	map->size = 0;
+	markAllEmpty(map->slots, map->capacity);
+
+	return MAP_OK;
+}
+
+int mapReserve(PtMap map, int capacity) {
+	if (map == NULL) return MAP_NULL;
+
+	int newCapacity = slotsFor(capacity);
+	if (newCapacity > map->capacity && !rehash(map, newCapacity)) {
+		return MAP_NO_MEMORY;
+	}
+
+	return MAP_OK;
+}
+
+int mapShrinkToFit(PtMap map) {
+	if (map == NULL) return MAP_NULL;
+
+	/* keep room for one entry, as placing needs an empty slot */
+	int newCapacity = slotsFor(map->size > 0 ? map->size : 1);
+
+	/* on failure, keep the larger table */
+	if (newCapacity < map->capacity) rehash(map, newCapacity);
+
+	return MAP_OK;
+}
+
+int mapStats(PtMap map, AdtStats *ptStats) {
+	if (map == NULL) return MAP_NULL;
+
+	ADT_STATS_COPY(map->stats, ptStats);
+
+	return MAP_OK;
+}
+
+void mapPrint(PtMap map) {
+	if (map == NULL) {
+		printf("(MAP NULL)\n");
+	}
+	else if (mapIsEmpty(map)) {
+		printf("(MAP EMPTY)\n");
+	}
+	else {
+		printf("Map contents(<key> : <value>): \n");
+		for (int i = 0; i < map->capacity; i++) {
+			if (map->slots[i].distance == EMPTY_SLOT) continue;
+
+			mapKeyPrint(map->slots[i].element.key);
+			printf(" : ");
+			mapValuePrint(map->slots[i].element.value);
+			printf("\n");
+		}
+	}
+}
@@ -10,6 +10,7 @@
  */
 
 #include "map.h"
+#include "nodePool.h"
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -32,6 +33,8 @@ typedef struct mapImpl {
 	PtNode header;
     PtNode trailer;
 	int size;
+	PtNodePool pool;	/* allocator of the element nodes */
+	ADT_STATS_MEMBER
 } MapImpl;
 
 /**
@@ -48,16 +51,36 @@ PtNode findNodeOfKey(PtMap map, MapKey key) {
 	if (map == NULL) return NULL;
 
 	PtNode current = map->header->next;
+	int visited = 0;
 	while(current != map->trailer) {
+		visited++;
 		if (mapKeyCompare(current->element.key, key) == 0) {
+			ADT_STATS_PROBES(map->stats, visited);
 			return current;
 		}
 
 		current = current->next;
 	}
+
+	ADT_STATS_PROBES(map->stats, visited);
 	return NULL;
 }
 
+/**
+ * @brief Auxiliary comparison function of keys, for use with qsort.
+ */
+static int compareKeys(const void *key1, const void *key2) {
+	return mapKeyCompare(*(const MapKey*)key1, *(const MapKey*)key2);
+}
+
+/**
+ * @brief Auxiliary comparison function of key-value pairs by key, 
+ * for use with qsort.
+ */
+static int compareKeyValues(const void *kv1, const void *kv2) {
+	return mapKeyCompare(((const KeyValue*)kv1)->key, ((const KeyValue*)kv2)->key);
+}
+
 PtMap mapCreate() {
 	PtMap map = (PtMap)malloc(sizeof(MapImpl));
 	if (map == NULL) return NULL;
@@ -74,6 +97,14 @@ PtMap mapCreate() {
 		return NULL;
 	}
 
+	map->pool = nodePoolCreate(sizeof(Node));
+	if (map->pool == NULL) {
+		free(map->trailer);
+		free(map->header);
+		free(map);
+		return NULL;
+	}
+
 	map->header->prev = NULL;
 	map->header->next = map->trailer;
 
@@ -82,6 +113,23 @@ PtMap mapCreate() {
 
 	map->size = 0;
 
+	ADT_STATS_INIT(map->stats);
+	ADT_STATS_ALLOC(map->stats, sizeof(MapImpl) + 2 * sizeof(Node));
+
+	return map;
+}
+
+PtMap mapCreateWithCapacity(int capacity) {
+	if (capacity < 1) return NULL;
+
+	PtMap map = mapCreate();
+	if (map == NULL) return NULL;
+
+	if (mapReserve(map, capacity) != MAP_OK) {
+		mapDestroy(&map);
+		return NULL;
+	}
+
 	return map;
 }
 
@@ -90,11 +138,8 @@ int mapDestroy(PtMap *ptMap) {
 
 	if (map == NULL) return MAP_NULL;
 
-	PtNode current = map->header->next;
-    while(current != map->trailer) {
-        current = current->next;
-        free(current->prev);
-    }
+	/* element nodes are released with their pool */
+	nodePoolDestroy(&map->pool);
 
 	free(map->header);
 	free(map->trailer);
@@ -105,41 +150,97 @@ int mapDestroy(PtMap *ptMap) {
 	return MAP_OK;
 }
 
+/**
+ * @brief Auxiliary function to find the node of a specific key,
+ * adding a node mapping it to 'value' if the key doesn't exist. 
+ * 
+ * @param map [in] pointer to the map
+ * @param key [in] key to find
+ * @param value [in] value to map to 'key' if a node is added
+ * @param ptInserted [out] address of variable set to whether a node was added
+ * @return PtNode pointer of node containing 'key', or
+ * @return NULL if unsufficient memory for allocation
+ */
+static PtNode findOrInsertNodeOfKey(PtMap map, MapKey key, MapValue value, bool *ptInserted) {
+	PtNode node = findNodeOfKey(map, key);
+	*ptInserted = (node == NULL);
+	if (node != NULL) return node;
+
+	/* allocate new node and place it at the beggining of the list */
+	PtNode newNode = (PtNode)nodePoolAlloc(map->pool);
+	if(newNode == NULL) return NULL;
+
+	KeyValue tuple = {key, value};
+
+	newNode->element = tuple;
+	newNode->next = map->header->next;
+	newNode->prev = map->header;
+
+	map->header->next->prev = newNode;
+	map->header->next = newNode;
+
+	map->size++;
+
+	return newNode;
+}
+
 int mapPut(PtMap map, MapKey key, MapValue value) {
 	if (map == NULL) return MAP_NULL;
 
-	PtNode node = findNodeOfKey(map, key);
-	if (node != NULL) {
-		
-		/* replace current value mapped to this key */
-		node->element.value = value;
+	ADT_STATS_START(start);
 
-		return MAP_OK;
-	}
-	else {
-		/* allocate new node and place it at the beggining of the list */
-		PtNode newNode = (PtNode)malloc(sizeof(Node));
-		if(newNode == NULL) return MAP_NO_MEMORY;
+	bool inserted;
+	PtNode node = findOrInsertNodeOfKey(map, key, value, &inserted);
+	if (node == NULL) return MAP_NO_MEMORY;
+
+	/* replace current value mapped to this key */
+	node->element.value = value;
+
+	ADT_STATS_STOP(map->stats, ADT_OP_INSERT, start);
+
+	return MAP_OK;
+}
 
-		KeyValue tuple = {key, value};
-		
-		newNode->element = tuple;
-		newNode->next = map->header->next;
-		newNode->prev = map->header;
+int mapGetOrInsertPtr(PtMap map, MapKey key, MapValue defaultValue, MapValue **ptValue) {
+	if (map == NULL) return MAP_NULL;
+
+	ADT_STATS_START(start);
+
+	bool inserted;
+	PtNode node = findOrInsertNodeOfKey(map, key, defaultValue, &inserted);
+	if (node == NULL) return MAP_NO_MEMORY;
 
-		map->header->next->prev = newNode;
-		map->header->next = newNode;
+	*ptValue = &node->element.value;
 
-		map->size++;
+	ADT_STATS_STOP(map->stats, ADT_OP_INSERT, start);
+
+	return MAP_OK;
+}
 
-		return MAP_OK;
+int mapMerge(PtMap map, MapKey key, MapValue value, MapCombineFn combine) {
+	if (map == NULL) return MAP_NULL;
+
+	ADT_STATS_START(start);
+
+	bool inserted;
+	PtNode node = findOrInsertNodeOfKey(map, key, value, &inserted);
+	if (node == NULL) return MAP_NO_MEMORY;
+
+	if (!inserted) {
+		node->element.value = combine(node->element.value, value);
 	}
+
+	ADT_STATS_STOP(map->stats, ADT_OP_INSERT, start);
+
+	return MAP_OK;
 }
 
 int mapRemove(PtMap map, MapKey key, MapValue *ptValue) {
 	if (map == NULL) return MAP_NULL;
 	if (map->size == 0) return MAP_EMPTY;
 
+	ADT_STATS_START(start);
+
 	PtNode node = findNodeOfKey(map, key);
 	if (node == NULL) return MAP_UNKNOWN_KEY;
 
@@ -152,28 +253,40 @@ int mapRemove(PtMap map, MapKey key, MapValue *ptValue) {
 	previous->next = next;
 	next->prev = previous;
 
-	free(node); /* free the node to remove */
+	nodePoolFree(map->pool, node); /* free the node to remove */
 
 	map->size--;
 	
+	ADT_STATS_STOP(map->stats, ADT_OP_REMOVE, start);
+
 	return MAP_OK;
 }
 
 bool mapContains(PtMap map, MapKey key) {
 	if (map == NULL) return false;
 
-	return findNodeOfKey(map, key) != NULL;
+	ADT_STATS_START(start);
+
+	bool found = findNodeOfKey(map, key) != NULL;
+
+	ADT_STATS_STOP(map->stats, ADT_OP_LOOKUP, start);
+
+	return found;
 }
 
 int mapGet(PtMap map, MapKey key, MapValue *ptValue) {
 	if (map == NULL) return MAP_NULL;
 	if (map->size == 0) return MAP_EMPTY;
 
+	ADT_STATS_START(start);
+
 	PtNode node = findNodeOfKey(map, key);
 	if (node == NULL) return MAP_UNKNOWN_KEY;
 
 	*ptValue = node->element.value;
 	
+	ADT_STATS_STOP(map->stats, ADT_OP_LOOKUP, start);
+
 	return MAP_OK;
 }
 
@@ -211,6 +324,134 @@ MapValue* mapValues(PtMap map) {
 	return values;
 }
 
+MapKey* mapKeysSorted(PtMap map) {
+	if (map == NULL || map->size == 0) return NULL;
+
+	MapKey *keys = mapKeys(map);
+	if (keys == NULL) return NULL;
+
+	qsort(keys, map->size, sizeof(MapKey), compareKeys);
+
+	return keys;
+}
+
+int mapFloor(PtMap map, MapKey key, MapKey *ptFloorKey) {
+	if (map == NULL) return MAP_NULL;
+	if (map->size == 0) return MAP_EMPTY;
+
+	/* list is unordered: keep the greatest key not above 'key' */
+	PtNode best = NULL;
+	PtNode current = map->header->next;
+	while (current != map->trailer) {
+		if (mapKeyCompare(current->element.key, key) <= 0 &&
+			(best == NULL || mapKeyCompare(current->element.key, best->element.key) > 0)) {
+			best = current;
+		}
+
+		current = current->next;
+	}
+	if (best == NULL) return MAP_UNKNOWN_KEY;
+
+	*ptFloorKey = best->element.key;
+
+	return MAP_OK;
+}
+
+int mapCeiling(PtMap map, MapKey key, MapKey *ptCeilingKey) {
+	if (map == NULL) return MAP_NULL;
+	if (map->size == 0) return MAP_EMPTY;
+
+	/* list is unordered: keep the least key not below 'key' */
+	PtNode best = NULL;
+	PtNode current = map->header->next;
+	while (current != map->trailer) {
+		if (mapKeyCompare(current->element.key, key) >= 0 &&
+			(best == NULL || mapKeyCompare(current->element.key, best->element.key) < 0)) {
+			best = current;
+		}
+
+		current = current->next;
+	}
+	if (best == NULL) return MAP_UNKNOWN_KEY;
+
+	*ptCeilingKey = best->element.key;
+
+	return MAP_OK;
+}
+
+int mapRange(PtMap map, MapKey lo, MapKey hi, MapVisitFn visit, void *context) {
+	if (map == NULL) return MAP_NULL;
+	if (map->size == 0) return MAP_OK;
+
+	/* gather the mappings in range and sort them by key */
+	KeyValue *inRange = (KeyValue*)malloc(map->size * sizeof(KeyValue));
+	if (inRange == NULL) return MAP_NO_MEMORY;
+
+	int count = 0;
+	PtNode current = map->header->next;
+	while (current != map->trailer) {
+		if (mapKeyCompare(current->element.key, lo) >= 0 && 
+			mapKeyCompare(current->element.key, hi) <= 0) {
+			inRange[count++] = current->element;
+		}
+
+		current = current->next;
+	}
+
+	qsort(inRange, count, sizeof(KeyValue), compareKeyValues);
+
+	for (int i = 0; i < count; i++) {
+		visit(inRange[i].key, inRange[i].value, context);
+	}
+
+	free(inRange);
+
+	return MAP_OK;
+}
+
+int mapIterBegin(PtMap map, MapIterator *it) {
+	if (map == NULL || it == NULL) return MAP_NULL;
+
+	it->map = map;
+	it->position = map->header;
+	it->index = -1;
+
+	return MAP_OK;
+}
+
+bool mapIterNext(MapIterator *it) {
+	if (it == NULL || it->map == NULL) return false;
+
+	PtNode current = (PtNode)it->position;
+	if (current != it->map->trailer) {
+		it->position = current->next;
+		it->index++;
+	}
+
+	return it->position != it->map->trailer;
+}
+
+MapKey mapIterKey(const MapIterator *it) {
+	return ((PtNode)it->position)->element.key;
+}
+
+MapValue mapIterValue(const MapIterator *it) {
+	return ((PtNode)it->position)->element.value;
+}
+
+int mapForEach(PtMap map, MapVisitFn visit, void *context) {
+	if (map == NULL) return MAP_NULL;
+
+	PtNode current = map->header->next;
+	while (current != map->trailer) {
+		visit(current->element.key, current->element.value, context);
+
+		current = current->next;
+	}
+
+	return MAP_OK;
+}
+
 int mapSize(PtMap map, int *ptSize) {
 	if (map == NULL) return MAP_NULL;
 
@@ -228,11 +469,8 @@ bool mapIsEmpty(PtMap map) {
 int mapClear(PtMap map) {
 	if (map == NULL) return MAP_NULL;
 
-	PtNode current = map->header->next;
-    while(current != map->trailer) {
-        current = current->next;
-        free(current->prev);
-    }
+	/* release all element nodes at once */
+	nodePoolReset(map->pool);
 
 	/* empty state of linked list */
     map->header->next = map->trailer;
@@ -242,6 +480,58 @@ int mapClear(PtMap map) {
 	return MAP_OK;
 }
 
+int mapClearRetain(PtMap map) {
+	if (map == NULL) return MAP_NULL;
+
+	/* return the nodes to the pool, which keeps their memory */
+	PtNode current = map->header->next;
+	while (current != map->trailer) {
+		PtNode next = current->next;
+		nodePoolFree(map->pool, current);
+		current = next;
+	}
+
+	map->header->next = map->trailer;
+	map->trailer->prev = map->header;
+
+	map->size = 0;
+	return MAP_OK;
+}
+
+int mapReserve(PtMap map, int capacity) {
+	if (map == NULL) return MAP_NULL;
+
+	if (capacity > map->size &&
+		nodePoolReserve(map->pool, capacity - map->size) != NODEPOOL_OK) {
+		return MAP_NO_MEMORY;
+	}
+
+	return MAP_OK;
+}
+
+int mapShrinkToFit(PtMap map) {
+	if (map == NULL) return MAP_NULL;
+
+	/* nodes in use may be spread over all chunks of the pool,
+	   so memory can only be released when there are none */
+	if (map->size == 0) nodePoolReset(map->pool);
+
+	return MAP_OK;
+}
+
+int mapStats(PtMap map, AdtStats *ptStats) {
+	if (map == NULL) return MAP_NULL;
+
+	ADT_STATS_COPY(map->stats, ptStats);
+
+	/* the nodes of the mappings are allocated by the pool */
+	if (ptStats->enabled) {
+		ptStats->bytesAllocated += nodePoolBytesAllocated(map->pool);
+	}
+
+	return MAP_OK;
+}
+
 void mapPrint(PtMap map) {
 	if (map == NULL) {
 		printf("(Map NULL)");
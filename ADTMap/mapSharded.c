@@ -0,0 +1,836 @@
+/**
+ * @file mapSharded.c
+ *
+ * @brief Provides a thread-safe implementation of the ADT Map with
+ * MAP_SHARDS open-addressing hash tables (Robin Hood hashing, as in
+ * mapHashTable.c), each guarded by its own mutex.
+ *
+ * The shard of a key is chosen by the high bits of its scrambled hash
+ * code, while the slot within the shard is chosen by the low bits, so
+ * that both are spread independently. Each shard takes a cache line of
+ * its own (or more), so threads working on different shards do not
+ * invalidate each other's caches. See mapConcurrent.h for the semantics
+ * of each operation under concurrency.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "mapConcurrent.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#define CACHE_LINE_SIZE 64
+
+/** Must be a power of two, so that 'hash & (capacity - 1)' selects a slot. */
+#define INITIAL_CAPACITY 16
+
+/** Marks a slot that holds no entry. */
+#define EMPTY_SLOT -1
+
+typedef struct keyValue {
+	MapKey key;
+	MapValue value;
+} KeyValue;
+
+typedef struct slot {
+	KeyValue element;
+	unsigned int hash;	/* cached hash code of the key */
+	int distance;		/* distance from home slot, or EMPTY_SLOT */
+} Slot;
+
+typedef struct shard {
+	_Alignas(CACHE_LINE_SIZE) pthread_mutex_t lock;
+	Slot *slots;
+	int capacity;
+	atomic_int size;	/* written under 'lock', read by mapSize without it */
+	ADT_STATS_MEMBER
+} Shard;
+
+typedef struct mapImpl {
+	Shard shards[MAP_SHARDS];
+} MapImpl;
+
+/** Shard of a hash code: multiplies it by 2^32 / golden ratio and takes the high bits. */
+static Shard* shardOf(PtMap map, unsigned int hash) {
+	uint32_t scrambled = hash * 2654435769u;
+	return &map->shards[((uint64_t)scrambled * MAP_SHARDS) >> 32];
+}
+
+static int shardSize(Shard *shard) {
+	return atomic_load_explicit(&shard->size, memory_order_relaxed);
+}
+
+static void setShardSize(Shard *shard, int size) {
+	atomic_store_explicit(&shard->size, size, memory_order_relaxed);
+}
+
+static void lockAll(PtMap map) {
+	for (int s = 0; s < MAP_SHARDS; s++) {
+		pthread_mutex_lock(&map->shards[s].lock);
+	}
+}
+
+static void unlockAll(PtMap map) {
+	for (int s = MAP_SHARDS - 1; s >= 0; s--) {
+		pthread_mutex_unlock(&map->shards[s].lock);
+	}
+}
+
+/** Number of mappings of a map whose shards are all locked. */
+static int lockedSize(PtMap map) {
+	int size = 0;
+	for (int s = 0; s < MAP_SHARDS; s++) {
+		size += shardSize(&map->shards[s]);
+	}
+	return size;
+}
+
+/**
+ * @brief Auxiliary function to find the slot of a specific key
+ * in a shard, as in mapHashTable.c.
+ *
+ * @param shard [in] pointer to the (locked) shard
+ * @param key [in] key to find
+ * @param hash [in] hash code of 'key'
+ * @return index of 'slots' containing 'key', or
+ * @return -1 if no slot contains 'key'
+ */
+static int findSlotOfKey(Shard *shard, MapKey key, unsigned int hash) {
+	int mask = shard->capacity - 1;
+	int index = hash & mask;
+
+	for (int distance = 0; ; distance++) {
+		Slot *slot = &shard->slots[index];
+
+		if (slot->distance == EMPTY_SLOT || slot->distance < distance) {
+			ADT_STATS_PROBES(shard->stats, distance + 1);
+			return -1;
+		}
+		if (slot->hash == hash && mapKeyCompare(slot->element.key, key) == 0) {
+			ADT_STATS_PROBES(shard->stats, distance + 1);
+			return index;
+		}
+
+		index = (index + 1) & mask;
+	}
+}
+
+/**
+ * @brief Auxiliary function to place an entry whose key is known
+ * not to exist in the table, as in mapHashTable.c.
+ *
+ * The table must have at least one empty slot.
+ *
+ * @return index of the slot where 'element' was placed
+ */
+static int placeEntry(Slot *slots, int capacity, KeyValue element, unsigned int hash) {
+	int mask = capacity - 1;
+	int index = hash & mask;
+	int placedAt = -1;
+
+	Slot incoming = { element, hash, 0 };
+
+	while (true) {
+		Slot *slot = &slots[index];
+
+		if (slot->distance == EMPTY_SLOT) {
+			*slot = incoming;
+			return (placedAt == -1) ? index : placedAt;
+		}
+
+		if (slot->distance < incoming.distance) {
+			/* take from the rich: swap and keep placing the evicted entry */
+			Slot evicted = *slot;
+			*slot = incoming;
+			incoming = evicted;
+
+			if (placedAt == -1) placedAt = index;
+		}
+
+		index = (index + 1) & mask;
+		incoming.distance++;
+	}
+}
+
+/**
+ * @brief Auxiliary comparison function of keys, for use with qsort.
+ */
+static int compareKeys(const void *key1, const void *key2) {
+	return mapKeyCompare(*(const MapKey*)key1, *(const MapKey*)key2);
+}
+
+/**
+ * @brief Auxiliary comparison function of key-value pairs by key,
+ * for use with qsort.
+ */
+static int compareKeyValues(const void *kv1, const void *kv2) {
+	return mapKeyCompare(((const KeyValue*)kv1)->key, ((const KeyValue*)kv2)->key);
+}
+
+static void markAllEmpty(Slot *slots, int capacity) {
+	for (int i = 0; i < capacity; i++) {
+		slots[i].distance = EMPTY_SLOT;
+	}
+}
+
+static bool rehash(Shard *shard, int newCapacity) {
+	Slot *newSlots = (Slot*)malloc(newCapacity * sizeof(Slot));
+	if (newSlots == NULL) return false;
+
+	markAllEmpty(newSlots, newCapacity);
+
+	for (int i = 0; i < shard->capacity; i++) {
+		Slot *slot = &shard->slots[i];
+		if (slot->distance != EMPTY_SLOT) {
+			placeEntry(newSlots, newCapacity, slot->element, slot->hash);
+		}
+	}
+
+	free(shard->slots);
+	shard->slots = newSlots;
+	shard->capacity = newCapacity;
+
+	ADT_STATS_REALLOC(shard->stats, newCapacity * sizeof(Slot));
+
+	return true;
+}
+
+static bool ensureCapacity(Shard *shard) {
+	/* keep load factor at or below 7/8 */
+	if ((shardSize(shard) + 1) * 8 > shard->capacity * 7) {
+		return rehash(shard, shard->capacity * 2);
+	}
+
+	return true;
+}
+
+/** Smallest number of slots (a power of two) that holds 'count' entries. */
+static int slotsFor(int count) {
+	int slots = 1;
+	while (count * 8 > slots * 7) slots *= 2;
+	return slots;
+}
+
+/** Number of slots of each shard for a map of 'capacity' mappings. */
+static int shardSlotsFor(int capacity) {
+	return slotsFor((capacity + MAP_SHARDS - 1) / MAP_SHARDS);
+}
+
+/**
+ * @brief Auxiliary function to find the slot of a specific key
+ * in a shard, placing a mapping to 'value' if the key doesn't exist.
+ *
+ * @param shard [in] pointer to the (locked) shard
+ * @param key [in] key to find
+ * @param hash [in] hash code of 'key'
+ * @param value [in] value to map to 'key' if it is placed
+ * @param ptInserted [out] address of variable set to whether 'key' was placed
+ * @return index of 'slots' containing 'key', or
+ * @return -1 if unsufficient memory for allocation
+ */
+static int findOrInsertKey(Shard *shard, MapKey key, unsigned int hash, MapValue value, bool *ptInserted) {
+	int index = findSlotOfKey(shard, key, hash);
+	*ptInserted = (index == -1);
+	if (index != -1) return index;
+
+	if (!ensureCapacity(shard)) return -1;
+
+	KeyValue tuple = {key, value};
+	index = placeEntry(shard->slots, shard->capacity, tuple, hash);
+	setShardSize(shard, shardSize(shard) + 1);
+
+	return index;
+}
+
+static PtMap createWithSlots(int capacity) {
+	PtMap newMap = (PtMap)aligned_alloc(CACHE_LINE_SIZE, sizeof(MapImpl));
+	if (newMap == NULL) return NULL;
+
+	for (int s = 0; s < MAP_SHARDS; s++) {
+		Shard *shard = &newMap->shards[s];
+
+		shard->slots = (Slot*)malloc(capacity * sizeof(Slot));
+		if (shard->slots == NULL) {
+			for (int other = 0; other < s; other++) {
+				free(newMap->shards[other].slots);
+				pthread_mutex_destroy(&newMap->shards[other].lock);
+			}
+			free(newMap);
+			return NULL;
+		}
+		markAllEmpty(shard->slots, capacity);
+
+		pthread_mutex_init(&shard->lock, NULL);
+		shard->capacity = capacity;
+		atomic_init(&shard->size, 0);
+
+		ADT_STATS_INIT(shard->stats);
+		ADT_STATS_ALLOC(shard->stats, sizeof(Shard) + capacity * sizeof(Slot));
+	}
+
+	return newMap;
+}
+
+PtMap mapCreate() {
+	return createWithSlots(INITIAL_CAPACITY);
+}
+
+PtMap mapCreateWithCapacity(int capacity) {
+	if (capacity < 1) return NULL;
+
+	return createWithSlots(shardSlotsFor(capacity));
+}
+
+int mapDestroy(PtMap *ptMap) {
+	PtMap map = *ptMap;
+
+	if (map == NULL) return MAP_NULL;
+
+	for (int s = 0; s < MAP_SHARDS; s++) {
+		free(map->shards[s].slots);
+		pthread_mutex_destroy(&map->shards[s].lock);
+	}
+	free(map);
+
+	*ptMap = NULL;
+
+	return MAP_OK;
+}
+
+int mapPut(PtMap map, MapKey key, MapValue value) {
+	if (map == NULL) return MAP_NULL;
+
+	unsigned int hash = mapKeyHash(key);
+	Shard *shard = shardOf(map, hash);
+
+	ADT_STATS_START(start);
+	pthread_mutex_lock(&shard->lock);
+
+	bool inserted;
+	int index = findOrInsertKey(shard, key, hash, value, &inserted);
+	if (index == -1) {
+		pthread_mutex_unlock(&shard->lock);
+		return MAP_NO_MEMORY;
+	}
+
+	shard->slots[index].element.value = value;
+
+	ADT_STATS_STOP(shard->stats, ADT_OP_INSERT, start);
+	pthread_mutex_unlock(&shard->lock);
+
+	return MAP_OK;
+}
+
+int mapGetOrInsertPtr(PtMap map, MapKey key, MapValue defaultValue, MapValue **ptValue) {
+	if (map == NULL) return MAP_NULL;
+
+	unsigned int hash = mapKeyHash(key);
+	Shard *shard = shardOf(map, hash);
+
+	ADT_STATS_START(start);
+	pthread_mutex_lock(&shard->lock);
+
+	bool inserted;
+	int index = findOrInsertKey(shard, key, hash, defaultValue, &inserted);
+	if (index == -1) {
+		pthread_mutex_unlock(&shard->lock);
+		return MAP_NO_MEMORY;
+	}
+
+	*ptValue = &shard->slots[index].element.value;
+
+	ADT_STATS_STOP(shard->stats, ADT_OP_INSERT, start);
+	pthread_mutex_unlock(&shard->lock);
+
+	return MAP_OK;
+}
+
+int mapMergeAndGet(PtMap map, MapKey key, MapValue value, MapCombineFn combine, MapValue *ptResult) {
+	if (map == NULL) return MAP_NULL;
+
+	unsigned int hash = mapKeyHash(key);
+	Shard *shard = shardOf(map, hash);
+
+	ADT_STATS_START(start);
+	pthread_mutex_lock(&shard->lock);
+
+	bool inserted;
+	int index = findOrInsertKey(shard, key, hash, value, &inserted);
+	if (index == -1) {
+		pthread_mutex_unlock(&shard->lock);
+		return MAP_NO_MEMORY;
+	}
+
+	Slot *slot = &shard->slots[index];
+	if (!inserted) {
+		slot->element.value = combine(slot->element.value, value);
+	}
+	*ptResult = slot->element.value;
+
+	ADT_STATS_STOP(shard->stats, ADT_OP_INSERT, start);
+	pthread_mutex_unlock(&shard->lock);
+
+	return MAP_OK;
+}
+
+int mapMerge(PtMap map, MapKey key, MapValue value, MapCombineFn combine) {
+	MapValue result;
+	return mapMergeAndGet(map, key, value, combine, &result);
+}
+
+int mapRemove(PtMap map, MapKey key, MapValue *ptValue) {
+	if (map == NULL) return MAP_NULL;
+
+	unsigned int hash = mapKeyHash(key);
+	Shard *shard = shardOf(map, hash);
+
+	ADT_STATS_START(start);
+	pthread_mutex_lock(&shard->lock);
+
+	int index = findSlotOfKey(shard, key, hash);
+	if (index == -1) {
+		pthread_mutex_unlock(&shard->lock);
+		return mapIsEmpty(map) ? MAP_EMPTY : MAP_UNKNOWN_KEY;
+	}
+
+	*ptValue = shard->slots[index].element.value;
+
+	/* backward-shift the following displaced entries one slot closer to home */
+	int mask = shard->capacity - 1;
+	int next = (index + 1) & mask;
+	while (shard->slots[next].distance > 0) {
+		shard->slots[index] = shard->slots[next];
+		shard->slots[index].distance--;
+
+		index = next;
+		next = (next + 1) & mask;
+	}
+	shard->slots[index].distance = EMPTY_SLOT;
+
+	setShardSize(shard, shardSize(shard) - 1);
+
+	ADT_STATS_STOP(shard->stats, ADT_OP_REMOVE, start);
+	pthread_mutex_unlock(&shard->lock);
+
+	return MAP_OK;
+}
+
+bool mapContains(PtMap map, MapKey key) {
+	if (map == NULL) return false;
+
+	unsigned int hash = mapKeyHash(key);
+	Shard *shard = shardOf(map, hash);
+
+	ADT_STATS_START(start);
+	pthread_mutex_lock(&shard->lock);
+
+	bool found = findSlotOfKey(shard, key, hash) != -1;
+
+	ADT_STATS_STOP(shard->stats, ADT_OP_LOOKUP, start);
+	pthread_mutex_unlock(&shard->lock);
+
+	return found;
+}
+
+int mapGet(PtMap map, MapKey key, MapValue *ptValue) {
+	if (map == NULL) return MAP_NULL;
+
+	unsigned int hash = mapKeyHash(key);
+	Shard *shard = shardOf(map, hash);
+
+	ADT_STATS_START(start);
+	pthread_mutex_lock(&shard->lock);
+
+	int index = findSlotOfKey(shard, key, hash);
+	if (index == -1) {
+		pthread_mutex_unlock(&shard->lock);
+		return mapIsEmpty(map) ? MAP_EMPTY : MAP_UNKNOWN_KEY;
+	}
+
+	*ptValue = shard->slots[index].element.value;
+
+	ADT_STATS_STOP(shard->stats, ADT_OP_LOOKUP, start);
+	pthread_mutex_unlock(&shard->lock);
+
+	return MAP_OK;
+}
+
+/**
+ * @brief Auxiliary function to gather the mappings of a map, all
+ * shards locked, whose keys lie in [lo, hi] (or all, if 'all').
+ *
+ * @return number of mappings copied to 'out'
+ */
+static int gatherLocked(PtMap map, bool all, MapKey lo, MapKey hi, KeyValue *out) {
+	int count = 0;
+
+	for (int s = 0; s < MAP_SHARDS; s++) {
+		Shard *shard = &map->shards[s];
+
+		for (int i = 0; i < shard->capacity; i++) {
+			if (shard->slots[i].distance == EMPTY_SLOT) continue;
+
+			MapKey current = shard->slots[i].element.key;
+			if (all || (mapKeyCompare(current, lo) >= 0 && mapKeyCompare(current, hi) <= 0)) {
+				out[count++] = shard->slots[i].element;
+			}
+		}
+	}
+
+	return count;
+}
+
+/** Copies all mappings to an allocated array, with their number in '*ptSize'; NULL if empty. */
+static KeyValue* snapshot(PtMap map, int *ptSize) {
+	lockAll(map);
+
+	int size = lockedSize(map);
+	KeyValue *elements = (size > 0) ? (KeyValue*)malloc(size * sizeof(KeyValue)) : NULL;
+	if (elements != NULL) {
+		gatherLocked(map, true, 0, 0, elements);
+	}
+
+	unlockAll(map);
+
+	*ptSize = size;
+	return elements;
+}
+
+MapKey* mapKeys(PtMap map) {
+	if (map == NULL) return NULL;
+
+	int size;
+	KeyValue *elements = snapshot(map, &size);
+	if (elements == NULL) return NULL;
+
+	MapKey *keys = (MapKey*)calloc(size, sizeof(MapKey));
+	if (keys != NULL) {
+		for (int i = 0; i < size; i++) keys[i] = elements[i].key;
+	}
+
+	free(elements);
+	return keys;
+}
+
+MapValue* mapValues(PtMap map) {
+	if (map == NULL) return NULL;
+
+	int size;
+	KeyValue *elements = snapshot(map, &size);
+	if (elements == NULL) return NULL;
+
+	MapValue *values = (MapValue*)calloc(size, sizeof(MapValue));
+	if (values != NULL) {
+		for (int i = 0; i < size; i++) values[i] = elements[i].value;
+	}
+
+	free(elements);
+	return values;
+}
+
+MapKey* mapKeysSorted(PtMap map) {
+	if (map == NULL) return NULL;
+
+	int size;
+	KeyValue *elements = snapshot(map, &size);
+	if (elements == NULL) return NULL;
+
+	MapKey *keys = (MapKey*)calloc(size, sizeof(MapKey));
+	if (keys != NULL) {
+		for (int i = 0; i < size; i++) keys[i] = elements[i].key;
+		qsort(keys, size, sizeof(MapKey), compareKeys);
+	}
+
+	free(elements);
+	return keys;
+}
+
+/**
+ * @brief Auxiliary function to find the greatest key not above 'key'
+ * (if 'floor') or the least key not below 'key' (otherwise).
+ */
+static int findBound(PtMap map, MapKey key, bool floor, MapKey *ptBound) {
+	if (map == NULL) return MAP_NULL;
+
+	lockAll(map);
+
+	int rc = (lockedSize(map) == 0) ? MAP_EMPTY : MAP_UNKNOWN_KEY;
+	int sign = floor ? 1 : -1;
+
+	/* hashing does not preserve order: keep the best key of every shard */
+	for (int s = 0; s < MAP_SHARDS; s++) {
+		Shard *shard = &map->shards[s];
+
+		for (int i = 0; i < shard->capacity; i++) {
+			if (shard->slots[i].distance == EMPTY_SLOT) continue;
+
+			MapKey current = shard->slots[i].element.key;
+			if (sign * mapKeyCompare(current, key) <= 0 &&
+				(rc != MAP_OK || sign * mapKeyCompare(current, *ptBound) > 0)) {
+				*ptBound = current;
+				rc = MAP_OK;
+			}
+		}
+	}
+
+	unlockAll(map);
+
+	return rc;
+}
+
+int mapFloor(PtMap map, MapKey key, MapKey *ptFloorKey) {
+	return findBound(map, key, true, ptFloorKey);
+}
+
+int mapCeiling(PtMap map, MapKey key, MapKey *ptCeilingKey) {
+	return findBound(map, key, false, ptCeilingKey);
+}
+
+int mapRange(PtMap map, MapKey lo, MapKey hi, MapVisitFn visit, void *context) {
+	if (map == NULL) return MAP_NULL;
+
+	lockAll(map);
+
+	int size = lockedSize(map);
+	if (size == 0) {
+		unlockAll(map);
+		return MAP_OK;
+	}
+
+	/* gather the mappings in range, then sort and visit them without locks */
+	KeyValue *inRange = (KeyValue*)malloc(size * sizeof(KeyValue));
+	if (inRange == NULL) {
+		unlockAll(map);
+		return MAP_NO_MEMORY;
+	}
+
+	int count = gatherLocked(map, false, lo, hi, inRange);
+
+	unlockAll(map);
+
+	qsort(inRange, count, sizeof(KeyValue), compareKeyValues);
+
+	for (int i = 0; i < count; i++) {
+		visit(inRange[i].key, inRange[i].value, context);
+	}
+
+	free(inRange);
+
+	return MAP_OK;
+}
+
+int mapIterBegin(PtMap map, MapIterator *it) {
+	if (map == NULL || it == NULL) return MAP_NULL;
+
+	it->map = map;
+	it->position = &map->shards[0];
+	it->index = -1;
+
+	return MAP_OK;
+}
+
+bool mapIterNext(MapIterator *it) {
+	if (it == NULL || it->map == NULL) return false;
+
+	Shard *shard = (Shard*)it->position;
+	Shard *end = &it->map->shards[MAP_SHARDS];
+
+	while (shard != end) {
+		do {
+			it->index++;
+		} while (it->index < shard->capacity && shard->slots[it->index].distance == EMPTY_SLOT);
+
+		if (it->index < shard->capacity) {
+			it->position = shard;
+			return true;
+		}
+
+		shard++;
+		it->index = -1;
+	}
+
+	it->position = end;
+	return false;
+}
+
+MapKey mapIterKey(const MapIterator *it) {
+	return ((Shard*)it->position)->slots[it->index].element.key;
+}
+
+MapValue mapIterValue(const MapIterator *it) {
+	return ((Shard*)it->position)->slots[it->index].element.value;
+}
+
+int mapForEach(PtMap map, MapVisitFn visit, void *context) {
+	if (map == NULL) return MAP_NULL;
+
+	for (int s = 0; s < MAP_SHARDS; s++) {
+		Shard *shard = &map->shards[s];
+
+		pthread_mutex_lock(&shard->lock);
+
+		for (int i = 0; i < shard->capacity; i++) {
+			if (shard->slots[i].distance == EMPTY_SLOT) continue;
+
+			visit(shard->slots[i].element.key, shard->slots[i].element.value, context);
+		}
+
+		pthread_mutex_unlock(&shard->lock);
+	}
+
+	return MAP_OK;
+}
+
+int mapSize(PtMap map, int *ptSize) {
+	if (map == NULL) return MAP_NULL;
+
+	/* a snapshot: shards may change while they are summed */
+	int size = 0;
+	for (int s = 0; s < MAP_SHARDS; s++) {
+		size += shardSize(&map->shards[s]);
+	}
+
+	*ptSize = size;
+	return MAP_OK;
+}
+
+bool mapIsEmpty(PtMap map) {
+	if (map == NULL) return true;
+
+	for (int s = 0; s < MAP_SHARDS; s++) {
+		if (shardSize(&map->shards[s]) > 0) return false;
+	}
+	return true;
+}
+
+int mapClear(PtMap map) {
+	if (map == NULL) return MAP_NULL;
+
+	lockAll(map);
+
+	for (int s = 0; s < MAP_SHARDS; s++) {
+		Shard *shard = &map->shards[s];
+		setShardSize(shard, 0);
+
+		// Housekeeping. Tables can be very large at this point, realloc to initial size
+		if (shard->capacity > INITIAL_CAPACITY) {
+			Slot *newSlots = (Slot*)realloc(shard->slots, INITIAL_CAPACITY * sizeof(Slot));
+			if (newSlots != NULL) {
+				shard->slots = newSlots;
+				shard->capacity = INITIAL_CAPACITY;
+
+				ADT_STATS_REALLOC(shard->stats, INITIAL_CAPACITY * sizeof(Slot));
+			}
+		}
+		markAllEmpty(shard->slots, shard->capacity);
+	}
+
+	unlockAll(map);
+
+	return MAP_OK;
+}
+
+int mapClearRetain(PtMap map) {
+	if (map == NULL) return MAP_NULL;
+
+	lockAll(map);
+
+	for (int s = 0; s < MAP_SHARDS; s++) {
+		Shard *shard = &map->shards[s];
+		setShardSize(shard, 0);
+		markAllEmpty(shard->slots, shard->capacity);
+	}
+
+	unlockAll(map);
+
+	return MAP_OK;
+}
+
+int mapReserve(PtMap map, int capacity) {
+	if (map == NULL) return MAP_NULL;
+
+	int newCapacity = shardSlotsFor(capacity);
+
+	for (int s = 0; s < MAP_SHARDS; s++) {
+		Shard *shard = &map->shards[s];
+
+		pthread_mutex_lock(&shard->lock);
+		bool ok = (newCapacity <= shard->capacity) || rehash(shard, newCapacity);
+		pthread_mutex_unlock(&shard->lock);
+
+		if (!ok) return MAP_NO_MEMORY;
+	}
+
+	return MAP_OK;
+}
+
+int mapShrinkToFit(PtMap map) {
+	if (map == NULL) return MAP_NULL;
+
+	for (int s = 0; s < MAP_SHARDS; s++) {
+		Shard *shard = &map->shards[s];
+
+		pthread_mutex_lock(&shard->lock);
+
+		/* keep room for one entry, as placing needs an empty slot */
+		int size = shardSize(shard);
+		int newCapacity = slotsFor(size > 0 ? size : 1);
+
+		/* on failure, keep the larger table */
+		if (newCapacity < shard->capacity) rehash(shard, newCapacity);
+
+		pthread_mutex_unlock(&shard->lock);
+	}
+
+	return MAP_OK;
+}
+
+int mapStats(PtMap map, AdtStats *ptStats) {
+	if (map == NULL) return MAP_NULL;
+
+	adtStatsInit(ptStats);
+
+	for (int s = 0; s < MAP_SHARDS; s++) {
+		Shard *shard = &map->shards[s];
+
+		pthread_mutex_lock(&shard->lock);
+		ADT_STATS_MERGE(shard->stats, ptStats);
+		pthread_mutex_unlock(&shard->lock);
+	}
+
+	return MAP_OK;
+}
+
+void mapPrint(PtMap map) {
+	if (map == NULL) {
+		printf("(MAP NULL)\n");
+		return;
+	}
+
+	lockAll(map);
+
+	if (lockedSize(map) == 0) {
+		printf("(MAP EMPTY)\n");
+	}
+	else {
+		printf("Map contents(<key> : <value>): \n");
+		for (int s = 0; s < MAP_SHARDS; s++) {
+			Shard *shard = &map->shards[s];
+
+			for (int i = 0; i < shard->capacity; i++) {
+				if (shard->slots[i].distance == EMPTY_SLOT) continue;
+
+				mapKeyPrint(shard->slots[i].element.key);
+				printf(" : ");
+				mapValuePrint(shard->slots[i].element.value);
+				printf("\n");
+			}
+		}
+	}
+
+	unlockAll(map);
+}
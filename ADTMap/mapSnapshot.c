@@ -0,0 +1,350 @@
+/**
+ * @file mapSnapshot.c
+ *
+ * @brief Provides binary snapshots of the ADT Map, which can be
+ * loaded into a map or mapped into memory for lookups.
+ *
+ * Layout of a snapshot (offsets in bytes):
+ *
+ *   0                header (SnapshotHeader)
+ *   HEADER_SIZE      'capacity' slots, each with the hash code of a
+ *                    key and the index of its entry plus 1 (0 if empty)
+ *   entriesOffset    'count' entries (Entry), aligned to ENTRY_ALIGNMENT
+ *
+ * Slots are placed by linear probing, at most half of them used. The
+ * checksum covers the header, with the checksum field zeroed, and the
+ * rest of the file.
+ *
+ * Only the public operations of map.h are used, so snapshots can be
+ * saved from, and loaded into, any implementation of the ADT Map.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "mapSnapshot.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define MAGIC "ADTMAPS"
+#define BYTE_ORDER_MARK 0x01020304u
+
+#define HEADER_SIZE 64
+#define ENTRY_ALIGNMENT 64
+
+typedef struct snapshotHeader {
+	char magic[8];				/* MAGIC, NUL-terminated */
+	uint32_t version;			/* MAP_SNAPSHOT_VERSION */
+	uint32_t byteOrder;			/* BYTE_ORDER_MARK, as written by this machine */
+	uint32_t keySize;			/* sizeof(MapKey) */
+	uint32_t valueSize;			/* sizeof(MapValue) */
+	uint32_t entrySize;			/* sizeof(Entry), with padding */
+	uint32_t reserved;
+	uint64_t count;				/* number of entries */
+	uint64_t capacity;			/* number of slots, a power of two */
+	uint64_t checksum;
+	uint64_t fileSize;
+} SnapshotHeader;
+
+_Static_assert(sizeof(SnapshotHeader) == HEADER_SIZE, "the header must fill HEADER_SIZE bytes");
+
+typedef struct slot {
+	uint32_t hash;
+	uint32_t entry;				/* index of the entry plus 1, 0 if empty */
+} Slot;
+
+typedef struct entry {
+	MapKey key;
+	MapValue value;
+} Entry;
+
+typedef struct mappedMapImpl {
+	const unsigned char *base;	/* start of the mapping */
+	size_t length;
+	const SnapshotHeader *header;
+	const Slot *slots;
+	const Entry *entries;
+	uint64_t mask;				/* capacity - 1 */
+} MappedMapImpl;
+
+static uint64_t entriesOffset(uint64_t capacity) {
+	uint64_t end = HEADER_SIZE + capacity * sizeof(Slot);
+	return (end + ENTRY_ALIGNMENT - 1) / ENTRY_ALIGNMENT * ENTRY_ALIGNMENT;
+}
+
+/** Checksum of a sequence of bytes, continuing from 'seed'; 8 bytes at a time. */
+static uint64_t checksum(uint64_t seed, const unsigned char *bytes, size_t length) {
+	const uint64_t prime1 = 0x9E3779B185EBCA87ull;
+	const uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+	uint64_t h = seed ^ (length * prime1);
+	size_t i = 0;
+
+	for (; i + 8 <= length; i += 8) {
+		uint64_t word;
+		memcpy(&word, bytes + i, 8);
+		h ^= word * prime2;
+		h = ((h << 31) | (h >> 33)) * prime1;
+	}
+	for (; i < length; i++) {
+		h ^= bytes[i] * prime1;
+		h = ((h << 11) | (h >> 53)) * prime2;
+	}
+
+	h ^= h >> 33;
+	h *= prime2;
+	h ^= h >> 29;
+	return h;
+}
+
+/** Checksum of a whole snapshot, whose header is at the start of 'bytes'. */
+static uint64_t snapshotChecksum(const unsigned char *bytes, size_t length) {
+	SnapshotHeader header;
+	memcpy(&header, bytes, sizeof(header));
+	header.checksum = 0;
+
+	uint64_t h = checksum(0, (const unsigned char*)&header, sizeof(header));
+	return checksum(h, bytes + HEADER_SIZE, length - HEADER_SIZE);
+}
+
+/** State of the traversal that copies the mappings into a snapshot. */
+typedef struct saveContext {
+	Slot *slots;
+	Entry *entries;
+	uint64_t mask;
+	uint32_t count;
+	uint32_t limit;				/* entries allocated, i.e., the size of the map */
+} SaveContext;
+
+static void addEntry(MapKey key, MapValue value, void *context) {
+	SaveContext *save = (SaveContext*)context;
+	if (save->count == save->limit) return;
+
+	uint32_t hash = mapKeyHash(key);
+
+	/* zero the padding of the entry, so that the checksum is deterministic */
+	Entry *entry = &save->entries[save->count];
+	memset(entry, 0, sizeof(Entry));
+	entry->key = key;
+	entry->value = value;
+	save->count++;
+
+	uint64_t index = hash & save->mask;
+	while (save->slots[index].entry != 0) {
+		index = (index + 1) & save->mask;
+	}
+	save->slots[index].hash = hash;
+	save->slots[index].entry = save->count;
+}
+
+int mapSave(PtMap map, const char *path) {
+	if (map == NULL || path == NULL) return MAP_NULL;
+
+	int size;
+	mapSize(map, &size);
+
+	/* at most half of the slots used, so that probes are short */
+	uint64_t capacity = 1;
+	while (capacity < 2 * (uint64_t)size) capacity *= 2;
+
+	uint64_t offset = entriesOffset(capacity);
+	uint64_t fileSize = offset + (uint64_t)size * sizeof(Entry);
+
+	unsigned char *bytes = (unsigned char*)calloc(1, fileSize);
+	if (bytes == NULL) return MAP_NO_MEMORY;
+
+	SaveContext save = { (Slot*)(bytes + HEADER_SIZE), (Entry*)(bytes + offset), capacity - 1, 0, (uint32_t)size };
+	mapForEach(map, addEntry, &save);
+
+	/* fewer entries than the size, if the map changed while traversed */
+	fileSize = offset + (uint64_t)save.count * sizeof(Entry);
+
+	SnapshotHeader *header = (SnapshotHeader*)bytes;
+	memcpy(header->magic, MAGIC, sizeof(MAGIC));
+	header->version = MAP_SNAPSHOT_VERSION;
+	header->byteOrder = BYTE_ORDER_MARK;
+	header->keySize = sizeof(MapKey);
+	header->valueSize = sizeof(MapValue);
+	header->entrySize = sizeof(Entry);
+	header->count = save.count;
+	header->capacity = capacity;
+	header->fileSize = fileSize;
+	header->checksum = snapshotChecksum(bytes, fileSize);
+
+	/* write a temporary file, then replace the snapshot with it */
+	size_t pathLength = strlen(path);
+	char *tempPath = (char*)malloc(pathLength + 5);
+	if (tempPath == NULL) {
+		free(bytes);
+		return MAP_NO_MEMORY;
+	}
+	memcpy(tempPath, path, pathLength);
+	memcpy(tempPath + pathLength, ".tmp", 5);
+
+	int result = MAP_IO_ERROR;
+	FILE *file = fopen(tempPath, "wb");
+	if (file != NULL) {
+		bool written = fwrite(bytes, 1, fileSize, file) == fileSize
+				&& fflush(file) == 0 && fsync(fileno(file)) == 0;
+
+		if (fclose(file) == 0 && written && rename(tempPath, path) == 0) {
+			result = MAP_OK;
+		}
+		else {
+			remove(tempPath);
+		}
+	}
+
+	free(tempPath);
+	free(bytes);
+
+	return result;
+}
+
+PtMappedMap mapOpenMapped(const char *path) {
+	if (path == NULL) return NULL;
+
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) return NULL;
+
+	struct stat status;
+	if (fstat(fd, &status) != 0 || (uint64_t)status.st_size < HEADER_SIZE) {
+		close(fd);
+		return NULL;
+	}
+
+	size_t length = (size_t)status.st_size;
+	void *base = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);	/* the mapping keeps the file open */
+
+	if (base == MAP_FAILED) return NULL;
+
+	const SnapshotHeader *header = (const SnapshotHeader*)base;
+
+	bool valid = memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0
+			&& header->version == MAP_SNAPSHOT_VERSION
+			&& header->byteOrder == BYTE_ORDER_MARK
+			&& header->keySize == sizeof(MapKey)
+			&& header->valueSize == sizeof(MapValue)
+			&& header->entrySize == sizeof(Entry)
+			&& header->capacity > 0 && header->capacity <= (1ull << 32)
+			&& (header->capacity & (header->capacity - 1)) == 0
+			&& header->count * 2 <= header->capacity
+			&& header->fileSize == length
+			&& entriesOffset(header->capacity) + header->count * sizeof(Entry) == length;
+
+	PtMappedMap mapped = valid ? (PtMappedMap)malloc(sizeof(MappedMapImpl)) : NULL;
+	if (mapped == NULL) {
+		munmap(base, length);
+		return NULL;
+	}
+
+	mapped->base = (const unsigned char*)base;
+	mapped->length = length;
+	mapped->header = header;
+	mapped->slots = (const Slot*)(mapped->base + HEADER_SIZE);
+	mapped->entries = (const Entry*)(mapped->base + entriesOffset(header->capacity));
+	mapped->mask = header->capacity - 1;
+
+	return mapped;
+}
+
+int mapMappedClose(PtMappedMap *ptMapped) {
+	PtMappedMap mapped = *ptMapped;
+	if (mapped == NULL) return MAP_NULL;
+
+	munmap((void*)mapped->base, mapped->length);
+	free(mapped);
+
+	*ptMapped = NULL;
+
+	return MAP_OK;
+}
+
+/** Entry of a key in an opened snapshot, or NULL if not mapped. */
+static const Entry* findEntry(PtMappedMap mapped, MapKey key) {
+	uint32_t hash = mapKeyHash(key);
+	uint64_t index = hash & mapped->mask;
+
+	/* bounded, in case the snapshot is corrupted and has no empty slot */
+	for (uint64_t probes = 0; probes <= mapped->mask; probes++) {
+		const Slot *slot = &mapped->slots[index];
+
+		if (slot->entry == 0) return NULL;
+
+		if (slot->hash == hash && slot->entry <= mapped->header->count) {
+			const Entry *entry = &mapped->entries[slot->entry - 1];
+			if (mapKeyCompare(entry->key, key) == 0) return entry;
+		}
+
+		index = (index + 1) & mapped->mask;
+	}
+
+	return NULL;
+}
+
+int mapMappedGet(PtMappedMap mapped, MapKey key, MapValue *ptValue) {
+	if (mapped == NULL) return MAP_NULL;
+
+	const Entry *entry = findEntry(mapped, key);
+	if (entry == NULL) return MAP_UNKNOWN_KEY;
+
+	*ptValue = entry->value;
+
+	return MAP_OK;
+}
+
+bool mapMappedContains(PtMappedMap mapped, MapKey key) {
+	if (mapped == NULL) return false;
+
+	return findEntry(mapped, key) != NULL;
+}
+
+int mapMappedSize(PtMappedMap mapped, int *ptSize) {
+	if (mapped == NULL) return MAP_NULL;
+
+	*ptSize = (int)mapped->header->count;
+
+	return MAP_OK;
+}
+
+int mapMappedVerify(PtMappedMap mapped) {
+	if (mapped == NULL) return MAP_NULL;
+
+	if (snapshotChecksum(mapped->base, mapped->length) != mapped->header->checksum) {
+		return MAP_BAD_SNAPSHOT;
+	}
+
+	return MAP_OK;
+}
+
+PtMap mapLoad(const char *path) {
+	PtMappedMap mapped = mapOpenMapped(path);
+	if (mapped == NULL) return NULL;
+
+	/* the whole file is read anyway, sequentially */
+	madvise((void*)mapped->base, mapped->length, MADV_SEQUENTIAL);
+
+	if (mapMappedVerify(mapped) != MAP_OK) {
+		mapMappedClose(&mapped);
+		return NULL;
+	}
+
+	int count = (int)mapped->header->count;
+	PtMap map = mapCreateWithCapacity(count > 0 ? count : 1);
+
+	for (int i = 0; map != NULL && i < count; i++) {
+		if (mapPut(map, mapped->entries[i].key, mapped->entries[i].value) != MAP_OK) {
+			mapDestroy(&map);
+		}
+	}
+
+	mapMappedClose(&mapped);
+
+	return map;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file mapSnapshot.h
+ * @brief Binary snapshots of the ADT Map.
+ *
+ * mapSave writes the mappings of a map, of any implementation, to a
+ * snapshot file, and mapLoad creates a map with the mappings of a
+ * snapshot, instead of rebuilding it from the source data.
+ *
+ * A snapshot is also a read-only hash table: mapOpenMapped maps the
+ * file into memory (mmap) and looks keys up directly in its pages, so
+ * opening it takes constant time, pages are only read when first
+ * needed, and processes that open the same snapshot share one copy of
+ * it in the page cache.
+ *
+ * A snapshot starts with a header holding a magic number, the version
+ * of the format, the byte order and the sizes of MapKey and MapValue,
+ * followed by a table of slots (hash code and entry of each key, with
+ * linear probing) and the entries (key-value pairs). A checksum of the
+ * whole file detects truncated or corrupted snapshots.
+ *
+ * Keys and values are written as their bytes, so MapKey and MapValue
+ * must not hold pointers, and mapKeyHash must give the same hash code
+ * to a key in every process (e.g., it must not hash an address).
+ * Snapshots can only be read on machines with the same byte order.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#pragma once
+
+#include "map.h"
+
+#define MAP_IO_ERROR      6
+#define MAP_BAD_SNAPSHOT  7
+
+/** Version of the snapshot format written by mapSave. */
+#define MAP_SNAPSHOT_VERSION 1
+
+/** Forward declaration of the data structure. */
+struct mappedMapImpl;
+
+/** Definition of pointer to the data structure. */
+typedef struct mappedMapImpl *PtMappedMap;
+
+/**
+ * @brief Saves the mappings of a map to a snapshot file.
+ *
+ * The snapshot is written to a temporary file, which then replaces
+ * 'path', so a reader never sees a partially written snapshot.
+ *
+ * @param map [in] pointer to the map
+ * @param path [in] path of the snapshot file
+ *
+ * @return MAP_OK if successful, or
+ * @return MAP_IO_ERROR if the file could not be written, or
+ * @return MAP_NO_MEMORY if unsufficient memory for allocation, or
+ * @return MAP_NULL if 'map' or 'path' is NULL
+ */
+int mapSave(PtMap map, const char *path);
+
+/**
+ * @brief Creates a new map with the mappings of a snapshot file.
+ *
+ * The checksum of the snapshot is verified before any mapping is added.
+ *
+ * @param path [in] path of the snapshot file
+ *
+ * @return PtMap pointer to allocated data structure, or
+ * @return NULL if the file could not be read, is not a valid snapshot
+ * (of this version, byte order and MapKey and MapValue types), or
+ * unsufficient memory for allocation
+ */
+PtMap mapLoad(const char *path);
+
+/**
+ * @brief Opens a snapshot file for lookups, mapping it into memory.
+ *
+ * The header and the size of the file are verified, but not the
+ * checksum, which would read the whole file (see mapMappedVerify).
+ *
+ * @param path [in] path of the snapshot file
+ *
+ * @return PtMappedMap pointer to the opened snapshot, or
+ * @return NULL if the file could not be mapped or is not a valid snapshot
+ */
+PtMappedMap mapOpenMapped(const char *path);
+
+/**
+ * @brief Closes a snapshot opened by mapOpenMapped, unmapping it.
+ *
+ * @param ptMapped [in] ADDRESS OF pointer to the opened snapshot
+ *
+ * @return MAP_OK if success and *ptMapped modified to NULL, or
+ * @return MAP_NULL if '*ptMapped' is NULL
+ */
+int mapMappedClose(PtMappedMap *ptMapped);
+
+/**
+ * @brief Retrieves the value mapped to a key in an opened snapshot.
+ *
+ * @param mapped [in] pointer to the opened snapshot
+ * @param key [in] key to search for
+ * @param ptValue [out] address of variable to hold the value
+ *
+ * @return MAP_OK if successful and value in 'ptValue', or
+ * @return MAP_UNKNOWN_KEY if the key is not mapped, or
+ * @return MAP_NULL if 'mapped' is NULL
+ */
+int mapMappedGet(PtMappedMap mapped, MapKey key, MapValue *ptValue);
+
+/**
+ * @brief Checks whether a key is mapped in an opened snapshot.
+ *
+ * @param mapped [in] pointer to the opened snapshot
+ * @param key [in] key to search for
+ *
+ * @return 'true' if the key is mapped, or
+ * @return 'false' if it is not or if 'mapped' is NULL
+ */
+bool mapMappedContains(PtMappedMap mapped, MapKey key);
+
+/**
+ * @brief Retrieves the number of mappings of an opened snapshot.
+ *
+ * @param mapped [in] pointer to the opened snapshot
+ * @param ptSize [out] address of variable to hold the value
+ *
+ * @return MAP_OK if successful and value in 'ptSize', or
+ * @return MAP_NULL if 'mapped' is NULL
+ */
+int mapMappedSize(PtMappedMap mapped, int *ptSize);
+
+/**
+ * @brief Verifies the checksum of an opened snapshot, reading all of it.
+ *
+ * @param mapped [in] pointer to the opened snapshot
+ *
+ * @return MAP_OK if the checksum matches, or
+ * @return MAP_BAD_SNAPSHOT if it does not, or
+ * @return MAP_NULL if 'mapped' is NULL
+ */
+int mapMappedVerify(PtMappedMap mapped);
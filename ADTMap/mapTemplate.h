@@ -0,0 +1,352 @@
+/**
+ * @file mapTemplate.h
+ * @brief Generic, type-specialized version of the ADT Map
+ * with an open-addressing hash table (Robin Hood hashing) as the
+ * underlying data structure.
+ *
+ * DEFINE_MAP(Name, K, V, hash, cmp) defines a map from keys of type K
+ * to values of type V, unboxed, as the type 'Name' and the functions
+ * 'Name##Create', 'Name##Put', etc., with the same semantics and error
+ * codes as the operations of map.h (see mapHashTable.c). 'hash' is a
+ * function (or macro) 'unsigned int hash(K)' and 'cmp' is a function
+ * (or macro) 'int cmp(K, K)' that returns 0 for equal keys; both are
+ * expanded in place, so they can be inlined. The functions are
+ * 'static inline', so each translation unit may define several maps,
+ * of different types, without changing mapElem.h.
+ *
+ * Example:
+ *
+ *     static inline unsigned int intHash(int key) { return key * 2654435761u; }
+ *     static inline int intCompare(int a, int b) { return (a > b) - (a < b); }
+ *
+ *     DEFINE_MAP(IntDoubleMap, int, double, intHash, intCompare)
+ *
+ *     IntDoubleMap map = IntDoubleMapCreate();
+ *     IntDoubleMapPut(map, 42, 3.14);
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+/* same values as in map.h */
+#define MAP_OK				0
+#define MAP_NULL			1
+#define MAP_NO_MEMORY		2
+#define MAP_EMPTY			3
+#define MAP_FULL			4
+#define MAP_UNKNOWN_KEY		5
+
+/** Must be a power of two, so that 'hash & (capacity - 1)' selects a slot. */
+#define MAP_TEMPLATE_INITIAL_CAPACITY 16
+
+/** Marks a slot that holds no entry. */
+#define MAP_TEMPLATE_EMPTY_SLOT -1
+
+/**
+ * @brief Defines the type 'Name', a map from keys of type 'K'
+ * to values of type 'V', and its operations.
+ *
+ * @param Name name of the map type, also the prefix of its operations
+ * @param K type of the keys
+ * @param V type of the values
+ * @param hash hash function of the keys
+ * @param cmp comparison function of the keys
+ */
+#define DEFINE_MAP(Name, K, V, hash, cmp)                                       \
+                                                                                \
+typedef struct Name##Slot {                                                     \
+	K key;                                                                      \
+	V value;                                                                    \
+	unsigned int hashCode;	/* cached hash code of the key */                   \
+	int distance;			/* distance from home slot, or EMPTY_SLOT */        \
+} Name##Slot;                                                                   \
+                                                                                \
+typedef struct Name##Impl {                                                     \
+	Name##Slot *slots;                                                          \
+	int capacity;                                                               \
+	int size;                                                                   \
+} Name##Impl;                                                                   \
+                                                                                \
+typedef Name##Impl *Name;                                                       \
+                                                                                \
+static inline int Name##FindSlot(Name map, K key) {                             \
+	unsigned int hashCode = hash(key);                                          \
+	int mask = map->capacity - 1;                                               \
+	int index = hashCode & mask;                                                \
+                                                                                \
+	for (int distance = 0; ; distance++) {                                      \
+		Name##Slot *slot = &map->slots[index];                                  \
+                                                                                \
+		if (slot->distance == MAP_TEMPLATE_EMPTY_SLOT || slot->distance < distance) { \
+			return -1;                                                          \
+		}                                                                       \
+		if (slot->hashCode == hashCode && cmp(slot->key, key) == 0) {           \
+			return index;                                                       \
+		}                                                                       \
+                                                                                \
+		index = (index + 1) & mask;                                             \
+	}                                                                           \
+}                                                                               \
+                                                                                \
+static inline int Name##PlaceEntry(Name##Slot *slots, int capacity,             \
+									Name##Slot incoming) {                      \
+	int mask = capacity - 1;                                                    \
+	int index = incoming.hashCode & mask;                                       \
+	int placedAt = -1;                                                          \
+                                                                                \
+	incoming.distance = 0;                                                      \
+                                                                                \
+	while (true) {                                                              \
+		Name##Slot *slot = &slots[index];                                       \
+                                                                                \
+		if (slot->distance == MAP_TEMPLATE_EMPTY_SLOT) {                        \
+			*slot = incoming;                                                   \
+			return (placedAt == -1) ? index : placedAt;                         \
+		}                                                                       \
+                                                                                \
+		if (slot->distance < incoming.distance) {                               \
+			/* take from the rich: swap and keep placing the evicted entry */   \
+			Name##Slot evicted = *slot;                                         \
+			*slot = incoming;                                                   \
+			incoming = evicted;                                                 \
+                                                                                \
+			if (placedAt == -1) placedAt = index;                               \
+		}                                                                       \
+                                                                                \
+		index = (index + 1) & mask;                                             \
+		incoming.distance++;                                                    \
+	}                                                                           \
+}                                                                               \
+                                                                                \
+static inline void Name##MarkAllEmpty(Name##Slot *slots, int capacity) {        \
+	for (int i = 0; i < capacity; i++) {                                        \
+		slots[i].distance = MAP_TEMPLATE_EMPTY_SLOT;                            \
+	}                                                                           \
+}                                                                               \
+                                                                                \
+static inline bool Name##Rehash(Name map, int newCapacity) {                    \
+	Name##Slot *newSlots = (Name##Slot*)malloc(newCapacity * sizeof(Name##Slot)); \
+	if (newSlots == NULL) return false;                                         \
+                                                                                \
+	Name##MarkAllEmpty(newSlots, newCapacity);                                  \
+                                                                                \
+	for (int i = 0; i < map->capacity; i++) {                                   \
+		if (map->slots[i].distance != MAP_TEMPLATE_EMPTY_SLOT) {                \
+			Name##PlaceEntry(newSlots, newCapacity, map->slots[i]);             \
+		}                                                                       \
+	}                                                                           \
+                                                                                \
+	free(map->slots);                                                           \
+	map->slots = newSlots;                                                      \
+	map->capacity = newCapacity;                                                \
+                                                                                \
+	return true;                                                                \
+}                                                                               \
+                                                                                \
+/* returns the slot of 'key', placing it with 'value' if missing, or -1 */      \
+static inline int Name##FindOrInsert(Name map, K key, V value, bool *ptInserted) { \
+	int index = Name##FindSlot(map, key);                                       \
+	*ptInserted = (index == -1);                                                \
+	if (index != -1) return index;                                              \
+                                                                                \
+	/* keep load factor at or below 7/8 */                                      \
+	if ((map->size + 1) * 8 > map->capacity * 7 &&                              \
+		!Name##Rehash(map, map->capacity * 2)) {                                \
+		return -1;                                                              \
+	}                                                                           \
+                                                                                \
+	Name##Slot incoming;                                                        \
+	incoming.key = key;                                                         \
+	incoming.value = value;                                                     \
+	incoming.hashCode = hash(key);                                              \
+                                                                                \
+	index = Name##PlaceEntry(map->slots, map->capacity, incoming);              \
+	map->size++;                                                                \
+                                                                                \
+	return index;                                                               \
+}                                                                               \
+                                                                                \
+static inline Name Name##Create(void) {                                         \
+	Name map = (Name)malloc(sizeof(Name##Impl));                                \
+	if (map == NULL) return NULL;                                               \
+                                                                                \
+	map->slots = (Name##Slot*)malloc(MAP_TEMPLATE_INITIAL_CAPACITY * sizeof(Name##Slot)); \
+	if (map->slots == NULL) {                                                   \
+		free(map);                                                              \
+		return NULL;                                                            \
+	}                                                                           \
+	Name##MarkAllEmpty(map->slots, MAP_TEMPLATE_INITIAL_CAPACITY);              \
+                                                                                \
+	map->size = 0;                                                              \
+	map->capacity = MAP_TEMPLATE_INITIAL_CAPACITY;                              \
+                                                                                \
+	return map;                                                                 \
+}                                                                               \
+                                                                                \
+static inline int Name##Destroy(Name *ptMap) {                                  \
+	Name map = *ptMap;                                                          \
+	if (map == NULL) return MAP_NULL;                                           \
+                                                                                \
+	free(map->slots);                                                           \
+	free(map);                                                                  \
+                                                                                \
+	*ptMap = NULL;                                                              \
+                                                                                \
+	return MAP_OK;                                                              \
+}                                                                               \
+                                                                                \
+static inline int Name##Put(Name map, K key, V value) {                         \
+	if (map == NULL) return MAP_NULL;                                           \
+                                                                                \
+	bool inserted;                                                              \
+	int index = Name##FindOrInsert(map, key, value, &inserted);                 \
+	if (index == -1) return MAP_NO_MEMORY;                                      \
+                                                                                \
+	map->slots[index].value = value;                                            \
+                                                                                \
+	return MAP_OK;                                                              \
+}                                                                               \
+                                                                                \
+static inline int Name##GetOrInsertPtr(Name map, K key, V defaultValue, V **ptValue) { \
+	if (map == NULL) return MAP_NULL;                                           \
+                                                                                \
+	bool inserted;                                                              \
+	int index = Name##FindOrInsert(map, key, defaultValue, &inserted);          \
+	if (index == -1) return MAP_NO_MEMORY;                                      \
+                                                                                \
+	*ptValue = &map->slots[index].value;                                        \
+                                                                                \
+	return MAP_OK;                                                              \
+}                                                                               \
+                                                                                \
+static inline int Name##Merge(Name map, K key, V value, V (*combine)(V, V)) {   \
+	if (map == NULL) return MAP_NULL;                                           \
+                                                                                \
+	bool inserted;                                                              \
+	int index = Name##FindOrInsert(map, key, value, &inserted);                 \
+	if (index == -1) return MAP_NO_MEMORY;                                      \
+                                                                                \
+	if (!inserted) {                                                            \
+		Name##Slot *slot = &map->slots[index];                                  \
+		slot->value = combine(slot->value, value);                              \
+	}                                                                           \
+                                                                                \
+	return MAP_OK;                                                              \
+}                                                                               \
+                                                                                \
+static inline int Name##Remove(Name map, K key, V *ptValue) {                   \
+	if (map == NULL) return MAP_NULL;                                           \
+	if (map->size == 0) return MAP_EMPTY;                                       \
+                                                                                \
+	int index = Name##FindSlot(map, key);                                       \
+	if (index == -1) return MAP_UNKNOWN_KEY;                                    \
+                                                                                \
+	*ptValue = map->slots[index].value;                                         \
+                                                                                \
+	/* backward-shift the following displaced entries one slot closer to home */ \
+	int mask = map->capacity - 1;                                               \
+	int next = (index + 1) & mask;                                              \
+	while (map->slots[next].distance > 0) {                                     \
+		map->slots[index] = map->slots[next];                                   \
+		map->slots[index].distance--;                                           \
+                                                                                \
+		index = next;                                                           \
+		next = (next + 1) & mask;                                               \
+	}                                                                           \
+	map->slots[index].distance = MAP_TEMPLATE_EMPTY_SLOT;                       \
+                                                                                \
+	map->size--;                                                                \
+                                                                                \
+	return MAP_OK;                                                              \
+}                                                                               \
+                                                                                \
+static inline bool Name##Contains(Name map, K key) {                            \
+	if (map == NULL) return false;                                              \
+                                                                                \
+	return Name##FindSlot(map, key) != -1;                                      \
+}                                                                               \
+                                                                                \
+static inline int Name##Get(Name map, K key, V *ptValue) {                      \
+	if (map == NULL) return MAP_NULL;                                           \
+	if (map->size == 0) return MAP_EMPTY;                                       \
+                                                                                \
+	int index = Name##FindSlot(map, key);                                       \
+	if (index == -1) return MAP_UNKNOWN_KEY;                                    \
+                                                                                \
+	*ptValue = map->slots[index].value;                                         \
+                                                                                \
+	return MAP_OK;                                                              \
+}                                                                               \
+                                                                                \
+/* visits the mappings in no particular order */                                \
+static inline int Name##ForEach(Name map, void (*visit)(K, V, void*), void *context) { \
+	if (map == NULL) return MAP_NULL;                                           \
+                                                                                \
+	for (int i = 0; i < map->capacity; i++) {                                   \
+		if (map->slots[i].distance == MAP_TEMPLATE_EMPTY_SLOT) continue;        \
+                                                                                \
+		visit(map->slots[i].key, map->slots[i].value, context);                 \
+	}                                                                           \
+                                                                                \
+	return MAP_OK;                                                              \
+}                                                                               \
+                                                                                \
+static inline int Name##Size(Name map, int *ptSize) {                           \
+	if (map == NULL) return MAP_NULL;                                           \
+                                                                                \
+	*ptSize = map->size;                                                        \
+                                                                                \
+	return MAP_OK;                                                              \
+}                                                                               \
+                                                                                \
+static inline bool Name##IsEmpty(Name map) {                                    \
+	if (map == NULL) return true;                                               \
+                                                                                \
+	return (map->size == 0);                                                    \
+}                                                                               \
+                                                                                \
+static inline int Name##Clear(Name map) {                                       \
+	if (map == NULL) return MAP_NULL;                                           \
+                                                                                \
+	map->size = 0;                                                              \
+                                                                                \
+	/* housekeeping: the table can be very large, shrink to initial size */     \
+	if (map->capacity > MAP_TEMPLATE_INITIAL_CAPACITY) {                        \
+		Name##Slot *newSlots = (Name##Slot*)realloc(map->slots,                 \
+							MAP_TEMPLATE_INITIAL_CAPACITY * sizeof(Name##Slot)); \
+		if (newSlots != NULL) {                                                 \
+			map->slots = newSlots;                                              \
+			map->capacity = MAP_TEMPLATE_INITIAL_CAPACITY;                      \
+		}                                                                       \
+	}                                                                           \
+	Name##MarkAllEmpty(map->slots, map->capacity);                              \
+                                                                                \
+	return MAP_OK;                                                              \
+}                                                                               \
+                                                                                \
+/* prints with 'keyPrint' and 'valuePrint' printing each mapping */             \
+static inline void Name##Print(Name map, void (*keyPrint)(K), void (*valuePrint)(V)) { \
+	if (map == NULL) {                                                          \
+		printf("(MAP NULL)\n");                                                 \
+	}                                                                           \
+	else if (map->size == 0) {                                                  \
+		printf("(MAP EMPTY)\n");                                                \
+	}                                                                           \
+	else {                                                                      \
+		printf("Map contents(<key> : <value>): \n");                            \
+		for (int i = 0; i < map->capacity; i++) {                               \
+			if (map->slots[i].distance == MAP_TEMPLATE_EMPTY_SLOT) continue;    \
+                                                                                \
+			keyPrint(map->slots[i].key);                                        \
+			printf(" : ");                                                      \
+			valuePrint(map->slots[i].value);                                    \
+			printf("\n");                                                       \
+		}                                                                       \
+	}                                                                           \
+}
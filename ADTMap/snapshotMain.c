@@ -0,0 +1,189 @@
+/**
+ * @file snapshotMain.c
+ *
+ * @brief Provides an example program that saves a map to a snapshot
+ * and starts from it again, by loading it into a map (mapLoad) and by
+ * mapping it into memory (mapOpenMapped), compared with rebuilding
+ * the map. Please note that the MapKey and MapValue types must be
+ * defined as 'int'.
+ *
+ * The program checks that every mapping is found after each start,
+ * that keys not in the map are not, and that a corrupted or truncated
+ * snapshot is rejected.
+ *
+ * Usage: prog [number of mappings] [snapshot path]
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "mapSnapshot.h"
+
+static int count;
+
+/** Key and value of the i-th mapping; keys are distinct and odd. */
+static MapKey keyOf(int i) {
+	return (MapKey)((unsigned int)i * 2654435761u) | 1;
+}
+
+static MapValue valueOf(int i) {
+	return (MapValue)i;
+}
+
+static double elapsedSeconds(struct timespec start, struct timespec end) {
+	return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+static PtMap build() {
+	PtMap map = mapCreate();
+
+	for (int i = 0; map != NULL && i < count; i++) {
+		if (mapPut(map, keyOf(i), valueOf(i)) != MAP_OK) mapDestroy(&map);
+	}
+
+	return map;
+}
+
+static bool checkMap(PtMap map) {
+	int size;
+	if (map == NULL || mapSize(map, &size) != MAP_OK || size != count) return false;
+
+	for (int i = 0; i < count; i++) {
+		MapValue value;
+		if (mapGet(map, keyOf(i), &value) != MAP_OK || value != valueOf(i)) return false;
+		if (mapContains(map, keyOf(i) - 1)) return false;	/* even keys are not mapped */
+	}
+
+	return true;
+}
+
+static bool checkMapped(PtMappedMap mapped) {
+	int size;
+	if (mapped == NULL || mapMappedSize(mapped, &size) != MAP_OK || size != count) return false;
+
+	for (int i = 0; i < count; i++) {
+		MapValue value;
+		if (mapMappedGet(mapped, keyOf(i), &value) != MAP_OK || value != valueOf(i)) return false;
+		if (mapMappedContains(mapped, keyOf(i) - 1)) return false;
+	}
+
+	return true;
+}
+
+/** Copies a file, flipping a byte at 'flipOffset' (if >= 0) and keeping 'length' bytes. */
+static bool copyDamaged(const char *from, const char *to, long flipOffset, long length) {
+	FILE *in = fopen(from, "rb");
+	if (in == NULL) return false;
+
+	char *bytes = (char*)malloc(length);
+	bool copied = bytes != NULL && fread(bytes, 1, length, in) == (size_t)length;
+	fclose(in);
+
+	if (copied) {
+		if (flipOffset >= 0) bytes[flipOffset] ^= 0x40;
+
+		FILE *out = fopen(to, "wb");
+		copied = out != NULL && fwrite(bytes, 1, length, out) == (size_t)length;
+		if (out != NULL) fclose(out);
+	}
+
+	free(bytes);
+	return copied;
+}
+
+static void report(const char *what, bool ok, double seconds) {
+	printf("%-40s %10.3f ms  %s\n", what, seconds * 1e3, ok ? "ok" : "FAILED");
+}
+
+int main(int argc, char** argv) {
+	count = (argc > 1) ? atoi(argv[1]) : 1000000;
+	const char *path = (argc > 2) ? argv[2] : "map.snapshot";
+
+	if (count < 0) {
+		printf("Usage: %s [number of mappings] [snapshot path]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	struct timespec start, end;
+	bool passed = true, ok;
+
+	printf("Mappings: %d, snapshot: %s\n", count, path);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	PtMap map = build();
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	report("Rebuild with mapPut", map != NULL, elapsedSeconds(start, end));
+	if (map == NULL) return EXIT_FAILURE;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	ok = mapSave(map, path) == MAP_OK;
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	report("mapSave", ok, elapsedSeconds(start, end));
+	passed = passed && ok;
+	mapDestroy(&map);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	map = mapLoad(path);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	ok = checkMap(map);
+	report("mapLoad (verifies the checksum)", ok, elapsedSeconds(start, end));
+	passed = passed && ok;
+	mapDestroy(&map);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	PtMappedMap mapped = mapOpenMapped(path);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	report("mapOpenMapped", mapped != NULL, elapsedSeconds(start, end));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	ok = checkMapped(mapped);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	report("  lookups of all keys, and missing ones", ok, elapsedSeconds(start, end));
+	passed = passed && ok;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	ok = mapMappedVerify(mapped) == MAP_OK;
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	report("  mapMappedVerify", ok, elapsedSeconds(start, end));
+	passed = passed && ok;
+	mapMappedClose(&mapped);
+
+	/* a flipped byte in the last entry, and a missing last byte */
+	char *damagedPath = (char*)malloc(strlen(path) + 5);
+	sprintf(damagedPath, "%s.bad", path);
+
+	long length = 0;
+	FILE *file = fopen(path, "rb");
+	if (file != NULL) {
+		fseek(file, 0, SEEK_END);
+		length = ftell(file);
+		fclose(file);
+	}
+
+	ok = copyDamaged(path, damagedPath, length - 1, length);
+	map = mapLoad(damagedPath);
+	mapped = mapOpenMapped(damagedPath);
+	ok = ok && map == NULL && mapped != NULL && mapMappedVerify(mapped) == MAP_BAD_SNAPSHOT;
+	report("Corrupted snapshot rejected", ok, 0);
+	passed = passed && ok;
+	mapDestroy(&map);
+	mapMappedClose(&mapped);
+
+	ok = copyDamaged(path, damagedPath, -1, length - 1);
+	ok = ok && mapLoad(damagedPath) == NULL && mapOpenMapped(damagedPath) == NULL;
+	report("Truncated snapshot rejected", ok, 0);
+	passed = passed && ok;
+
+	remove(damagedPath);
+	remove(path);
+	free(damagedPath);
+
+	printf("%s\n", passed ? "PASSED" : "FAILED");
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file templateMain.c
+ * 
+ * @brief Provides an example program that uses two
+ * specializations of the ADT Map, defined with DEFINE_MAP,
+ * in the same program: a map from words to their number of
+ * occurrences and a map from word lengths to their average
+ * number of occurrences.
+ * 
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mapTemplate.h"
+
+typedef const char* Word;
+
+typedef struct average {
+	int sum;
+	int count;
+} Average;
+
+/* FNV-1a */
+static inline unsigned int wordHash(Word word) {
+	unsigned int hash = 2166136261u;
+	for (const char *c = word; *c != '\0'; c++) {
+		hash = (hash ^ (unsigned char)*c) * 16777619u;
+	}
+	return hash;
+}
+
+static inline unsigned int intHash(int key) {
+	return (unsigned int)key * 2654435761u;
+}
+
+static inline int intCompare(int key1, int key2) {
+	return (key1 > key2) - (key1 < key2);
+}
+
+DEFINE_MAP(WordCountMap, Word, int, wordHash, strcmp)
+DEFINE_MAP(LengthMap, int, Average, intHash, intCompare)
+
+static void wordPrint(Word word) {
+	printf("%-6s", word);
+}
+
+static void intPrint(int value) {
+	printf("%d", value);
+}
+
+static void averagePrint(Average average) {
+	printf("%.2f", (double)average.sum / average.count);
+}
+
+static void accumulateByLength(Word word, int count, void *context) {
+	LengthMap lengths = (LengthMap)context;
+
+	Average *average;
+	Average none = { 0, 0 };
+	if (LengthMapGetOrInsertPtr(lengths, (int)strlen(word), none, &average) == MAP_OK) {
+		average->sum += count;
+		average->count++;
+	}
+}
+
+int main() {
+	const char *text[] = {
+		"the", "quick", "brown", "fox", "jumps", "over", "the", "lazy",
+		"dog", "and", "the", "dog", "sleeps", "while", "the", "fox", "runs"
+	};
+	int numWords = sizeof(text) / sizeof(text[0]);
+
+	WordCountMap counts = WordCountMapCreate();
+	LengthMap lengths = LengthMapCreate();
+	if (counts == NULL || lengths == NULL) {
+		printf("Could not create the maps. \n");
+		return EXIT_FAILURE;
+	}
+
+	for (int i = 0; i < numWords; i++) {
+		int *count;
+		if (WordCountMapGetOrInsertPtr(counts, text[i], 0, &count) == MAP_OK) {
+			(*count)++;
+		}
+	}
+
+	int removed;
+	WordCountMapRemove(counts, "and", &removed);
+
+	WordCountMapPrint(counts, wordPrint, intPrint);
+	printf("\n");
+
+	WordCountMapForEach(counts, accumulateByLength, lengths);
+
+	printf("Average occurrences by word length: \n");
+	LengthMapPrint(lengths, intPrint, averagePrint);
+
+	int theCount;
+	if (WordCountMapGet(counts, "the", &theCount) == MAP_OK) {
+		printf("\n'the' occurs %d times. \n", theCount);
+	}
+
+	WordCountMapDestroy(&counts);
+	LengthMapDestroy(&lengths);
+
+	return EXIT_SUCCESS;
+}
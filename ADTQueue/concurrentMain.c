@@ -0,0 +1,177 @@
+/**
+ * @file concurrentMain.c
+ *
+ * @brief Provides a stress test and throughput benchmark of the
+ * thread-safe implementations of the ADT Queue (queueSpsc.c and
+ * queueMpmc.c). Please note that the QueueElem type must be
+ * defined as 'char'.
+ *
+ * Producer threads enqueue a known sequence of elements while
+ * consumer threads dequeue them. At the end, the program checks that
+ * no element was lost or duplicated (by count and checksum) and, with
+ * a single consumer, that the elements of each producer arrived in
+ * the order they were enqueued.
+ *
+ * Usage: prog [producers] [consumers] [elements per producer]
+ *
+ * When compiled with SINGLE_PRODUCER_CONSUMER defined, exactly one
+ * producer and one consumer are used.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include "queueConcurrent.h"
+
+#define MAX_THREADS 64
+
+/** Producers are told apart by the 2 high bits of the 7-bit elements. */
+#define PRODUCER_SHIFT 5
+#define SEQUENCE_MASK ((1 << PRODUCER_SHIFT) - 1)
+
+typedef struct consumerResult {
+	long count;
+	long checksum;
+	bool ordered;
+} ConsumerResult;
+
+static PtQueue queue;
+static long elementsPerProducer;
+static atomic_bool producersDone;
+
+static QueueElem elementOf(long producer, long i) {
+	return (QueueElem)(((producer & 3) << PRODUCER_SHIFT) | (i & SEQUENCE_MASK));
+}
+
+static void* producer(void *arg) {
+	long id = (long)arg;
+
+	for (long i = 0; i < elementsPerProducer; i++) {
+		queueEnqueue(queue, elementOf(id, i));
+	}
+
+	return NULL;
+}
+
+static void* consumer(void *arg) {
+	ConsumerResult *result = (ConsumerResult*)arg;
+	int expectedSequence[4] = {0, 0, 0, 0};
+
+	result->count = 0;
+	result->checksum = 0;
+	result->ordered = true;
+
+	QueueElem elem;
+	while (true) {
+		if (queueDequeue(queue, &elem) != QUEUE_OK) {
+			if (!atomic_load(&producersDone)) {
+				sched_yield(); /* let producers run on oversubscribed cores */
+				continue;
+			}
+			/* producers finished before this attempt: empty means drained */
+			if (queueDequeue(queue, &elem) != QUEUE_OK) break;
+		}
+
+		int producerId = (elem >> PRODUCER_SHIFT) & 3;
+		int sequence = elem & SEQUENCE_MASK;
+
+		if (sequence != expectedSequence[producerId]) result->ordered = false;
+		expectedSequence[producerId] = (sequence + 1) & SEQUENCE_MASK;
+
+		result->count++;
+		result->checksum += elem;
+	}
+
+	return NULL;
+}
+
+static double elapsedSeconds(struct timespec start, struct timespec end) {
+	return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+int main(int argc, char** argv) {
+	int producers = (argc > 1) ? atoi(argv[1]) : 2;
+	int consumers = (argc > 2) ? atoi(argv[2]) : 2;
+	elementsPerProducer = (argc > 3) ? atol(argv[3]) : 1000000;
+
+#ifdef SINGLE_PRODUCER_CONSUMER
+	producers = 1;
+	consumers = 1;
+#endif
+
+	if (producers < 1 || consumers < 1 || producers + consumers > MAX_THREADS) {
+		printf("Invalid number of threads.\n");
+		return EXIT_FAILURE;
+	}
+
+	queue = queueCreate();
+	if (queue == NULL) {
+		printf("Could not create the queue.\n");
+		return EXIT_FAILURE;
+	}
+
+	pthread_t producerThreads[MAX_THREADS], consumerThreads[MAX_THREADS];
+	ConsumerResult results[MAX_THREADS];
+	struct timespec start, end;
+
+	atomic_init(&producersDone, false);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (int i = 0; i < consumers; i++) {
+		pthread_create(&consumerThreads[i], NULL, consumer, &results[i]);
+	}
+	for (long i = 0; i < producers; i++) {
+		pthread_create(&producerThreads[i], NULL, producer, (void*)i);
+	}
+
+	for (int i = 0; i < producers; i++) {
+		pthread_join(producerThreads[i], NULL);
+	}
+	atomic_store(&producersDone, true);
+
+	for (int i = 0; i < consumers; i++) {
+		pthread_join(consumerThreads[i], NULL);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	/* compare what was received with what was sent */
+	long expectedCount = producers * elementsPerProducer, count = 0;
+	long expectedChecksum = 0, checksum = 0;
+	for (long p = 0; p < producers; p++) {
+		for (long i = 0; i < elementsPerProducer; i++) {
+			expectedChecksum += elementOf(p, i);
+		}
+	}
+
+	bool ordered = true;
+	for (int i = 0; i < consumers; i++) {
+		count += results[i].count;
+		checksum += results[i].checksum;
+		ordered = ordered && results[i].ordered;
+	}
+
+	double seconds = elapsedSeconds(start, end);
+
+	printf("Producers: %d, consumers: %d, elements: %ld\n", producers, consumers, expectedCount);
+	printf("Elapsed: %.3f s, throughput: %.2f M elements/s\n", seconds, count / seconds / 1e6);
+
+	bool passed = (count == expectedCount && checksum == expectedChecksum);
+	if (consumers == 1 && producers <= 4) {
+		/* only a single consumer sees all elements of each producer */
+		passed = passed && ordered;
+	}
+
+	printf("%s\n", passed ? "PASSED" : "FAILED");
+
+	queueDestroy(&queue);
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
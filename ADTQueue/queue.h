@@ -18,6 +18,7 @@
 
 #include <stdbool.h>
 #include "queueElem.h"
+#include "adtStats.h"
 
 /** Forward declaration of the data structure. */
 struct queueImpl;
@@ -33,6 +34,20 @@ typedef struct queueImpl *PtQueue;
  */
 PtQueue queueCreate();
 
+/**
+ * @brief Creates a new empty queue with room for a number of elements.
+ * 
+ * Enqueueing up to 'capacity' elements does not allocate memory.
+ * The bounded implementations (see queueConcurrent.h) hold at most 
+ * 'capacity' elements, as created by queueCreateBounded.
+ * 
+ * @param capacity [in] number of elements to make room for
+ * 
+ * @return PtQueue pointer to allocated data structure, or
+ * @return NULL if 'capacity' < 1 or unsufficient memory for allocation
+ */
+PtQueue queueCreateWithCapacity(int capacity);
+
 /**
  * @brief Free all resources of a queue.
  * 
@@ -114,6 +129,67 @@ bool queueIsEmpty(PtQueue queue);
  */
 int queueClear(PtQueue queue);
 
+/**
+ * @brief Clears the contents of a queue, keeping its memory.
+ * 
+ * Unlike queueClear, which releases the memory of a large queue,
+ * the queue keeps room for as many elements as it held, so that
+ * refilling it does not allocate memory.
+ * 
+ * @param queue [in] pointer to the queue
+ * 
+ * @return QUEUE_OK if successful, or
+ * @return QUEUE_NULL if 'queue' is NULL 
+ */
+int queueClearRetain(PtQueue queue);
+
+/**
+ * @brief Makes room for a number of elements in a queue.
+ * 
+ * Enqueueing elements while the size of the queue does not exceed
+ * 'capacity' does not allocate memory. A 'capacity' not greater
+ * than the current one does nothing.
+ * 
+ * @param queue [in] pointer to the queue
+ * @param capacity [in] number of elements to make room for
+ * 
+ * @return QUEUE_OK if successful, or
+ * @return QUEUE_FULL if 'capacity' exceeds the bound of a bounded queue, or
+ * @return QUEUE_NO_MEMORY if unsufficient memory for allocation, or
+ * @return QUEUE_NULL if 'queue' is NULL 
+ */
+int queueReserve(PtQueue queue, int capacity);
+
+/**
+ * @brief Releases the memory a queue holds beyond its elements.
+ * 
+ * The bounded implementations keep their fixed capacity.
+ * 
+ * @param queue [in] pointer to the queue
+ * 
+ * @return QUEUE_OK if successful, or
+ * @return QUEUE_NULL if 'queue' is NULL 
+ */
+int queueShrinkToFit(PtQueue queue);
+
+/**
+ * @brief Retrieves the statistics of a queue.
+ * 
+ * Statistics are only recorded when compiled with ADT_STATS
+ * defined (see adtStats.h); otherwise, they are all zero and 
+ * 'enabled' is false.
+ * 
+ * The bounded implementations (see queueConcurrent.h) only record
+ * the memory they allocated, as their operations run concurrently.
+ * 
+ * @param queue [in] pointer to the queue
+ * @param ptStats [out] address of variable to hold the statistics
+ * 
+ * @return QUEUE_OK if successful and statistics in 'ptStats', or
+ * @return QUEUE_NULL if 'queue' is NULL 
+ */
+int queueStats(PtQueue queue, AdtStats *ptStats);
+
 /**
  * @brief Prints the contents of a queue.
  * 
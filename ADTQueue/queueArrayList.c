@@ -18,28 +18,42 @@ typedef struct queueImpl {
 	QueueElem *elements;
 	int capacity;
 	int size;
+	ADT_STATS_MEMBER
 } QueueImpl;
 
+static bool resize(PtQueue queue, int newCapacity) {
+	QueueElem* newArray = (QueueElem*) realloc( queue->elements, 
+								newCapacity * sizeof(QueueElem) );
+	
+	if(newArray == NULL) return false;
+
+	queue->elements = newArray;
+	queue->capacity = newCapacity;
+
+	ADT_STATS_REALLOC(queue->stats, newCapacity * sizeof(QueueElem));
+
+	return true;
+}
+
 static bool ensureCapacity(PtQueue queue) {
 	if (queue->size == queue->capacity) {
-		int newCapacity = queue->capacity * 2;
-		QueueElem* newArray = (QueueElem*) realloc( queue->elements, 
-									newCapacity * sizeof(QueueElem) );
-		
-		if(newArray == NULL) return false;
-
-		queue->elements = newArray;
-		queue->capacity = newCapacity;
+		return resize(queue, queue->capacity * 2);
 	}
 	
 	return true;
 }
 
 PtQueue queueCreate() {
+	return queueCreateWithCapacity(INITIAL_CAPACITY);
+}
+
+PtQueue queueCreateWithCapacity(int capacity) {
+	if (capacity < 1) return NULL;
+
 	PtQueue queue = (PtQueue)malloc(sizeof(QueueImpl));
 	if (queue == NULL) return NULL;
 
-	queue->elements = (QueueElem*)calloc(INITIAL_CAPACITY, 
+	queue->elements = (QueueElem*)calloc(capacity, 
 											sizeof(QueueElem));
 	if (queue->elements == NULL)
 	{
@@ -47,9 +61,12 @@ PtQueue queueCreate() {
 		return NULL;
 	}
 
-	queue->capacity = INITIAL_CAPACITY;
+	queue->capacity = capacity;
 	queue->size = 0;
 
+	ADT_STATS_INIT(queue->stats);
+	ADT_STATS_ALLOC(queue->stats, sizeof(QueueImpl) + capacity * sizeof(QueueElem));
+
 	return queue;
 }
 
@@ -67,10 +84,14 @@ int queueDestroy(PtQueue *ptQueue) {
 int queueEnqueue(PtQueue queue, QueueElem elem) {
 	if (queue == NULL) return QUEUE_NULL;
 
+	ADT_STATS_START(start);
+
 	if(!ensureCapacity(queue)) return QUEUE_NO_MEMORY;
 
 	queue->elements[queue->size++] = elem;
 	
+	ADT_STATS_STOP(queue->stats, ADT_OP_INSERT, start);
+
 	return QUEUE_OK;
 }
 
@@ -81,6 +102,8 @@ int queueDequeue(PtQueue queue, QueueElem *ptElem) {
 		return QUEUE_EMPTY;
 	}
 
+	ADT_STATS_START(start);
+
 	*ptElem = queue->elements[0];
 	
 	for (int i = 0; i < queue->size - 1; i++) {
@@ -89,6 +112,8 @@ int queueDequeue(PtQueue queue, QueueElem *ptElem) {
 
 	queue->size--;
 
+	ADT_STATS_STOP(queue->stats, ADT_OP_REMOVE, start);
+
 	return QUEUE_OK;
 }
 
@@ -97,8 +122,12 @@ int queueFront(PtQueue queue, QueueElem *ptElem) {
 
 	if (queueIsEmpty(queue)) return QUEUE_EMPTY;
 
+	ADT_STATS_START(start);
+
 	*ptElem = queue->elements[0];
 
+	ADT_STATS_STOP(queue->stats, ADT_OP_LOOKUP, start);
+
 	return QUEUE_OK;
 }
 
@@ -125,11 +154,51 @@ int queueClear(PtQueue queue) {
 	if(queue->capacity > INITIAL_CAPACITY) {
 		queue->elements = (QueueElem*)realloc(queue->elements, INITIAL_CAPACITY * sizeof(QueueElem));
 		queue->capacity = INITIAL_CAPACITY;
+
+		ADT_STATS_REALLOC(queue->stats, INITIAL_CAPACITY * sizeof(QueueElem));
 	}
 
 	return QUEUE_OK;
 }
 
+int queueClearRetain(PtQueue queue) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	queue->size = 0;
+
+	return QUEUE_OK;
+}
+
+int queueReserve(PtQueue queue, int capacity) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	if (capacity > queue->capacity && !resize(queue, capacity)) {
+		return QUEUE_NO_MEMORY;
+	}
+
+	return QUEUE_OK;
+}
+
+int queueShrinkToFit(PtQueue queue) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	/* keep room for one element, so that the capacity can double */
+	int newCapacity = (queue->size > 0) ? queue->size : 1;
+
+	/* shrinking in place should not fail; if it does, keep the array */
+	if (newCapacity < queue->capacity) resize(queue, newCapacity);
+
+	return QUEUE_OK;
+}
+
+int queueStats(PtQueue queue, AdtStats *ptStats) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	ADT_STATS_COPY(queue->stats, ptStats);
+
+	return QUEUE_OK;
+}
+
 void queuePrint(PtQueue queue) {
 	if (queue == NULL) {
 		printf("(Queue NULL) \n");
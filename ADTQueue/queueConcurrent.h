@@ -0,0 +1,68 @@
+/**
+ * @file queueConcurrent.h
+ * @brief Additional operations of the bounded, thread-safe 
+ * implementations of the ADT Queue.
+ * 
+ * These implementations (queueSpsc.c and queueMpmc.c) provide all 
+ * operations of queue.h over a fixed-capacity ring buffer, using
+ * atomic operations instead of locks:
+ * 
+ * - queueSpsc.c supports exactly one producer thread (enqueueing)
+ *   and one consumer thread (dequeueing and peeking) at a time;
+ * - queueMpmc.c supports any number of producer and consumer threads.
+ * 
+ * queueEnqueue waits (yielding the processor) while the queue is full,
+ * whereas queueDequeue does not wait and returns QUEUE_EMPTY, as specified 
+ * in queue.h. The "try" variants below never wait.
+ * 
+ * queueSize and queueIsEmpty may be called by any thread, but only
+ * return a snapshot. queueClear, queueClearRetain, queuePrint and
+ * queueDestroy must not run concurrently with any other operation on
+ * the same queue; neither must queueFront of queueMpmc.c run 
+ * concurrently with consumers.
+ * 
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#pragma once
+
+#include "queue.h"
+
+/** Capacity of the queues created by queueCreate. */
+#define QUEUE_DEFAULT_BOUND 1024
+
+/**
+ * @brief Creates a new empty queue with a fixed capacity.
+ * 
+ * @param capacity [in] maximum number of elements, rounded
+ * up to a power of two
+ * 
+ * @return PtQueue pointer to allocated data structure, or
+ * @return NULL if 'capacity' < 1 or unsufficient memory for allocation
+ */
+PtQueue queueCreateBounded(int capacity);
+
+/**
+ * @brief Enqueue an element in a queue, if it is not full.
+ * 
+ * @param queue [in] pointer to the queue
+ * @param elem  [in] element to enqueue
+ * 
+ * @return QUEUE_OK if successful, or
+ * @return QUEUE_FULL if the queue is full, or
+ * @return QUEUE_NULL if 'queue' is NULL 
+ */
+int queueTryEnqueue(PtQueue queue, QueueElem elem);
+
+/**
+ * @brief Dequeue the element in front of a queue, if it is not empty.
+ * 
+ * @param queue [in] pointer to the queue
+ * @param ptElem [out] address of variable to hold the value
+ * 
+ * @return QUEUE_OK if successful and value in 'ptElem', or
+ * @return QUEUE_EMPTY if the queue is empty, or
+ * @return QUEUE_NULL if 'queue' is NULL 
+ */
+int queueTryDequeue(PtQueue queue, QueueElem *ptElem);
@@ -10,6 +10,7 @@
  */
 
 #include "queue.h" 
+#include "nodePool.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -26,6 +27,8 @@ typedef struct queueImpl {
 	PtNode header;
 	PtNode trailer;
 	int size;
+	PtNodePool pool;	/* allocator of the element nodes */
+	ADT_STATS_MEMBER
 } QueueImpl;
 
 
@@ -45,6 +48,14 @@ PtQueue queueCreate() {
 		return NULL;
 	}
 
+	newQueue->pool = nodePoolCreate(sizeof(Node));
+	if (newQueue->pool == NULL) {
+		free(newQueue->trailer);
+		free(newQueue->header);
+		free(newQueue);
+		return NULL;
+	}
+
 	newQueue->header->prev = NULL;
 	newQueue->header->next = newQueue->trailer;
 
@@ -53,21 +64,35 @@ PtQueue queueCreate() {
 
 	newQueue->size = 0;
 
+	ADT_STATS_INIT(newQueue->stats);
+	ADT_STATS_ALLOC(newQueue->stats, sizeof(QueueImpl) + 2 * sizeof(Node));
+
 	return newQueue;
 }
 
+PtQueue queueCreateWithCapacity(int capacity) {
+	if (capacity < 1) return NULL;
+
+	PtQueue queue = queueCreate();
+	if (queue == NULL) return NULL;
+
+	if (queueReserve(queue, capacity) != QUEUE_OK) {
+		queueDestroy(&queue);
+		return NULL;
+	}
+
+	return queue;
+}
+
 int queueDestroy(PtQueue *ptQueue) {
 	PtQueue queue = *ptQueue;
 	if (queue == NULL) { return QUEUE_NULL;	}
 
-	/* This algorithm free all nodes including sentinels */
-	PtNode current = queue->header;
-	while (current != NULL) {
-		PtNode remove = current;
-		current = current->next;
-		free(remove);
-	}
+	/* element nodes are released with their pool */
+	nodePoolDestroy(&queue->pool);
 
+	free(queue->header);
+	free(queue->trailer);
 	free(queue);
 
 	*ptQueue = NULL;
@@ -78,7 +103,9 @@ int queueDestroy(PtQueue *ptQueue) {
 int queueEnqueue(PtQueue queue, QueueElem elem) {
 	if (queue == NULL) {return QUEUE_NULL;	}
 
-	PtNode newEnd = (PtNode)malloc(sizeof(Node));
+	ADT_STATS_START(start);
+
+	PtNode newEnd = (PtNode)nodePoolAlloc(queue->pool);
 	if (newEnd == NULL) return QUEUE_NO_MEMORY;
 
 	PtNode curEnd = queue->trailer->prev;
@@ -92,6 +119,8 @@ int queueEnqueue(PtQueue queue, QueueElem elem) {
 
 	queue->size++;
 
+	ADT_STATS_STOP(queue->stats, ADT_OP_INSERT, start);
+
 	return QUEUE_OK;
 }
 
@@ -100,6 +129,8 @@ int queueDequeue(PtQueue queue, QueueElem *ptElem) {
 
 	if (queueIsEmpty(queue)) {return QUEUE_EMPTY;	}
 
+	ADT_STATS_START(start);
+
 	PtNode curFront = queue->header->next;
 	PtNode newFront = curFront->next; 
 
@@ -108,10 +139,12 @@ int queueDequeue(PtQueue queue, QueueElem *ptElem) {
 	queue->header->next = newFront;
 	newFront->prev = queue->header;
 	
-	free(curFront);
+	nodePoolFree(queue->pool, curFront);
 
 	queue->size--;
 
+	ADT_STATS_STOP(queue->stats, ADT_OP_REMOVE, start);
+
 	return QUEUE_OK;
 }
 
@@ -120,9 +153,13 @@ int queueFront(PtQueue queue, QueueElem *ptElem) {
 
 	if (queueIsEmpty(queue)) {	return QUEUE_EMPTY;	}
 
+	ADT_STATS_START(start);
+
 	PtNode curFront = queue->header->next;
 	*ptElem = curFront->element;
 	
+	ADT_STATS_STOP(queue->stats, ADT_OP_LOOKUP, start);
+
 	return QUEUE_OK;
 }
 
@@ -143,11 +180,65 @@ bool queueIsEmpty(PtQueue queue) {
 int queueClear(PtQueue queue) {
 	if (queue == NULL) return QUEUE_NULL;
 	
-	/* Can leverage queueDequeue to free nodes 
-		and decrement size */
-	QueueElem elem;
-	while (!queueIsEmpty(queue)) {
-		queueDequeue(queue, &elem);
+	/* release all element nodes at once */
+	nodePoolReset(queue->pool);
+
+	queue->header->next = queue->trailer;
+	queue->trailer->prev = queue->header;
+
+	queue->size = 0;
+
+	return QUEUE_OK;
+}
+
+int queueClearRetain(PtQueue queue) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	/* return the nodes to the pool, which keeps their memory */
+	PtNode current = queue->header->next;
+	while (current != queue->trailer) {
+		PtNode next = current->next;
+		nodePoolFree(queue->pool, current);
+		current = next;
+	}
+
+	queue->header->next = queue->trailer;
+	queue->trailer->prev = queue->header;
+
+	queue->size = 0;
+
+	return QUEUE_OK;
+}
+
+int queueReserve(PtQueue queue, int capacity) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	if (capacity > queue->size &&
+		nodePoolReserve(queue->pool, capacity - queue->size) != NODEPOOL_OK) {
+		return QUEUE_NO_MEMORY;
+	}
+
+	return QUEUE_OK;
+}
+
+int queueShrinkToFit(PtQueue queue) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	/* nodes in use may be spread over all chunks of the pool,
+	   so memory can only be released when there are none */
+	if (queue->size == 0) nodePoolReset(queue->pool);
+
+	return QUEUE_OK;
+}
+
+int queueStats(PtQueue queue, AdtStats *ptStats) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	ADT_STATS_COPY(queue->stats, ptStats);
+
+	/* the nodes of the elements are allocated by the pool */
+	if (ptStats->enabled) {
+		ptStats->bytesAllocated += nodePoolBytesAllocated(queue->pool);
 	}
 
 	return QUEUE_OK;
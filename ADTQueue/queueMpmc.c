@@ -0,0 +1,263 @@
+/**
+ * @file queueMpmc.c
+ *
+ * @brief Provides a bounded, lock-free implementation of the ADT Queue
+ * for any number of producer and consumer threads (MPMC).
+ *
+ * This is the bounded queue of Dmitry Vyukov: each cell of a ring
+ * buffer carries a sequence number telling whether it is ready to be
+ * written (sequence == position) or read (sequence == position + 1) in
+ * the current lap. Producers and consumers claim positions by a CAS on
+ * 'enqueuePos' or 'dequeuePos', then publish the cell by storing the
+ * sequence number of the next phase with release semantics.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "queueConcurrent.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <sched.h>
+
+#define CACHE_LINE_SIZE 64
+
+typedef struct cell {
+	atomic_size_t sequence;
+	QueueElem element;
+} Cell;
+
+typedef struct queueImpl {
+	_Alignas(CACHE_LINE_SIZE) atomic_size_t enqueuePos;
+	_Alignas(CACHE_LINE_SIZE) atomic_size_t dequeuePos;
+
+	/* read-only after creation */
+	_Alignas(CACHE_LINE_SIZE) Cell *cells;
+	size_t capacity;			/* power of two */
+	ADT_STATS_MEMBER			/* only memory, see queueStats */
+} QueueImpl;
+
+PtQueue queueCreateBounded(int capacity) {
+	if (capacity < 1) return NULL;
+
+	size_t roundedCapacity = 1;
+	while (roundedCapacity < (size_t)capacity) roundedCapacity *= 2;
+
+	PtQueue queue = (PtQueue)aligned_alloc(CACHE_LINE_SIZE, sizeof(QueueImpl));
+	if (queue == NULL) return NULL;
+
+	queue->cells = (Cell*)malloc(roundedCapacity * sizeof(Cell));
+	if (queue->cells == NULL) {
+		free(queue);
+		return NULL;
+	}
+
+	queue->capacity = roundedCapacity;
+	for (size_t i = 0; i < roundedCapacity; i++) {
+		atomic_init(&queue->cells[i].sequence, i);
+	}
+	atomic_init(&queue->enqueuePos, 0);
+	atomic_init(&queue->dequeuePos, 0);
+
+	ADT_STATS_INIT(queue->stats);
+	ADT_STATS_ALLOC(queue->stats, sizeof(QueueImpl) + roundedCapacity * sizeof(Cell));
+
+	return queue;
+}
+
+PtQueue queueCreate() {
+	return queueCreateBounded(QUEUE_DEFAULT_BOUND);
+}
+
+PtQueue queueCreateWithCapacity(int capacity) {
+	return queueCreateBounded(capacity);
+}
+
+int queueDestroy(PtQueue *ptQueue) {
+	PtQueue queue = *ptQueue;
+	if (queue == NULL) return QUEUE_NULL;
+
+	free(queue->cells);
+	free(queue);
+	*ptQueue = NULL;
+
+	return QUEUE_OK;
+}
+
+int queueTryEnqueue(PtQueue queue, QueueElem elem) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	Cell *cell;
+	size_t pos = atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed);
+
+	while (true) {
+		cell = &queue->cells[pos & (queue->capacity - 1)];
+		size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+		intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+
+		if (diff == 0) {
+			/* cell is free in this lap: try to claim the position */
+			if (atomic_compare_exchange_weak_explicit(&queue->enqueuePos, &pos, pos + 1,
+					memory_order_relaxed, memory_order_relaxed)) {
+				break;
+			}
+		}
+		else if (diff < 0) {
+			return QUEUE_FULL; /* cell still holds an element of the previous lap */
+		}
+		else {
+			pos = atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed);
+		}
+	}
+
+	cell->element = elem;
+	atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+
+	return QUEUE_OK;
+}
+
+int queueTryDequeue(PtQueue queue, QueueElem *ptElem) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	Cell *cell;
+	size_t pos = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed);
+
+	while (true) {
+		cell = &queue->cells[pos & (queue->capacity - 1)];
+		size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+		intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+
+		if (diff == 0) {
+			/* cell was published in this lap: try to claim the position */
+			if (atomic_compare_exchange_weak_explicit(&queue->dequeuePos, &pos, pos + 1,
+					memory_order_relaxed, memory_order_relaxed)) {
+				break;
+			}
+		}
+		else if (diff < 0) {
+			return QUEUE_EMPTY; /* cell not yet written in this lap */
+		}
+		else {
+			pos = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed);
+		}
+	}
+
+	*ptElem = cell->element;
+	/* make the cell writable in the next lap */
+	atomic_store_explicit(&cell->sequence, pos + queue->capacity, memory_order_release);
+
+	return QUEUE_OK;
+}
+
+int queueEnqueue(PtQueue queue, QueueElem elem) {
+	int result;
+	while ((result = queueTryEnqueue(queue, elem)) == QUEUE_FULL) {
+		sched_yield(); /* wait for consumers */
+	}
+	return result;
+}
+
+int queueDequeue(PtQueue queue, QueueElem *ptElem) {
+	return queueTryDequeue(queue, ptElem);
+}
+
+int queueFront(PtQueue queue, QueueElem *ptElem) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	size_t pos = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed);
+	Cell *cell = &queue->cells[pos & (queue->capacity - 1)];
+
+	if (atomic_load_explicit(&cell->sequence, memory_order_acquire) != pos + 1) {
+		return QUEUE_EMPTY;
+	}
+
+	*ptElem = cell->element;
+
+	return QUEUE_OK;
+}
+
+int queueSize(PtQueue queue, int *ptSize) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	/* 'dequeuePos' first: 'enqueuePos' read afterwards can only be ahead of it */
+	size_t dequeuePos = atomic_load_explicit(&queue->dequeuePos, memory_order_acquire);
+	size_t enqueuePos = atomic_load_explicit(&queue->enqueuePos, memory_order_acquire);
+
+	size_t size = enqueuePos - dequeuePos;
+	*ptSize = (int)(size > queue->capacity ? queue->capacity : size);
+
+	return QUEUE_OK;
+}
+
+bool queueIsEmpty(PtQueue queue) {
+	if (queue == NULL) return true;
+
+	int size;
+	queueSize(queue, &size);
+
+	return (size == 0);
+}
+
+int queueClear(PtQueue queue) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	for (size_t i = 0; i < queue->capacity; i++) {
+		atomic_store(&queue->cells[i].sequence, i);
+	}
+	atomic_store(&queue->enqueuePos, 0);
+	atomic_store(&queue->dequeuePos, 0);
+
+	return QUEUE_OK;
+}
+
+int queueClearRetain(PtQueue queue) {
+	/* the buffer is never reallocated */
+	return queueClear(queue);
+}
+
+int queueReserve(PtQueue queue, int capacity) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	/* the capacity is fixed at creation */
+	if (capacity > 0 && (size_t)capacity > queue->capacity) return QUEUE_FULL;
+
+	return QUEUE_OK;
+}
+
+int queueShrinkToFit(PtQueue queue) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	/* the capacity is fixed at creation */
+	return QUEUE_OK;
+}
+
+int queueStats(PtQueue queue, AdtStats *ptStats) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	/* operations are not counted, as threads would race on the counters */
+	ADT_STATS_COPY(queue->stats, ptStats);
+
+	return QUEUE_OK;
+}
+
+void queuePrint(PtQueue queue) {
+	if (queue == NULL) {
+		printf("(Queue NULL) \n");
+	}
+	else if (queueIsEmpty(queue)) {
+		printf("(Queue Empty) \n");
+	}
+	else {
+		size_t dequeuePos = atomic_load(&queue->dequeuePos);
+		size_t enqueuePos = atomic_load(&queue->enqueuePos);
+
+		printf("Queue contents (front to end): \n");
+		for (size_t i = dequeuePos; i != enqueuePos; i++) {
+			queueElemPrint(queue->cells[i & (queue->capacity - 1)].element);
+			printf(" ");
+		}
+		printf("\n------------------------------ \n");
+	}
+}
@@ -0,0 +1,259 @@
+/**
+ * @file queueRingBuffer.c
+ *
+ * @brief Provides an implementation of the ADT Queue with a
+ * circular array (ring buffer) as the underlying data structure.
+ *
+ * The front of the queue is at index 'head' and the elements occupy
+ * 'size' consecutive positions, wrapping around the end of the array.
+ * Both enqueue and dequeue are O(1), as no elements are shifted.
+ * The capacity is always a power of two, so wrapping an index is a
+ * bitwise AND with 'capacity - 1'.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "queue.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Must be a power of two. */
+#define INITIAL_CAPACITY 16
+
+typedef struct queueImpl {
+	QueueElem *elements;
+	int capacity;
+	int head;	/* index of the front element */
+	int size;
+	ADT_STATS_MEMBER
+} QueueImpl;
+
+/** Smallest power of two not less than 'n' (> 0). */
+static int roundUpPowerOfTwo(int n) {
+	int power = 1;
+	while (power < n) power *= 2;
+	return power;
+}
+
+/** Grows the array to 'newCapacity', a power of two >= 2 * capacity. */
+static bool grow(PtQueue queue, int newCapacity) {
+	int oldCapacity = queue->capacity;
+	QueueElem* newArray = (QueueElem*) realloc( queue->elements,
+								newCapacity * sizeof(QueueElem) );
+
+	if(newArray == NULL) return false;
+
+	/* elements [0, wrapped) wrapped around, so they move right after 
+	   the old end to become contiguous again */
+	int wrapped = queue->head + queue->size - oldCapacity;
+	if (wrapped > 0) {
+		memcpy(newArray + oldCapacity, newArray, wrapped * sizeof(QueueElem));
+	}
+
+	queue->elements = newArray;
+	queue->capacity = newCapacity;
+
+	ADT_STATS_REALLOC(queue->stats, newCapacity * sizeof(QueueElem));
+
+	return true;
+}
+
+static bool ensureCapacity(PtQueue queue) {
+	if (queue->size == queue->capacity) {
+		return grow(queue, queue->capacity * 2);
+	}
+
+	return true;
+}
+
+PtQueue queueCreate() {
+	return queueCreateWithCapacity(INITIAL_CAPACITY);
+}
+
+PtQueue queueCreateWithCapacity(int capacity) {
+	if (capacity < 1) return NULL;
+
+	capacity = roundUpPowerOfTwo(capacity);
+
+	PtQueue queue = (PtQueue)malloc(sizeof(QueueImpl));
+	if (queue == NULL) return NULL;
+
+	queue->elements = (QueueElem*)calloc(capacity,
+											sizeof(QueueElem));
+	if (queue->elements == NULL)
+	{
+		free(queue);
+		return NULL;
+	}
+
+	queue->capacity = capacity;
+	queue->head = 0;
+	queue->size = 0;
+
+	ADT_STATS_INIT(queue->stats);
+	ADT_STATS_ALLOC(queue->stats, sizeof(QueueImpl) + capacity * sizeof(QueueElem));
+
+	return queue;
+}
+
+int queueDestroy(PtQueue *ptQueue) {
+	PtQueue queue = *ptQueue;
+	if (queue == NULL) return QUEUE_NULL;
+
+	free(queue->elements);
+	free(queue);
+	*ptQueue = NULL;
+
+	return QUEUE_OK;
+}
+
+int queueEnqueue(PtQueue queue, QueueElem elem) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	ADT_STATS_START(start);
+
+	if(!ensureCapacity(queue)) return QUEUE_NO_MEMORY;
+
+	int tail = (queue->head + queue->size) & (queue->capacity - 1);
+	queue->elements[tail] = elem;
+	queue->size++;
+
+	ADT_STATS_STOP(queue->stats, ADT_OP_INSERT, start);
+
+	return QUEUE_OK;
+}
+
+int queueDequeue(PtQueue queue, QueueElem *ptElem) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	if (queueIsEmpty(queue)) {
+		return QUEUE_EMPTY;
+	}
+
+	ADT_STATS_START(start);
+
+	*ptElem = queue->elements[queue->head];
+
+	queue->head = (queue->head + 1) & (queue->capacity - 1);
+	queue->size--;
+
+	ADT_STATS_STOP(queue->stats, ADT_OP_REMOVE, start);
+
+	return QUEUE_OK;
+}
+
+int queueFront(PtQueue queue, QueueElem *ptElem) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	if (queueIsEmpty(queue)) return QUEUE_EMPTY;
+
+	ADT_STATS_START(start);
+
+	*ptElem = queue->elements[queue->head];
+
+	ADT_STATS_STOP(queue->stats, ADT_OP_LOOKUP, start);
+
+	return QUEUE_OK;
+}
+
+int queueSize(PtQueue queue, int *ptSize) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	*ptSize = queue->size;
+
+	return QUEUE_OK;
+}
+
+bool queueIsEmpty(PtQueue queue) {
+	if (queue == NULL) return true;
+
+	return (queue->size == 0);
+}
+
+int queueClear(PtQueue queue) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	queue->head = 0;
+	queue->size = 0;
+
+	// Housekeeping. Array can be very large at this point, realloc to initial size
+	if(queue->capacity > INITIAL_CAPACITY) {
+		queue->elements = (QueueElem*)realloc(queue->elements, INITIAL_CAPACITY * sizeof(QueueElem));
+		queue->capacity = INITIAL_CAPACITY;
+
+		ADT_STATS_REALLOC(queue->stats, INITIAL_CAPACITY * sizeof(QueueElem));
+	}
+
+	return QUEUE_OK;
+}
+
+int queueClearRetain(PtQueue queue) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	queue->head = 0;
+	queue->size = 0;
+
+	return QUEUE_OK;
+}
+
+int queueReserve(PtQueue queue, int capacity) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	if (capacity > queue->capacity && !grow(queue, roundUpPowerOfTwo(capacity))) {
+		return QUEUE_NO_MEMORY;
+	}
+
+	return QUEUE_OK;
+}
+
+int queueShrinkToFit(PtQueue queue) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	int newCapacity = roundUpPowerOfTwo(queue->size > 0 ? queue->size : 1);
+	if (newCapacity >= queue->capacity) return QUEUE_OK;
+
+	/* the elements may wrap around: copy them in order to a new array */
+	QueueElem *newArray = (QueueElem*)malloc(newCapacity * sizeof(QueueElem));
+	if (newArray == NULL) return QUEUE_OK; /* keep the current array */
+
+	for (int i = 0; i < queue->size; i++) {
+		newArray[i] = queue->elements[(queue->head + i) & (queue->capacity - 1)];
+	}
+
+	free(queue->elements);
+	queue->elements = newArray;
+	queue->capacity = newCapacity;
+	queue->head = 0;
+
+	ADT_STATS_REALLOC(queue->stats, newCapacity * sizeof(QueueElem));
+
+	return QUEUE_OK;
+}
+
+int queueStats(PtQueue queue, AdtStats *ptStats) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	ADT_STATS_COPY(queue->stats, ptStats);
+
+	return QUEUE_OK;
+}
+
+void queuePrint(PtQueue queue) {
+	if (queue == NULL) {
+		printf("(Queue NULL) \n");
+	}
+	else if (queue->size == 0) {
+		printf("(Queue Empty) \n");
+	}
+	else {
+		printf("Queue contents (front to end): \n");
+		for (int i = 0; i < queue->size; i++) {
+			int index = (queue->head + i) & (queue->capacity - 1);
+			queueElemPrint(queue->elements[index]);
+			printf(" ");
+		}
+		printf("\n------------------------------ \n");
+	}
+}
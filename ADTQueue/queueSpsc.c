@@ -0,0 +1,228 @@
+/**
+ * @file queueSpsc.c
+ *
+ * @brief Provides a bounded, lock-free implementation of the ADT Queue
+ * for one producer thread and one consumer thread (SPSC).
+ *
+ * The elements are kept in a ring buffer. The producer only writes
+ * 'tail' and the consumer only writes 'head', so both operations are
+ * wait-free: a release store publishes an element (or a free position)
+ * and the matching acquire load of the other side observes it.
+ * Each side keeps a cached copy of the other side's index, and only
+ * reloads it when the queue appears full (or empty); the indexes live
+ * on separate cache lines to avoid false sharing.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "queueConcurrent.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <sched.h>
+
+#define CACHE_LINE_SIZE 64
+
+typedef struct queueImpl {
+	/* written by the consumer */
+	_Alignas(CACHE_LINE_SIZE) atomic_size_t head;
+	size_t cachedTail;			/* consumer's copy of 'tail' */
+
+	/* written by the producer */
+	_Alignas(CACHE_LINE_SIZE) atomic_size_t tail;
+	size_t cachedHead;			/* producer's copy of 'head' */
+
+	/* read-only after creation */
+	_Alignas(CACHE_LINE_SIZE) QueueElem *elements;
+	size_t capacity;			/* power of two */
+	ADT_STATS_MEMBER			/* only memory, see queueStats */
+} QueueImpl;
+
+PtQueue queueCreateBounded(int capacity) {
+	if (capacity < 1) return NULL;
+
+	size_t roundedCapacity = 1;
+	while (roundedCapacity < (size_t)capacity) roundedCapacity *= 2;
+
+	PtQueue queue = (PtQueue)aligned_alloc(CACHE_LINE_SIZE, sizeof(QueueImpl));
+	if (queue == NULL) return NULL;
+
+	queue->elements = (QueueElem*)calloc(roundedCapacity, sizeof(QueueElem));
+	if (queue->elements == NULL) {
+		free(queue);
+		return NULL;
+	}
+
+	queue->capacity = roundedCapacity;
+	atomic_init(&queue->head, 0);
+	atomic_init(&queue->tail, 0);
+	queue->cachedHead = 0;
+	queue->cachedTail = 0;
+
+	ADT_STATS_INIT(queue->stats);
+	ADT_STATS_ALLOC(queue->stats, sizeof(QueueImpl) + roundedCapacity * sizeof(QueueElem));
+
+	return queue;
+}
+
+PtQueue queueCreate() {
+	return queueCreateBounded(QUEUE_DEFAULT_BOUND);
+}
+
+PtQueue queueCreateWithCapacity(int capacity) {
+	return queueCreateBounded(capacity);
+}
+
+int queueDestroy(PtQueue *ptQueue) {
+	PtQueue queue = *ptQueue;
+	if (queue == NULL) return QUEUE_NULL;
+
+	free(queue->elements);
+	free(queue);
+	*ptQueue = NULL;
+
+	return QUEUE_OK;
+}
+
+int queueTryEnqueue(PtQueue queue, QueueElem elem) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+	if (tail - queue->cachedHead == queue->capacity) {
+		queue->cachedHead = atomic_load_explicit(&queue->head, memory_order_acquire);
+		if (tail - queue->cachedHead == queue->capacity) return QUEUE_FULL;
+	}
+
+	queue->elements[tail & (queue->capacity - 1)] = elem;
+	atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+
+	return QUEUE_OK;
+}
+
+int queueTryDequeue(PtQueue queue, QueueElem *ptElem) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+	if (head == queue->cachedTail) {
+		queue->cachedTail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+		if (head == queue->cachedTail) return QUEUE_EMPTY;
+	}
+
+	*ptElem = queue->elements[head & (queue->capacity - 1)];
+	atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+
+	return QUEUE_OK;
+}
+
+int queueEnqueue(PtQueue queue, QueueElem elem) {
+	int result;
+	while ((result = queueTryEnqueue(queue, elem)) == QUEUE_FULL) {
+		sched_yield(); /* wait for the consumer */
+	}
+	return result;
+}
+
+int queueDequeue(PtQueue queue, QueueElem *ptElem) {
+	return queueTryDequeue(queue, ptElem);
+}
+
+int queueFront(PtQueue queue, QueueElem *ptElem) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+	if (head == queue->cachedTail) {
+		queue->cachedTail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+		if (head == queue->cachedTail) return QUEUE_EMPTY;
+	}
+
+	*ptElem = queue->elements[head & (queue->capacity - 1)];
+
+	return QUEUE_OK;
+}
+
+int queueSize(PtQueue queue, int *ptSize) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	/* 'head' first: 'tail' read afterwards can only be ahead of it */
+	size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+	size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+
+	size_t size = tail - head;
+	*ptSize = (int)(size > queue->capacity ? queue->capacity : size);
+
+	return QUEUE_OK;
+}
+
+bool queueIsEmpty(PtQueue queue) {
+	if (queue == NULL) return true;
+
+	int size;
+	queueSize(queue, &size);
+
+	return (size == 0);
+}
+
+int queueClear(PtQueue queue) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	atomic_store(&queue->head, 0);
+	atomic_store(&queue->tail, 0);
+	queue->cachedHead = 0;
+	queue->cachedTail = 0;
+
+	return QUEUE_OK;
+}
+
+int queueClearRetain(PtQueue queue) {
+	/* the buffer is never reallocated */
+	return queueClear(queue);
+}
+
+int queueReserve(PtQueue queue, int capacity) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	/* the capacity is fixed at creation */
+	if (capacity > 0 && (size_t)capacity > queue->capacity) return QUEUE_FULL;
+
+	return QUEUE_OK;
+}
+
+int queueShrinkToFit(PtQueue queue) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	/* the capacity is fixed at creation */
+	return QUEUE_OK;
+}
+
+int queueStats(PtQueue queue, AdtStats *ptStats) {
+	if (queue == NULL) return QUEUE_NULL;
+
+	/* operations are not counted, as threads would race on the counters */
+	ADT_STATS_COPY(queue->stats, ptStats);
+
+	return QUEUE_OK;
+}
+
+void queuePrint(PtQueue queue) {
+	if (queue == NULL) {
+		printf("(Queue NULL) \n");
+	}
+	else if (queueIsEmpty(queue)) {
+		printf("(Queue Empty) \n");
+	}
+	else {
+		size_t head = atomic_load(&queue->head);
+		size_t tail = atomic_load(&queue->tail);
+
+		printf("Queue contents (front to end): \n");
+		for (size_t i = head; i != tail; i++) {
+			queueElemPrint(queue->elements[i & (queue->capacity - 1)]);
+			printf(" ");
+		}
+		printf("\n------------------------------ \n");
+	}
+}
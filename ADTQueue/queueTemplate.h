@@ -0,0 +1,179 @@
+/**
+ * @file queueTemplate.h
+ * @brief Generic, type-specialized version of the ADT Queue
+ * with a circular array (ring buffer) as the underlying data structure.
+ *
+ * DEFINE_QUEUE(Name, T) defines a queue of elements of type T,
+ * unboxed, as the type 'Name' and the functions 'Name##Create',
+ * 'Name##Enqueue', etc., with the same semantics and error codes as the
+ * operations of queue.h (see queueRingBuffer.c). The functions are
+ * 'static inline', so each translation unit may define several
+ * queues, of different types, without changing queueElem.h.
+ *
+ * Example:
+ *
+ *     DEFINE_QUEUE(CharQueue, char)
+ *
+ *     CharQueue queue = CharQueueCreate();
+ *     CharQueueEnqueue(queue, 'a');
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/* same values as in queue.h */
+#define QUEUE_OK            0
+#define QUEUE_NULL          1
+#define QUEUE_NO_MEMORY     2
+#define QUEUE_EMPTY         3
+#define QUEUE_FULL          4
+
+/** Must be a power of two. */
+#define QUEUE_TEMPLATE_INITIAL_CAPACITY 16
+
+/**
+ * @brief Defines the type 'Name', a queue of elements of type 'T',
+ * and its operations.
+ *
+ * @param Name name of the queue type, also the prefix of its operations
+ * @param T type of the elements
+ */
+#define DEFINE_QUEUE(Name, T)                                                   \
+                                                                                \
+typedef struct Name##Impl {                                                     \
+	T *elements;                                                                \
+	int capacity;                                                               \
+	int head;	/* index of the front element */                                \
+	int size;                                                                   \
+} Name##Impl;                                                                   \
+                                                                                \
+typedef Name##Impl *Name;                                                       \
+                                                                                \
+static inline Name Name##Create(void) {                                         \
+	Name queue = (Name)malloc(sizeof(Name##Impl));                              \
+	if (queue == NULL) return NULL;                                             \
+                                                                                \
+	queue->elements = (T*)malloc(QUEUE_TEMPLATE_INITIAL_CAPACITY * sizeof(T));  \
+	if (queue->elements == NULL) {                                              \
+		free(queue);                                                            \
+		return NULL;                                                            \
+	}                                                                           \
+                                                                                \
+	queue->capacity = QUEUE_TEMPLATE_INITIAL_CAPACITY;                          \
+	queue->head = 0;                                                            \
+	queue->size = 0;                                                            \
+                                                                                \
+	return queue;                                                               \
+}                                                                               \
+                                                                                \
+static inline int Name##Destroy(Name *ptQueue) {                                \
+	Name queue = *ptQueue;                                                      \
+	if (queue == NULL) return QUEUE_NULL;                                       \
+                                                                                \
+	free(queue->elements);                                                      \
+	free(queue);                                                                \
+	*ptQueue = NULL;                                                            \
+                                                                                \
+	return QUEUE_OK;                                                            \
+}                                                                               \
+                                                                                \
+static inline int Name##Enqueue(Name queue, T elem) {                           \
+	if (queue == NULL) return QUEUE_NULL;                                       \
+                                                                                \
+	if (queue->size == queue->capacity) {                                       \
+		int oldCapacity = queue->capacity;                                      \
+		T *newArray = (T*)realloc(queue->elements, 2 * oldCapacity * sizeof(T)); \
+		if (newArray == NULL) return QUEUE_NO_MEMORY;                           \
+                                                                                \
+		/* elements [0, head) wrapped around: move them after the old end */    \
+		memcpy(newArray + oldCapacity, newArray, queue->head * sizeof(T));      \
+                                                                                \
+		queue->elements = newArray;                                             \
+		queue->capacity = 2 * oldCapacity;                                      \
+	}                                                                           \
+                                                                                \
+	int tail = (queue->head + queue->size) & (queue->capacity - 1);             \
+	queue->elements[tail] = elem;                                               \
+	queue->size++;                                                              \
+                                                                                \
+	return QUEUE_OK;                                                            \
+}                                                                               \
+                                                                                \
+static inline int Name##Dequeue(Name queue, T *ptElem) {                        \
+	if (queue == NULL) return QUEUE_NULL;                                       \
+	if (queue->size == 0) return QUEUE_EMPTY;                                   \
+                                                                                \
+	*ptElem = queue->elements[queue->head];                                     \
+                                                                                \
+	queue->head = (queue->head + 1) & (queue->capacity - 1);                    \
+	queue->size--;                                                              \
+                                                                                \
+	return QUEUE_OK;                                                            \
+}                                                                               \
+                                                                                \
+static inline int Name##Front(Name queue, T *ptElem) {                          \
+	if (queue == NULL) return QUEUE_NULL;                                       \
+	if (queue->size == 0) return QUEUE_EMPTY;                                   \
+                                                                                \
+	*ptElem = queue->elements[queue->head];                                     \
+                                                                                \
+	return QUEUE_OK;                                                            \
+}                                                                               \
+                                                                                \
+static inline int Name##Size(Name queue, int *ptSize) {                         \
+	if (queue == NULL) return QUEUE_NULL;                                       \
+                                                                                \
+	*ptSize = queue->size;                                                      \
+                                                                                \
+	return QUEUE_OK;                                                            \
+}                                                                               \
+                                                                                \
+static inline bool Name##IsEmpty(Name queue) {                                  \
+	if (queue == NULL) return true;                                             \
+                                                                                \
+	return (queue->size == 0);                                                  \
+}                                                                               \
+                                                                                \
+static inline int Name##Clear(Name queue) {                                     \
+	if (queue == NULL) return QUEUE_NULL;                                       \
+                                                                                \
+	queue->head = 0;                                                            \
+	queue->size = 0;                                                            \
+                                                                                \
+	/* housekeeping: the array can be very large, shrink to initial size */     \
+	if (queue->capacity > QUEUE_TEMPLATE_INITIAL_CAPACITY) {                    \
+		T *newArray = (T*)realloc(queue->elements,                              \
+							QUEUE_TEMPLATE_INITIAL_CAPACITY * sizeof(T));       \
+		if (newArray != NULL) {                                                 \
+			queue->elements = newArray;                                         \
+			queue->capacity = QUEUE_TEMPLATE_INITIAL_CAPACITY;                  \
+		}                                                                       \
+	}                                                                           \
+                                                                                \
+	return QUEUE_OK;                                                            \
+}                                                                               \
+                                                                                \
+/* prints from front to end, with 'elemPrint' printing each element */          \
+static inline void Name##Print(Name queue, void (*elemPrint)(T)) {              \
+	if (queue == NULL) {                                                        \
+		printf("(Queue NULL) \n");                                              \
+	}                                                                           \
+	else if (queue->size == 0) {                                                \
+		printf("(Queue Empty) \n");                                             \
+	}                                                                           \
+	else {                                                                      \
+		printf("Queue contents (front to end): \n");                            \
+		for (int i = 0; i < queue->size; i++) {                                 \
+			elemPrint(queue->elements[(queue->head + i) & (queue->capacity - 1)]); \
+			printf(" ");                                                        \
+		}                                                                       \
+		printf("\n------------------------------ \n");                          \
+	}                                                                           \
+}
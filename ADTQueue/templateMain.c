@@ -0,0 +1,98 @@
+/**
+ * @file templateMain.c
+ * 
+ * @brief Provides an example program that uses two
+ * specializations of the ADT Queue, defined with DEFINE_QUEUE,
+ * in the same program: a queue of integers and a queue of points
+ * (a struct, stored unboxed), both used to find shortest paths in
+ * a small grid by breadth-first search.
+ * 
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "queueTemplate.h"
+
+#define ROWS 5
+#define COLS 8
+
+typedef struct point {
+	int row, col;
+} Point;
+
+DEFINE_QUEUE(IntQueue, int)
+DEFINE_QUEUE(PointQueue, Point)
+
+static const char *grid[ROWS] = {
+	"S..#....",
+	".#.#.##.",
+	".#...#..",
+	".####.#.",
+	"......#E"
+};
+
+static void pointPrint(Point p) {
+	printf("(%d,%d)", p.row, p.col);
+}
+
+static void intPrint(int value) {
+	printf("%d", value);
+}
+
+int main() {
+	int distance[ROWS][COLS];
+	for (int r = 0; r < ROWS; r++) {
+		for (int c = 0; c < COLS; c++) distance[r][c] = -1;
+	}
+
+	PointQueue frontier = PointQueueCreate();
+	IntQueue visitOrder = IntQueueCreate();
+	if (frontier == NULL || visitOrder == NULL) {
+		printf("Could not create the queues. \n");
+		return EXIT_FAILURE;
+	}
+
+	Point start = { 0, 0 };
+	distance[0][0] = 0;
+	PointQueueEnqueue(frontier, start);
+
+	printf("Initial frontier: ");
+	PointQueuePrint(frontier, pointPrint);
+
+	const int dr[] = { -1, 1, 0, 0 };
+	const int dc[] = { 0, 0, -1, 1 };
+
+	Point current;
+	while (PointQueueDequeue(frontier, &current) == QUEUE_OK) {
+		IntQueueEnqueue(visitOrder, current.row * COLS + current.col);
+
+		for (int d = 0; d < 4; d++) {
+			Point next = { current.row + dr[d], current.col + dc[d] };
+			if (next.row < 0 || next.row >= ROWS || next.col < 0 || next.col >= COLS) continue;
+			if (grid[next.row][next.col] == '#' || distance[next.row][next.col] != -1) continue;
+
+			distance[next.row][next.col] = distance[current.row][current.col] + 1;
+			PointQueueEnqueue(frontier, next);
+		}
+	}
+
+	printf("Cells in visiting order (row * %d + col): \n", COLS);
+	IntQueuePrint(visitOrder, intPrint);
+
+	printf("Distances from S: \n");
+	for (int r = 0; r < ROWS; r++) {
+		for (int c = 0; c < COLS; c++) {
+			if (grid[r][c] == '#') printf("  #");
+			else printf("%3d", distance[r][c]);
+		}
+		printf("\n");
+	}
+	printf("Shortest path from S to E: %d steps \n", distance[ROWS - 1][COLS - 1]);
+
+	PointQueueDestroy(&frontier);
+	IntQueueDestroy(&visitOrder);
+
+	return EXIT_SUCCESS;
+}
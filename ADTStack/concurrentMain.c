@@ -0,0 +1,174 @@
+/**
+ * @file concurrentMain.c
+ *
+ * @brief Provides a stress test and contention benchmark of the
+ * lock-free implementation of the ADT Stack (stackLockFree.c).
+ * Please note that the StackElem type must be defined as 'int'.
+ *
+ * For 1, 2, 4, ... threads, every thread pushes and pops distinct
+ * numbers on a shared stack, in bursts of a given depth, as when
+ * threads share a free list or a work stack. At the end of each run,
+ * the program checks that every number pushed was popped exactly once,
+ * which a stack suffering from the ABA problem would not guarantee.
+ *
+ * Usage: prog [max threads] [pushes per thread] [burst depth]
+ *
+ * Compiled with STACK_MUTEX defined (e.g., 'make stress-mutex'), the
+ * program guards the array list implementation with a mutex instead,
+ * for comparison.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "stack.h"
+
+#define MAX_THREADS 64
+
+#ifdef STACK_MUTEX
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int push(PtStack stack, StackElem elem) {
+    pthread_mutex_lock(&lock);
+    int result = stackPush(stack, elem);
+    pthread_mutex_unlock(&lock);
+    return result;
+}
+
+static int pop(PtStack stack, StackElem *ptElem) {
+    pthread_mutex_lock(&lock);
+    int result = stackPop(stack, ptElem);
+    pthread_mutex_unlock(&lock);
+    return result;
+}
+#else
+#define push stackPush
+#define pop stackPop
+#endif
+
+typedef struct worker {
+    pthread_t thread;
+    int id;
+} Worker;
+
+static PtStack stack;
+static int pushesPerThread;
+static int depth;
+static atomic_uchar *popped;    /* times each number was popped */
+static atomic_bool failed;
+
+static void record(StackElem elem) {
+    if (elem < 0 || elem >= MAX_THREADS * pushesPerThread
+            || atomic_fetch_add_explicit(&popped[elem], 1, memory_order_relaxed) != 0) {
+        atomic_store(&failed, true);
+    }
+}
+
+static void* work(void *arg) {
+    Worker *worker = (Worker*)arg;
+    StackElem first = worker->id * pushesPerThread;
+    StackElem elem;
+
+    for (int i = 0; i < pushesPerThread; i += depth) {
+        int burst = (pushesPerThread - i < depth) ? pushesPerThread - i : depth;
+
+        for (int j = 0; j < burst; j++) {
+            if (push(stack, first + i + j) != STACK_OK) {
+                atomic_store(&failed, true);
+                return NULL;
+            }
+        }
+
+        /* pops numbers of any thread, as many as pushed */
+        for (int j = 0; j < burst; j++) {
+            if (pop(stack, &elem) == STACK_OK) record(elem);
+        }
+    }
+
+    return NULL;
+}
+
+static double elapsedSeconds(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+/** Runs with 'threads' threads; returns the throughput, or -1 if a check failed. */
+static double run(int threads) {
+    Worker workers[MAX_THREADS];
+    struct timespec start, end;
+
+    stack = stackCreate();
+    popped = (atomic_uchar*)calloc((size_t)MAX_THREADS * pushesPerThread, sizeof(atomic_uchar));
+    if (stack == NULL || popped == NULL) {
+        printf("Could not create the stack.\n");
+        exit(EXIT_FAILURE);
+    }
+    atomic_store(&failed, false);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int i = 0; i < threads; i++) {
+        workers[i].id = i;
+        pthread_create(&workers[i].thread, NULL, work, &workers[i]);
+    }
+
+    for (int i = 0; i < threads; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    /* pops may have found the stack empty while others were pushing */
+    StackElem elem;
+    while (stackPop(stack, &elem) == STACK_OK) record(elem);
+
+    for (long i = 0; i < (long)threads * pushesPerThread; i++) {
+        if (popped[i] != 1) atomic_store(&failed, true);
+    }
+
+    stackDestroy(&stack);
+    free(popped);
+
+    if (atomic_load(&failed)) return -1;
+
+    return 2.0 * threads * pushesPerThread / elapsedSeconds(start, end) / 1e6;
+}
+
+int main(int argc, char** argv) {
+    int maxThreads = (argc > 1) ? atoi(argv[1]) : 16;
+    pushesPerThread = (argc > 2) ? atoi(argv[2]) : 1000000;
+    depth = (argc > 3) ? atoi(argv[3]) : 4;
+
+    if (maxThreads < 1 || maxThreads > MAX_THREADS || pushesPerThread < 1
+            || (long)MAX_THREADS * pushesPerThread > 1L << 30 || depth < 1) {
+        printf("Usage: %s [max threads <= %d] [pushes per thread] [burst depth]\n", argv[0], MAX_THREADS);
+        return EXIT_FAILURE;
+    }
+
+#ifdef STACK_MUTEX
+    printf("Mutex-guarded stack, ");
+#else
+    printf("Lock-free stack, ");
+#endif
+    printf("pushes per thread: %d, burst depth: %d\n", pushesPerThread, depth);
+    printf("%8s %24s\n", "threads", "push + pop (M ops/s)");
+
+    bool passed = true;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double throughput = run(threads);
+
+        passed = passed && throughput >= 0;
+
+        printf("%8d %24.2f\n", threads, throughput);
+    }
+
+    printf("%s\n", passed ? "PASSED" : "FAILED");
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -18,6 +18,7 @@
 
 #include <stdbool.h>
 #include "stackElem.h"
+#include "adtStats.h"
 
 /** Forward declaration of the data structure. */
 struct stackImpl;
@@ -33,6 +34,19 @@ typedef struct stackImpl *PtStack;
  */
 PtStack stackCreate();
 
+/**
+ * @brief Creates a new empty stack with room for a number of elements.
+ * 
+ * Pushing up to 'capacity' elements onto the stack does not
+ * allocate memory.
+ * 
+ * @param capacity [in] number of elements to make room for
+ * 
+ * @return PtStack pointer to allocated data structure, or
+ * @return NULL if 'capacity' < 1 or unsufficient memory for allocation
+ */
+PtStack stackCreateWithCapacity(int capacity);
+
 /**
  * @brief Free all resources of a stack.
  * 
@@ -114,6 +128,61 @@ bool stackIsEmpty(PtStack stack);
  */
 int stackClear(PtStack stack);
 
+/**
+ * @brief Clears the contents of a stack, keeping its memory.
+ * 
+ * Unlike stackClear, which releases the memory of a large stack,
+ * the stack keeps room for as many elements as it held, so that
+ * refilling it does not allocate memory.
+ * 
+ * @param stack [in] pointer to the stack
+ * 
+ * @return STACK_OK if successful, or
+ * @return STACK_NULL if 'stack' is NULL 
+ */
+int stackClearRetain(PtStack stack);
+
+/**
+ * @brief Makes room for a number of elements in a stack.
+ * 
+ * Pushing elements while the size of the stack does not exceed
+ * 'capacity' does not allocate memory. A 'capacity' not greater
+ * than the current one does nothing.
+ * 
+ * @param stack [in] pointer to the stack
+ * @param capacity [in] number of elements to make room for
+ * 
+ * @return STACK_OK if successful, or
+ * @return STACK_NO_MEMORY if unsufficient memory for allocation, or
+ * @return STACK_NULL if 'stack' is NULL 
+ */
+int stackReserve(PtStack stack, int capacity);
+
+/**
+ * @brief Releases the memory a stack holds beyond its elements.
+ * 
+ * @param stack [in] pointer to the stack
+ * 
+ * @return STACK_OK if successful, or
+ * @return STACK_NULL if 'stack' is NULL 
+ */
+int stackShrinkToFit(PtStack stack);
+
+/**
+ * @brief Retrieves the statistics of a stack.
+ * 
+ * Statistics are only recorded when compiled with ADT_STATS
+ * defined (see adtStats.h); otherwise, they are all zero and 
+ * 'enabled' is false.
+ * 
+ * @param stack [in] pointer to the stack
+ * @param ptStats [out] address of variable to hold the statistics
+ * 
+ * @return STACK_OK if successful and statistics in 'ptStats', or
+ * @return STACK_NULL if 'stack' is NULL 
+ */
+int stackStats(PtStack stack, AdtStats *ptStats);
+
 /**
  * @brief Prints the contents of a stack.
  * 
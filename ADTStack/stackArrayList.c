@@ -18,28 +18,42 @@ typedef struct stackImpl {
     StackElem *elements;   
     int capacity;     
     int size;      
+    ADT_STATS_MEMBER
 } StackImpl;
 
+static bool resize(PtStack stack, int newCapacity) {
+    StackElem* newArray = (StackElem*) realloc( stack->elements, 
+                            newCapacity * sizeof(StackElem) );
+    
+    if(newArray == NULL) return false; 
+
+    stack->elements = newArray;
+    stack->capacity = newCapacity;
+
+    ADT_STATS_REALLOC(stack->stats, newCapacity * sizeof(StackElem));
+
+    return true;
+}
+
 static bool ensureCapacity(PtStack stack) {
     if (stack->size == stack->capacity) {
-        int newCapacity = stack->capacity * 2;
-        StackElem* newArray = (StackElem*) realloc( stack->elements, 
-                                newCapacity * sizeof(StackElem) );
-        
-        if(newArray == NULL) return false; 
-
-        stack->elements = newArray;
-        stack->capacity = newCapacity;
+        return resize(stack, stack->capacity * 2);
     }
     
     return true;
 }
 
 PtStack stackCreate() {
+    return stackCreateWithCapacity(INITIAL_CAPACITY);
+}
+
+PtStack stackCreateWithCapacity(int capacity) {
+    if (capacity < 1) return NULL;
+
     PtStack stack = (PtStack)malloc(sizeof(StackImpl));
     if (stack == NULL) return NULL;
 
-    stack->elements = (StackElem*)calloc(INITIAL_CAPACITY,
+    stack->elements = (StackElem*)calloc(capacity,
                         sizeof(StackElem));
 
     if (stack->elements == NULL) {
@@ -48,7 +62,10 @@ PtStack stackCreate() {
     }
 
     stack->size = 0;
-    stack->capacity = INITIAL_CAPACITY;
+    stack->capacity = capacity;
+
+    ADT_STATS_INIT(stack->stats);
+    ADT_STATS_ALLOC(stack->stats, sizeof(StackImpl) + capacity * sizeof(StackElem));
 
     return stack;
 }
@@ -68,11 +85,15 @@ int stackDestroy(PtStack *ptStack) {
 int stackPush(PtStack stack, StackElem elem) {
     if (stack == NULL) return STACK_NULL;
     
+    ADT_STATS_START(start);
+
     if(!ensureCapacity(stack)) return STACK_NO_MEMORY;
 
     stack->elements[stack->size] = elem;
     stack->size++;
 
+    ADT_STATS_STOP(stack->stats, ADT_OP_INSERT, start);
+
     return STACK_OK;
 }
 
@@ -81,9 +102,13 @@ int stackPop(PtStack stack, StackElem *ptElem) {
 
     if (stack->size == 0) return STACK_EMPTY;
 
+    ADT_STATS_START(start);
+
     *ptElem = stack->elements[stack->size - 1];
     stack->size--;
 
+    ADT_STATS_STOP(stack->stats, ADT_OP_REMOVE, start);
+
     return STACK_OK;
 }
 
@@ -92,8 +117,12 @@ int stackPeek(PtStack stack, StackElem *ptElem) {
 
     if (stack->size == 0) return STACK_EMPTY;
 
+    ADT_STATS_START(start);
+
     *ptElem = stack->elements[stack->size - 1];
 
+    ADT_STATS_STOP(stack->stats, ADT_OP_LOOKUP, start);
+
     return STACK_OK;
 }
 
@@ -120,11 +149,51 @@ int stackClear(PtStack stack) {
 	if(stack->capacity > INITIAL_CAPACITY) {
 		stack->elements = (StackElem*)realloc(stack->elements, INITIAL_CAPACITY * sizeof(StackElem));
 		stack->capacity = INITIAL_CAPACITY;
+
+		ADT_STATS_REALLOC(stack->stats, INITIAL_CAPACITY * sizeof(StackElem));
 	}
 
     return STACK_OK;
 }
 
+int stackClearRetain(PtStack stack) {
+    if (stack == NULL) return STACK_NULL;
+
+    stack->size = 0;
+
+    return STACK_OK;
+}
+
+int stackReserve(PtStack stack, int capacity) {
+    if (stack == NULL) return STACK_NULL;
+
+    if (capacity > stack->capacity && !resize(stack, capacity)) {
+        return STACK_NO_MEMORY;
+    }
+
+    return STACK_OK;
+}
+
+int stackShrinkToFit(PtStack stack) {
+    if (stack == NULL) return STACK_NULL;
+
+    /* keep room for one element, so that the capacity can double */
+    int newCapacity = (stack->size > 0) ? stack->size : 1;
+
+    /* shrinking in place should not fail; if it does, keep the array */
+    if (newCapacity < stack->capacity) resize(stack, newCapacity);
+
+    return STACK_OK;
+}
+
+int stackStats(PtStack stack, AdtStats *ptStats) {
+    if (stack == NULL) return STACK_NULL;
+
+    ADT_STATS_COPY(stack->stats, ptStats);
+
+    return STACK_OK;
+}
+
 void stackPrint(PtStack stack) {
     if (stack == NULL) {
         printf("(Stack NULL)\n");
@@ -10,6 +10,7 @@
  */
 
 #include "stack.h" 
+#include "nodePool.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -26,6 +27,8 @@ typedef struct stackImpl {
     PtNode header;
     PtNode trailer;
     int size;
+    PtNodePool pool;	/* allocator of the element nodes */
+    ADT_STATS_MEMBER
 } StackImpl;
 
 PtStack stackCreate() {
@@ -44,6 +47,14 @@ PtStack stackCreate() {
         return NULL;
     }
 
+    stack->pool = nodePoolCreate(sizeof(Node));
+    if (stack->pool == NULL) {
+        free(stack->trailer);
+        free(stack->header);
+        free(stack);
+        return NULL;
+    }
+
     stack->header->prev = NULL;
     stack->header->next = stack->trailer;
 
@@ -52,6 +63,23 @@ PtStack stackCreate() {
 
     stack->size = 0;
 
+    ADT_STATS_INIT(stack->stats);
+    ADT_STATS_ALLOC(stack->stats, sizeof(StackImpl) + 2 * sizeof(Node));
+
+    return stack;
+}
+
+PtStack stackCreateWithCapacity(int capacity) {
+    if (capacity < 1) return NULL;
+
+    PtStack stack = stackCreate();
+    if (stack == NULL) return NULL;
+
+    if (stackReserve(stack, capacity) != STACK_OK) {
+        stackDestroy(&stack);
+        return NULL;
+    }
+
     return stack;
 }
 
@@ -60,11 +88,8 @@ int stackDestroy(PtStack *ptStack) {
 
     if (stack == NULL) return STACK_NULL;
 
-    PtNode current = stack->header->next;
-    while(current != stack->trailer) {
-        current = current->next;
-        free(current->prev);
-    }
+    /* element nodes are released with their pool */
+    nodePoolDestroy(&stack->pool);
 
     free(stack->header);
     free(stack->trailer);
@@ -78,7 +103,9 @@ int stackDestroy(PtStack *ptStack) {
 int stackPush(PtStack stack, StackElem elem) {
     if (stack == NULL) return STACK_NULL;
     
-    PtNode newTop = (PtNode)malloc(sizeof(Node));
+    ADT_STATS_START(start);
+
+    PtNode newTop = (PtNode)nodePoolAlloc(stack->pool);
     if(newTop == NULL) return STACK_NO_MEMORY;
 
     PtNode curTop = stack->header->next;
@@ -92,6 +119,8 @@ int stackPush(PtStack stack, StackElem elem) {
 
     stack->size++;
 
+    ADT_STATS_STOP(stack->stats, ADT_OP_INSERT, start);
+
     return STACK_OK;
 }
 
@@ -100,6 +129,8 @@ int stackPop(PtStack stack, StackElem *ptElem) {
 
     if (stack->size == 0) return STACK_EMPTY;
 
+    ADT_STATS_START(start);
+
     PtNode curTop = stack->header->next;
     PtNode newTop = stack->header->next->next;
 
@@ -108,10 +139,12 @@ int stackPop(PtStack stack, StackElem *ptElem) {
     stack->header->next = newTop;
     newTop->prev = stack->header;
 
-    free(curTop);
+    nodePoolFree(stack->pool, curTop);
 
     stack->size--;
 
+    ADT_STATS_STOP(stack->stats, ADT_OP_REMOVE, start);
+
     return STACK_OK;
 }
 
@@ -120,9 +153,13 @@ int stackPeek(PtStack stack, StackElem *ptElem) {
 
     if (stack->size == 0) return STACK_EMPTY;
 
+    ADT_STATS_START(start);
+
     PtNode curTop = stack->header->next;
     *ptElem = curTop->element;
 
+    ADT_STATS_STOP(stack->stats, ADT_OP_LOOKUP, start);
+
     return STACK_OK;
 }
 
@@ -143,10 +180,25 @@ bool stackIsEmpty(PtStack stack) {
 int stackClear(PtStack stack) {
     if (stack == NULL) return STACK_NULL;
 
+    nodePoolReset(stack->pool);
+
+    stack->header->next = stack->trailer;
+    stack->trailer->prev = stack->header;
+
+    stack->size = 0;
+
+    return STACK_OK;
+}
+
+int stackClearRetain(PtStack stack) {
+    if (stack == NULL) return STACK_NULL;
+
+    /* return the nodes to the pool, which keeps their memory */
     PtNode current = stack->header->next;
-    while(current != stack->trailer) {
-        current = current->next;
-        free(current->prev);
+    while (current != stack->trailer) {
+        PtNode next = current->next;
+        nodePoolFree(stack->pool, current);
+        current = next;
     }
 
     stack->header->next = stack->trailer;
@@ -157,6 +209,40 @@ int stackClear(PtStack stack) {
     return STACK_OK;
 }
 
+int stackReserve(PtStack stack, int capacity) {
+    if (stack == NULL) return STACK_NULL;
+
+    if (capacity > stack->size &&
+        nodePoolReserve(stack->pool, capacity - stack->size) != NODEPOOL_OK) {
+        return STACK_NO_MEMORY;
+    }
+
+    return STACK_OK;
+}
+
+int stackShrinkToFit(PtStack stack) {
+    if (stack == NULL) return STACK_NULL;
+
+    /* nodes in use may be spread over all chunks of the pool,
+       so memory can only be released when there are none */
+    if (stack->size == 0) nodePoolReset(stack->pool);
+
+    return STACK_OK;
+}
+
+int stackStats(PtStack stack, AdtStats *ptStats) {
+    if (stack == NULL) return STACK_NULL;
+
+    ADT_STATS_COPY(stack->stats, ptStats);
+
+    /* the nodes of the elements are allocated by the pool */
+    if (ptStats->enabled) {
+        ptStats->bytesAllocated += nodePoolBytesAllocated(stack->pool);
+    }
+
+    return STACK_OK;
+}
+
 void stackPrint(PtStack stack) {
     if (stack == NULL) {
         printf("(Stack NULL)");
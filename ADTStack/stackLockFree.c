@@ -0,0 +1,373 @@
+/**
+ * @file stackLockFree.c
+ *
+ * @brief Provides a lock-free implementation of the ADT Stack
+ * for any number of threads (Treiber stack).
+ *
+ * Elements are kept in singly-linked nodes; stackPush and stackPop
+ * swing the 'top' link with a CAS. Popped nodes are pushed onto a
+ * free list, the same kind of stack, and reused by later pushes, so
+ * nodes are only freed by stackClear, stackShrinkToFit and stackDestroy.
+ *
+ * The ABA problem (a thread reading the top node A and its successor,
+ * while others pop A, pop its successor and push A again) is avoided
+ * with tagged links: a node is identified by a 32-bit index, and each
+ * top link packs that index with a 32-bit tag in a 64-bit word, which
+ * is incremented on every change. As nodes are never freed while the
+ * stack is in use, a thread that reads a node that was meanwhile
+ * popped reads valid memory, and then fails its CAS.
+ *
+ * Nodes are allocated in chunks, each twice as large as the previous
+ * one, so that an index maps to its node in constant time and memory
+ * is allocated once per chunk instead of once per node.
+ *
+ * stackPush, stackPop, stackSize, stackIsEmpty and stackReserve may
+ * be called by any thread; stackSize only returns a snapshot. stackPeek
+ * must not run concurrently with stackPop, and stackClear,
+ * stackClearRetain, stackShrinkToFit, stackPrint and stackDestroy must
+ * not run concurrently with any other operation on the same stack.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "stack.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#define CACHE_LINE_SIZE 64
+
+/** Nodes of the first chunk (a power of two); chunk k holds CHUNK_BASE << k nodes. */
+#define CHUNK_BASE_BITS 6
+#define CHUNK_BASE (1u << CHUNK_BASE_BITS)
+
+/** Enough chunks for 2^32 - 1 nodes. */
+#define MAX_CHUNKS (32 - CHUNK_BASE_BITS + 1)
+
+/** Links hold the index of a node plus 1, so that 0 means none. */
+#define NIL 0u
+#define MAX_NODES UINT32_MAX
+
+typedef struct node {
+    StackElem element;      /* element to store at node */
+    atomic_uint_least32_t next;     /* link to next node */
+} Node;
+
+typedef struct stackImpl {
+    _Alignas(CACHE_LINE_SIZE) atomic_uint_least64_t top;    /* tag << 32 | link */
+    _Alignas(CACHE_LINE_SIZE) atomic_uint_least64_t free;   /* free list, same format */
+    _Alignas(CACHE_LINE_SIZE) atomic_uint_least32_t fresh;  /* nodes ever handed out */
+    atomic_int size;
+
+    _Alignas(CACHE_LINE_SIZE) _Atomic(Node*) chunks[MAX_CHUNKS];
+    atomic_long bytesAllocated;     /* in total; chunks may be allocated by any thread */
+    ADT_STATS_MEMBER                /* only memory, see stackStats */
+} StackImpl;
+
+static uint64_t pack(uint32_t tag, uint32_t link) {
+    return ((uint64_t)tag << 32) | link;
+}
+
+static uint32_t linkOf(uint64_t word) {
+    return (uint32_t)word;
+}
+
+static uint32_t tagOf(uint64_t word) {
+    return (uint32_t)(word >> 32);
+}
+
+/** Chunk of the node with a given index (0-based). */
+static int chunkOf(uint32_t index) {
+    uint32_t q = (index >> CHUNK_BASE_BITS) + 1;
+    return 31 - __builtin_clz(q);
+}
+
+static size_t chunkBytes(int chunk) {
+    return ((size_t)CHUNK_BASE << chunk) * sizeof(Node);
+}
+
+/** Node of a link, which must not be NIL. */
+static Node* nodeAt(PtStack stack, uint32_t link) {
+    uint32_t index = link - 1;
+    int chunk = chunkOf(index);
+    uint32_t offset = index - CHUNK_BASE * ((1u << chunk) - 1);
+
+    return &atomic_load_explicit(&stack->chunks[chunk], memory_order_acquire)[offset];
+}
+
+/**
+ * @brief Auxiliary function to allocate a chunk, if not yet allocated.
+ *
+ * Threads may race to allocate the same chunk; the loser frees its own.
+ *
+ * @return 'true' if the chunk is allocated, or
+ * @return 'false' if unsufficient memory for allocation
+ */
+static bool ensureChunk(PtStack stack, int chunk) {
+    if (atomic_load_explicit(&stack->chunks[chunk], memory_order_acquire) != NULL) return true;
+
+    Node *nodes = (Node*)malloc(chunkBytes(chunk));
+    if (nodes == NULL) return false;
+
+    Node *expected = NULL;
+    if (atomic_compare_exchange_strong_explicit(&stack->chunks[chunk], &expected, nodes,
+            memory_order_acq_rel, memory_order_acquire)) {
+        atomic_fetch_add_explicit(&stack->bytesAllocated, (long)chunkBytes(chunk), memory_order_relaxed);
+    }
+    else {
+        free(nodes);
+    }
+
+    return true;
+}
+
+/** Pushes a node onto a list (the stack or the free list). */
+static void pushLink(PtStack stack, atomic_uint_least64_t *head, uint32_t link) {
+    Node *node = nodeAt(stack, link);
+    uint64_t old = atomic_load_explicit(head, memory_order_relaxed);
+
+    do {
+        atomic_store_explicit(&node->next, linkOf(old), memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(head, &old, pack(tagOf(old) + 1, link),
+            memory_order_release, memory_order_relaxed));
+}
+
+/** Pops a node from a list (the stack or the free list); returns its link, or NIL if empty. */
+static uint32_t popLink(PtStack stack, atomic_uint_least64_t *head) {
+    uint64_t old = atomic_load_explicit(head, memory_order_acquire);
+
+    while (linkOf(old) != NIL) {
+        /* the node may be popped meanwhile: then 'next' is stale and the CAS fails */
+        uint32_t next = atomic_load_explicit(&nodeAt(stack, linkOf(old))->next, memory_order_relaxed);
+
+        if (atomic_compare_exchange_weak_explicit(head, &old, pack(tagOf(old) + 1, next),
+                memory_order_acquire, memory_order_acquire)) {
+            return linkOf(old);
+        }
+    }
+
+    return NIL;
+}
+
+/**
+ * @brief Auxiliary function to obtain a node, from the free list
+ * or, if it is empty, never used before.
+ *
+ * @return link of the node, or
+ * @return NIL if no node is available or unsufficient memory for allocation
+ */
+static uint32_t allocateNode(PtStack stack) {
+    uint32_t link = popLink(stack, &stack->free);
+    if (link != NIL) return link;
+
+    uint32_t index = atomic_load_explicit(&stack->fresh, memory_order_relaxed);
+    do {
+        if (index == MAX_NODES) return NIL;
+    } while (!atomic_compare_exchange_weak_explicit(&stack->fresh, &index, index + 1,
+            memory_order_relaxed, memory_order_relaxed));
+
+    if (!ensureChunk(stack, chunkOf(index))) {
+        /* the index is claimed; the next push to that chunk may allocate it */
+        return NIL;
+    }
+
+    return index + 1;
+}
+
+static void freeChunks(PtStack stack, int firstChunk) {
+    for (int i = firstChunk; i < MAX_CHUNKS; i++) {
+        Node *nodes = atomic_load_explicit(&stack->chunks[i], memory_order_relaxed);
+        if (nodes == NULL) continue;
+
+        free(nodes);
+        atomic_store_explicit(&stack->chunks[i], NULL, memory_order_relaxed);
+    }
+}
+
+PtStack stackCreate() {
+    PtStack stack = (PtStack)aligned_alloc(CACHE_LINE_SIZE, sizeof(StackImpl));
+    if (stack == NULL) return NULL;
+
+    atomic_init(&stack->top, pack(0, NIL));
+    atomic_init(&stack->free, pack(0, NIL));
+    atomic_init(&stack->fresh, 0);
+    atomic_init(&stack->size, 0);
+    for (int i = 0; i < MAX_CHUNKS; i++) {
+        atomic_init(&stack->chunks[i], NULL);
+    }
+    atomic_init(&stack->bytesAllocated, sizeof(StackImpl));
+
+    ADT_STATS_INIT(stack->stats);
+
+    return stack;
+}
+
+PtStack stackCreateWithCapacity(int capacity) {
+    if (capacity < 1) return NULL;
+
+    PtStack stack = stackCreate();
+    if (stack == NULL) return NULL;
+
+    if (stackReserve(stack, capacity) != STACK_OK) {
+        stackDestroy(&stack);
+        return NULL;
+    }
+
+    return stack;
+}
+
+int stackDestroy(PtStack *ptStack) {
+    PtStack stack = (*ptStack);
+    if (stack == NULL) return STACK_NULL;
+
+    freeChunks(stack, 0);
+    free(stack);
+
+    *ptStack = NULL;
+
+    return STACK_OK;
+}
+
+int stackPush(PtStack stack, StackElem elem) {
+    if (stack == NULL) return STACK_NULL;
+
+    uint32_t link = allocateNode(stack);
+    if (link == NIL) {
+        return (atomic_load_explicit(&stack->fresh, memory_order_relaxed) == MAX_NODES)
+                ? STACK_FULL : STACK_NO_MEMORY;
+    }
+
+    /* published to poppers by the release CAS of pushLink */
+    nodeAt(stack, link)->element = elem;
+    pushLink(stack, &stack->top, link);
+
+    atomic_fetch_add_explicit(&stack->size, 1, memory_order_relaxed);
+
+    return STACK_OK;
+}
+
+int stackPop(PtStack stack, StackElem *ptElem) {
+    if (stack == NULL) return STACK_NULL;
+
+    uint32_t link = popLink(stack, &stack->top);
+    if (link == NIL) return STACK_EMPTY;
+
+    *ptElem = nodeAt(stack, link)->element;
+    pushLink(stack, &stack->free, link);
+
+    atomic_fetch_sub_explicit(&stack->size, 1, memory_order_relaxed);
+
+    return STACK_OK;
+}
+
+int stackPeek(PtStack stack, StackElem *ptElem) {
+    if (stack == NULL) return STACK_NULL;
+
+    uint32_t link = linkOf(atomic_load_explicit(&stack->top, memory_order_acquire));
+    if (link == NIL) return STACK_EMPTY;
+
+    *ptElem = nodeAt(stack, link)->element;
+
+    return STACK_OK;
+}
+
+int stackSize(PtStack stack, int *ptSize) {
+    if (stack == NULL) return STACK_NULL;
+
+    /* the counter lags behind 'top', so it can be momentarily negative */
+    int size = atomic_load_explicit(&stack->size, memory_order_relaxed);
+    *ptSize = (size > 0) ? size : 0;
+
+    return STACK_OK;
+}
+
+bool stackIsEmpty(PtStack stack) {
+    if (stack == NULL) return true;
+
+    return linkOf(atomic_load_explicit(&stack->top, memory_order_acquire)) == NIL;
+}
+
+int stackClear(PtStack stack) {
+    if (stack == NULL) return STACK_NULL;
+
+    stackClearRetain(stack);
+
+    /* Housekeeping. Keep only the first chunk */
+    freeChunks(stack, 1);
+
+    return STACK_OK;
+}
+
+int stackClearRetain(PtStack stack) {
+    if (stack == NULL) return STACK_NULL;
+
+    /* every node is free again, and handed out in order of index */
+    atomic_store(&stack->top, pack(tagOf(atomic_load(&stack->top)) + 1, NIL));
+    atomic_store(&stack->free, pack(tagOf(atomic_load(&stack->free)) + 1, NIL));
+    atomic_store(&stack->fresh, 0);
+    atomic_store(&stack->size, 0);
+
+    return STACK_OK;
+}
+
+int stackReserve(PtStack stack, int capacity) {
+    if (stack == NULL) return STACK_NULL;
+
+    if (capacity < 1) return STACK_OK;
+
+    /* nodes are handed out in order of index, so the first chunks suffice */
+    for (int chunk = 0; chunk <= chunkOf((uint32_t)capacity - 1); chunk++) {
+        if (!ensureChunk(stack, chunk)) return STACK_NO_MEMORY;
+    }
+
+    return STACK_OK;
+}
+
+int stackShrinkToFit(PtStack stack) {
+    if (stack == NULL) return STACK_NULL;
+
+    /* nodes cannot move, as their indices are links; release all if none is used */
+    if (stackIsEmpty(stack)) {
+        stackClearRetain(stack);
+        freeChunks(stack, 0);
+    }
+
+    return STACK_OK;
+}
+
+int stackStats(PtStack stack, AdtStats *ptStats) {
+    if (stack == NULL) return STACK_NULL;
+
+    /* operations are not counted, as threads would race on the counters */
+    ADT_STATS_COPY(stack->stats, ptStats);
+
+    if (ptStats->enabled) {
+        ptStats->bytesAllocated = atomic_load_explicit(&stack->bytesAllocated, memory_order_relaxed);
+    }
+
+    return STACK_OK;
+}
+
+void stackPrint(PtStack stack) {
+    if (stack == NULL) {
+        printf("(Stack NULL)\n");
+    }
+    else if (stackIsEmpty(stack)) {
+        printf("(Stack Empty)\n");
+    }
+    else {
+        printf("Stack contents (top to bottom): \n");
+
+        uint32_t link = linkOf(atomic_load(&stack->top));
+        while (link != NIL) {
+            Node *node = nodeAt(stack, link);
+            stackElemPrint(node->element);
+            link = atomic_load_explicit(&node->next, memory_order_relaxed);
+        }
+
+        printf("--- bottom --- \n");
+    }
+    printf("\n");
+}
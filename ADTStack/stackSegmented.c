@@ -0,0 +1,323 @@
+/**
+ * @file stackSegmented.c
+ *
+ * @brief Provides an implementation of the ADT Stack with a
+ * segmented array, i.e., a chain of fixed-size blocks, as the
+ * underlying data structure.
+ *
+ * Unlike the array list, the stack never copies its elements when it
+ * grows: a push that fills the top block chains a new one on top of
+ * it, so pushes and pops take O(1) time in the worst case. Each block
+ * only adds a link to BLOCK_SIZE elements, so memory is nearly as dense
+ * as an array's.
+ *
+ * A block emptied by pops is kept as a spare, rather than freed, so
+ * that alternating pushes and pops at the boundary of a block do not
+ * allocate and free it every time. Blocks made room for by
+ * stackReserve or stackClearRetain are kept as spares too.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "stack.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/** Elements per block. */
+#define BLOCK_SIZE 1024
+
+struct block;
+typedef struct block* PtBlock;
+
+typedef struct block {
+    PtBlock below;                  /* block below, or next spare */
+    StackElem elements[BLOCK_SIZE];
+} Block;
+
+typedef struct stackImpl {
+    PtBlock top;        /* never NULL */
+    int topCount;       /* elements in the top block */
+    int size;
+    PtBlock spares;     /* empty blocks, linked by 'below' */
+    int spareCount;
+    int keepSpares;     /* spares kept when blocks are emptied, at least 1 */
+    ADT_STATS_MEMBER
+} StackImpl;
+
+static PtBlock blockCreate(PtStack stack) {
+    PtBlock block = (PtBlock)malloc(sizeof(Block));
+    if (block == NULL) return NULL;
+
+    ADT_STATS_ALLOC(stack->stats, sizeof(Block));
+
+    return block;
+}
+
+/** Keeps an emptied block as a spare, or frees it if there are enough. */
+static void retireBlock(PtStack stack, PtBlock block) {
+    if (stack->spareCount < stack->keepSpares) {
+        block->below = stack->spares;
+        stack->spares = block;
+        stack->spareCount++;
+    }
+    else {
+        free(block);
+    }
+}
+
+static void freeSpares(PtStack stack) {
+    while (stack->spares != NULL) {
+        PtBlock below = stack->spares->below;
+        free(stack->spares);
+        stack->spares = below;
+    }
+    stack->spareCount = 0;
+}
+
+/** Frees all blocks below the top one, which is emptied. */
+static void freeBelowTop(PtStack stack) {
+    PtBlock current = stack->top->below;
+    while (current != NULL) {
+        PtBlock below = current->below;
+        free(current);
+        current = below;
+    }
+
+    stack->top->below = NULL;
+    stack->topCount = 0;
+    stack->size = 0;
+}
+
+PtStack stackCreate() {
+    PtStack stack = (PtStack)malloc(sizeof(StackImpl));
+    if (stack == NULL) return NULL;
+
+    ADT_STATS_INIT(stack->stats);
+    ADT_STATS_ALLOC(stack->stats, sizeof(StackImpl));
+
+    stack->top = blockCreate(stack);
+    if (stack->top == NULL) {
+        free(stack);
+        return NULL;
+    }
+
+    stack->top->below = NULL;
+    stack->topCount = 0;
+    stack->size = 0;
+    stack->spares = NULL;
+    stack->spareCount = 0;
+    stack->keepSpares = 1;
+
+    return stack;
+}
+
+PtStack stackCreateWithCapacity(int capacity) {
+    if (capacity < 1) return NULL;
+
+    PtStack stack = stackCreate();
+    if (stack == NULL) return NULL;
+
+    if (stackReserve(stack, capacity) != STACK_OK) {
+        stackDestroy(&stack);
+        return NULL;
+    }
+
+    return stack;
+}
+
+int stackDestroy(PtStack *ptStack) {
+    PtStack stack = (*ptStack);
+    if (stack == NULL) return STACK_NULL;
+
+    freeBelowTop(stack);
+    free(stack->top);
+    freeSpares(stack);
+    free(stack);
+
+    *ptStack = NULL;
+
+    return STACK_OK;
+}
+
+int stackPush(PtStack stack, StackElem elem) {
+    if (stack == NULL) return STACK_NULL;
+
+    ADT_STATS_START(start);
+
+    if (stack->topCount == BLOCK_SIZE) {
+        PtBlock block = stack->spares;
+        if (block != NULL) {
+            stack->spares = block->below;
+            stack->spareCount--;
+        }
+        else {
+            block = blockCreate(stack);
+            if (block == NULL) return STACK_NO_MEMORY;
+        }
+
+        block->below = stack->top;
+        stack->top = block;
+        stack->topCount = 0;
+    }
+
+    stack->top->elements[stack->topCount] = elem;
+    stack->topCount++;
+    stack->size++;
+
+    ADT_STATS_STOP(stack->stats, ADT_OP_INSERT, start);
+
+    return STACK_OK;
+}
+
+int stackPop(PtStack stack, StackElem *ptElem) {
+    if (stack == NULL) return STACK_NULL;
+
+    if (stack->size == 0) return STACK_EMPTY;
+
+    ADT_STATS_START(start);
+
+    stack->topCount--;
+    stack->size--;
+    *ptElem = stack->top->elements[stack->topCount];
+
+    /* the top block is never empty, unless it is the only one */
+    if (stack->topCount == 0 && stack->top->below != NULL) {
+        PtBlock emptied = stack->top;
+        stack->top = emptied->below;
+        stack->topCount = BLOCK_SIZE;
+        retireBlock(stack, emptied);
+    }
+
+    ADT_STATS_STOP(stack->stats, ADT_OP_REMOVE, start);
+
+    return STACK_OK;
+}
+
+int stackPeek(PtStack stack, StackElem *ptElem) {
+    if (stack == NULL) return STACK_NULL;
+
+    if (stack->size == 0) return STACK_EMPTY;
+
+    ADT_STATS_START(start);
+
+    *ptElem = stack->top->elements[stack->topCount - 1];
+
+    ADT_STATS_STOP(stack->stats, ADT_OP_LOOKUP, start);
+
+    return STACK_OK;
+}
+
+int stackSize(PtStack stack, int *ptSize) {
+    if (stack == NULL) return STACK_NULL;
+
+    *ptSize = stack->size;
+
+    return STACK_OK;
+}
+
+bool stackIsEmpty(PtStack stack) {
+    if (stack == NULL) return true;
+
+    return (stack->size == 0);
+}
+
+int stackClear(PtStack stack) {
+    if (stack == NULL) return STACK_NULL;
+
+    // Housekeeping. Keep only the top block and one spare
+    freeBelowTop(stack);
+    stack->keepSpares = 1;
+    while (stack->spareCount > stack->keepSpares) {
+        PtBlock below = stack->spares->below;
+        free(stack->spares);
+        stack->spares = below;
+        stack->spareCount--;
+    }
+
+    return STACK_OK;
+}
+
+int stackClearRetain(PtStack stack) {
+    if (stack == NULL) return STACK_NULL;
+
+    /* blocks below the top become spares, all of them kept */
+    PtBlock current = stack->top->below;
+    while (current != NULL) {
+        PtBlock below = current->below;
+        current->below = stack->spares;
+        stack->spares = current;
+        stack->spareCount++;
+        current = below;
+    }
+
+    if (stack->spareCount > stack->keepSpares) stack->keepSpares = stack->spareCount;
+
+    stack->top->below = NULL;
+    stack->topCount = 0;
+    stack->size = 0;
+
+    return STACK_OK;
+}
+
+int stackReserve(PtStack stack, int capacity) {
+    if (stack == NULL) return STACK_NULL;
+
+    /* room in the top block and the spares */
+    long room = (long)(BLOCK_SIZE - stack->topCount) + (long)stack->spareCount * BLOCK_SIZE;
+
+    while (stack->size + room < capacity) {
+        PtBlock block = blockCreate(stack);
+        if (block == NULL) return STACK_NO_MEMORY;
+
+        block->below = stack->spares;
+        stack->spares = block;
+        stack->spareCount++;
+        room += BLOCK_SIZE;
+    }
+
+    if (stack->spareCount > stack->keepSpares) stack->keepSpares = stack->spareCount;
+
+    return STACK_OK;
+}
+
+int stackShrinkToFit(PtStack stack) {
+    if (stack == NULL) return STACK_NULL;
+
+    /* blocks in use hold elements, and are never partially filled below the top */
+    freeSpares(stack);
+    stack->keepSpares = 1;
+
+    return STACK_OK;
+}
+
+int stackStats(PtStack stack, AdtStats *ptStats) {
+    if (stack == NULL) return STACK_NULL;
+
+    ADT_STATS_COPY(stack->stats, ptStats);
+
+    return STACK_OK;
+}
+
+void stackPrint(PtStack stack) {
+    if (stack == NULL) {
+        printf("(Stack NULL)\n");
+    }
+    else if (stackIsEmpty(stack)) {
+        printf("(Stack Empty)\n");
+    }
+    else {
+        printf("Stack contents (top to bottom): \n");
+
+        int count = stack->topCount;
+        for (PtBlock block = stack->top; block != NULL; block = block->below) {
+            for (int i = count - 1; i >= 0; i--) {
+                stackElemPrint(block->elements[i]);
+            }
+            count = BLOCK_SIZE;
+        }
+
+        printf("--- bottom --- \n");
+    }
+    printf("\n");
+}
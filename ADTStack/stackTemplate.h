@@ -0,0 +1,167 @@
+/**
+ * @file stackTemplate.h
+ * @brief Generic, type-specialized version of the ADT Stack
+ * with an array list as the underlying data structure.
+ *
+ * DEFINE_STACK(Name, T) defines a stack of elements of type T,
+ * unboxed, as the type 'Name' and the functions 'Name##Create',
+ * 'Name##Push', etc., with the same semantics and error codes as the
+ * operations of stack.h (see stackArrayList.c). The functions are
+ * 'static inline', so each translation unit may define several
+ * stacks, of different types, without changing stackElem.h.
+ *
+ * Example:
+ *
+ *     DEFINE_STACK(IntStack, int)
+ *
+ *     IntStack stack = IntStackCreate();
+ *     IntStackPush(stack, 42);
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+/* same values as in stack.h */
+#define STACK_OK            0
+#define STACK_NULL          1
+#define STACK_NO_MEMORY     2
+#define STACK_EMPTY         3
+#define STACK_FULL          4
+
+#define STACK_TEMPLATE_INITIAL_CAPACITY 20
+
+/**
+ * @brief Defines the type 'Name', a stack of elements of type 'T',
+ * and its operations.
+ *
+ * @param Name name of the stack type, also the prefix of its operations
+ * @param T type of the elements
+ */
+#define DEFINE_STACK(Name, T)                                                   \
+                                                                                \
+typedef struct Name##Impl {                                                     \
+    T *elements;                                                                \
+    int capacity;                                                               \
+    int size;                                                                   \
+} Name##Impl;                                                                   \
+                                                                                \
+typedef Name##Impl *Name;                                                       \
+                                                                                \
+static inline Name Name##Create(void) {                                         \
+    Name stack = (Name)malloc(sizeof(Name##Impl));                              \
+    if (stack == NULL) return NULL;                                             \
+                                                                                \
+    stack->elements = (T*)malloc(STACK_TEMPLATE_INITIAL_CAPACITY * sizeof(T));  \
+    if (stack->elements == NULL) {                                              \
+        free(stack);                                                            \
+        return NULL;                                                            \
+    }                                                                           \
+                                                                                \
+    stack->size = 0;                                                            \
+    stack->capacity = STACK_TEMPLATE_INITIAL_CAPACITY;                          \
+                                                                                \
+    return stack;                                                               \
+}                                                                               \
+                                                                                \
+static inline int Name##Destroy(Name *ptStack) {                                \
+    Name stack = *ptStack;                                                      \
+    if (stack == NULL) return STACK_NULL;                                       \
+                                                                                \
+    free(stack->elements);                                                      \
+    free(stack);                                                                \
+                                                                                \
+    *ptStack = NULL;                                                            \
+                                                                                \
+    return STACK_OK;                                                            \
+}                                                                               \
+                                                                                \
+static inline int Name##Push(Name stack, T elem) {                              \
+    if (stack == NULL) return STACK_NULL;                                       \
+                                                                                \
+    if (stack->size == stack->capacity) {                                       \
+        int newCapacity = stack->capacity * 2;                                  \
+        T *newArray = (T*)realloc(stack->elements, newCapacity * sizeof(T));    \
+        if (newArray == NULL) return STACK_NO_MEMORY;                           \
+                                                                                \
+        stack->elements = newArray;                                             \
+        stack->capacity = newCapacity;                                          \
+    }                                                                           \
+                                                                                \
+    stack->elements[stack->size++] = elem;                                      \
+                                                                                \
+    return STACK_OK;                                                            \
+}                                                                               \
+                                                                                \
+static inline int Name##Pop(Name stack, T *ptElem) {                            \
+    if (stack == NULL) return STACK_NULL;                                       \
+    if (stack->size == 0) return STACK_EMPTY;                                   \
+                                                                                \
+    *ptElem = stack->elements[--stack->size];                                   \
+                                                                                \
+    return STACK_OK;                                                            \
+}                                                                               \
+                                                                                \
+static inline int Name##Peek(Name stack, T *ptElem) {                           \
+    if (stack == NULL) return STACK_NULL;                                       \
+    if (stack->size == 0) return STACK_EMPTY;                                   \
+                                                                                \
+    *ptElem = stack->elements[stack->size - 1];                                 \
+                                                                                \
+    return STACK_OK;                                                            \
+}                                                                               \
+                                                                                \
+static inline int Name##Size(Name stack, int *ptSize) {                         \
+    if (stack == NULL) return STACK_NULL;                                       \
+                                                                                \
+    *ptSize = stack->size;                                                      \
+                                                                                \
+    return STACK_OK;                                                            \
+}                                                                               \
+                                                                                \
+static inline bool Name##IsEmpty(Name stack) {                                  \
+    if (stack == NULL) return true;                                             \
+                                                                                \
+    return (stack->size == 0);                                                  \
+}                                                                               \
+                                                                                \
+static inline int Name##Clear(Name stack) {                                     \
+    if (stack == NULL) return STACK_NULL;                                       \
+                                                                                \
+    stack->size = 0;                                                            \
+                                                                                \
+    /* housekeeping: the array can be very large, shrink to initial size */     \
+    if (stack->capacity > STACK_TEMPLATE_INITIAL_CAPACITY) {                    \
+        T *newArray = (T*)realloc(stack->elements,                              \
+                            STACK_TEMPLATE_INITIAL_CAPACITY * sizeof(T));       \
+        if (newArray != NULL) {                                                 \
+            stack->elements = newArray;                                         \
+            stack->capacity = STACK_TEMPLATE_INITIAL_CAPACITY;                  \
+        }                                                                       \
+    }                                                                           \
+                                                                                \
+    return STACK_OK;                                                            \
+}                                                                               \
+                                                                                \
+/* prints from top to bottom, with 'elemPrint' printing each element */         \
+static inline void Name##Print(Name stack, void (*elemPrint)(T)) {              \
+    if (stack == NULL) {                                                        \
+        printf("(Stack NULL)\n");                                               \
+    }                                                                           \
+    else if (stack->size == 0) {                                                \
+        printf("(Stack Empty)\n");                                              \
+    }                                                                           \
+    else {                                                                      \
+        printf("Stack contents (top to bottom): \n");                           \
+        for (int i = stack->size - 1; i >= 0; i--) {                            \
+            elemPrint(stack->elements[i]);                                      \
+        }                                                                       \
+        printf("--- bottom --- \n");                                            \
+    }                                                                           \
+    printf("\n");                                                               \
+}
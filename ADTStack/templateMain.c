@@ -0,0 +1,112 @@
+/**
+ * @file templateMain.c
+ * 
+ * @brief Provides an example program that uses two
+ * specializations of the ADT Stack, defined with DEFINE_STACK,
+ * in the same program: one of characters, to check whether the
+ * brackets of an expression are balanced, and one of doubles, to
+ * evaluate an expression in postfix notation.
+ * 
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "stackTemplate.h"
+
+DEFINE_STACK(CharStack, char)
+DEFINE_STACK(DoubleStack, double)
+
+static void doublePrint(double value) {
+    printf("%g \n", value);
+}
+
+static bool balanced(const char *expression) {
+    CharStack stack = CharStackCreate();
+    if (stack == NULL) return false;
+
+    bool ok = true;
+    for (const char *c = expression; *c != '\0' && ok; c++) {
+        char open;
+        switch (*c) {
+            case '(': case '[': case '{':
+                CharStackPush(stack, *c);
+                break;
+            case ')': case ']': case '}':
+                ok = (CharStackPop(stack, &open) == STACK_OK) &&
+                     ((open == '(' && *c == ')') || (open == '[' && *c == ']') ||
+                      (open == '{' && *c == '}'));
+                break;
+        }
+    }
+    ok = ok && CharStackIsEmpty(stack);
+
+    CharStackDestroy(&stack);
+
+    return ok;
+}
+
+/* evaluates space-separated numbers and operators, e.g., "3 4 + 2 *" */
+static bool evaluatePostfix(const char *expression, double *ptResult) {
+    DoubleStack stack = DoubleStackCreate();
+    if (stack == NULL) return false;
+
+    char buffer[256];
+    strncpy(buffer, expression, sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+
+    bool ok = true;
+    for (char *token = strtok(buffer, " "); token != NULL && ok; token = strtok(NULL, " ")) {
+        double left, right;
+
+        if (strlen(token) == 1 && strchr("+-*/", token[0]) != NULL) {
+            ok = DoubleStackPop(stack, &right) == STACK_OK &&
+                 DoubleStackPop(stack, &left) == STACK_OK;
+            if (!ok) break;
+
+            switch (token[0]) {
+                case '+': DoubleStackPush(stack, left + right); break;
+                case '-': DoubleStackPush(stack, left - right); break;
+                case '*': DoubleStackPush(stack, left * right); break;
+                case '/': DoubleStackPush(stack, left / right); break;
+            }
+        }
+        else {
+            ok = DoubleStackPush(stack, atof(token)) == STACK_OK;
+        }
+
+        printf("After '%s': ", token);
+        DoubleStackPrint(stack, doublePrint);
+    }
+
+    int size = 0;
+    DoubleStackSize(stack, &size);
+    ok = ok && size == 1 && DoubleStackPop(stack, ptResult) == STACK_OK;
+
+    DoubleStackDestroy(&stack);
+
+    return ok;
+}
+
+int main() {
+    const char *expressions[] = { "{[()()]}", "([)]", "((())", "" };
+
+    for (int i = 0; i < 4; i++) {
+        printf("'%s' is %sbalanced. \n", expressions[i],
+               balanced(expressions[i]) ? "" : "NOT ");
+    }
+    printf("\n");
+
+    double result;
+    if (evaluatePostfix("3 4 + 2 * 7 /", &result)) {
+        printf("3 4 + 2 * 7 / = %g \n", result);
+    }
+    else {
+        printf("Invalid postfix expression. \n");
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -1,50 +1,35 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "mytime.h"
 
-#define DAY_TO_SECONDS 86400
-
-typedef struct time {    
-    int hours, minutes, seconds;
-
-    /*  TODO: EXERCISE. Store time with total seconds elapsed from 0:00:00 
-        All functions should me modified appropriately.
-    */
-} Time;
-
-/**
- * @brief Auxiliary function to convert a total amounts of seconds 
- * elapsed from 00:00:00 to a PtTime instance.
- * 
- * @param totalSeconds total seconds to convert
- * @return PtTime instance or NULL if totalSeconds < 0.
- */
-static PtTime secondsToTime(int totalSeconds) {
-    if(totalSeconds < 0) return NULL;
-
-    int hours = totalSeconds / 3600;
-    totalSeconds = totalSeconds % 3600;
-    int minutes = totalSeconds / 60;
-    int seconds = totalSeconds % 60;
-
-    return timeCreate(hours, minutes, seconds);
-}
+/* struct time, holding the seconds since 00:00:00, is defined in mytime.h */
 
 PtTime timeCreate(int hour, int minute, int second) {
     if(hour > 23 || hour < 0) return NULL;
     if(minute > 59 || minute < 0) return NULL;
     if(second > 59 || second < 0) return NULL;
 
+    return timeCreateV(timeV(hour, minute, second));
+}
+
+PtTime timeCreateV(Time value) {
+    if(value.seconds < 0 || value.seconds >= TIME_DAY_SECONDS) return NULL;
+
     PtTime new = (PtTime)malloc(sizeof(Time)); 
     if(new == NULL) return NULL; // or if(!new)
 
-    new->hours = hour;
-    new->minutes = minute;
-    new->seconds = second;
+    *new = value;
 
     return new;
 }
 
+int timeValue(PtTime t, Time *value) {
+    if (t == NULL || value == NULL) return TIME_NULL;
+    *value = *t;
+    return TIME_OK;
+}
+
 int timeDestroy(PtTime *ptT) {
     if (ptT == NULL || *ptT == NULL) return TIME_NULL;
     
@@ -56,26 +41,26 @@ int timeDestroy(PtTime *ptT) {
 
 int timeGetHour(PtTime t, int *hour) {
     if (t == NULL || hour == NULL) return TIME_NULL;
-    *hour = t->hours;
+    *hour = timeHourV(*t);
     return TIME_OK;
 }
 
 int timeGetMinute(PtTime t, int *minute) {
     if (t == NULL || minute == NULL) return TIME_NULL;
-    *minute = t->minutes;
+    *minute = timeMinuteV(*t);
     return TIME_OK;
 }
 
 int timeGetSecond(PtTime t, int *second) {
     if (t == NULL || second == NULL) return TIME_NULL;
-    *second = t->seconds;
+    *second = timeSecondV(*t);
     return TIME_OK;
 }
 
 int timeToSeconds(PtTime t, int *totalSeconds) {
     if (t == NULL || totalSeconds == NULL) return TIME_NULL;
     
-    *totalSeconds = 3600 * t->hours + 60 * t->minutes + t->seconds;
+    *totalSeconds = t->seconds;
 
     return TIME_OK;
 }
@@ -83,48 +68,142 @@ int timeToSeconds(PtTime t, int *totalSeconds) {
 PtTime timeAdd(PtTime t1, PtTime t2) {
     if (t1 == NULL || t2 == NULL) return NULL;
 
-    //int t1Seconds = 3600 * t1->hours + 60 * t1->minutes + t1->seconds;
-    //int t2Seconds = 3600 * t2->hours + 60 * t2->minutes + t2->seconds;
+    return timeCreateV(timeAddV(*t1, *t2));
+}
 
-    int t1Seconds, t2Seconds;
-    timeToSeconds(t1, &t1Seconds);
-    timeToSeconds(t2, &t2Seconds);
+PtTime timeDiff(PtTime t1, PtTime t2) {
+    if (t1 == NULL || t2 == NULL) return NULL;
 
-    int total = t1Seconds + t2Seconds;
+    return timeCreateV(timeDiffV(*t1, *t2));
+}
 
-    // Edge case: if the sum overflows 24h, subtract those 24h (rollover).
-    if(total >= DAY_TO_SECONDS) {
-        total = total - DAY_TO_SECONDS;
+int timeAddBatch(const Time *t1, const Time *t2, Time *out, int n) {
+    if (t1 == NULL || t2 == NULL || out == NULL) return TIME_NULL;
+
+    for(int i = 0; i < n; i++) {
+        out[i] = timeAddV(t1[i], t2[i]);
     }
 
-    /*
-    int hours = total / 3600;
-    total = total % 3600;
-    int minutes = total / 60;
-    int seconds = total % 60;
+    return TIME_OK;
+}
+
+int timeShiftBatch(const Time *t, Time offset, Time *out, int n) {
+    if (t == NULL || out == NULL) return TIME_NULL;
 
-    return timeCreate(hours, minutes, seconds);
-    */
+    for(int i = 0; i < n; i++) {
+        out[i] = timeAddV(t[i], offset);
+    }
 
-    return secondsToTime(total);
+    return TIME_OK;
 }
 
-PtTime timeDiff(PtTime t1, PtTime t2) {
-    if (t1 == NULL || t2 == NULL) return NULL;
-    
-    int t1Seconds, t2Seconds;
-    timeToSeconds(t1, &t1Seconds);
-    timeToSeconds(t2, &t2Seconds);
+int timeDiffBatch(const Time *t1, const Time *t2, Time *out, int n) {
+    if (t1 == NULL || t2 == NULL || out == NULL) return TIME_NULL;
 
-    int total = t1Seconds - t2Seconds;
+    for(int i = 0; i < n; i++) {
+        out[i] = timeDiffV(t1[i], t2[i]);
+    }
 
-    // Edge case: if difference is negative, it means we rollback a day
-    // Imagine the clock arms going back midnight...
-    if(total < 0) {
-        total = DAY_TO_SECONDS + total; // 'total' is negative, the value will be subtracted
+    return TIME_OK;
+}
+
+int timeCompareBatch(const Time *t1, const Time *t2, int *result, int n) {
+    if (t1 == NULL || t2 == NULL || result == NULL) return TIME_NULL;
+
+    for(int i = 0; i < n; i++) {
+        result[i] = timeCompareV(t1[i], t2[i]);
     }
 
-    return secondsToTime(total);
+    return TIME_OK;
+}
+
+/* "HH:MM:SS" is parsed in a 64-bit word, the character i at bits [8i, 8i + 7] */
+
+#define ASCII_ZEROS  0x3030303030303030ULL  /**< '0' in every byte */
+#define HIGH_NIBBLES 0xF0F0F0F0F0F0F0F0ULL
+#define ADD_SIXES    0x0606060606060606ULL
+#define COLONS       0x00003A00003A0000ULL  /**< ':' at characters 2 and 5 */
+#define COLONS_MASK  0x0000FF0000FF0000ULL
+
+/** Loads 8 characters, the first in the lowest byte, regardless of the endianness. */
+static inline uint64_t load8(const char *str) {
+    const unsigned char *c = (const unsigned char*)str;
+    return (uint64_t)c[0] | (uint64_t)c[1] << 8 | (uint64_t)c[2] << 16 | (uint64_t)c[3] << 24
+         | (uint64_t)c[4] << 32 | (uint64_t)c[5] << 40 | (uint64_t)c[6] << 48 | (uint64_t)c[7] << 56;
+}
+
+/** Converts "HH:MM:SS", loaded by load8, to seconds; -1 if it is not a valid time. */
+static inline int32_t parseWord(uint64_t word) {
+    /* with the colons replaced by '0's, every character must be a digit */
+    uint64_t x = (word & ~COLONS_MASK) | (ASCII_ZEROS & COLONS_MASK);
+    int format = ((word & COLONS_MASK) == COLONS)
+               & ((x & HIGH_NIBBLES) == ASCII_ZEROS) & (((x + ADD_SIXES) & HIGH_NIBBLES) == ASCII_ZEROS);
+
+    /* byte i of 'pairs' is 10 * digit[i] + digit[i + 1]; fields are at bytes 0, 3 and 6 */
+    uint64_t d = x - ASCII_ZEROS;
+    uint64_t pairs = d * 10 + (d >> 8);
+    int32_t hours = pairs & 0xFF;
+    int32_t minutes = (pairs >> 24) & 0xFF;
+    int32_t seconds = (pairs >> 48) & 0xFF;
+
+    int valid = format & (hours < 24) & (minutes < 60) & (seconds < 60);
+    int32_t total = 3600 * hours + 60 * minutes + seconds;
+
+    return total | -(int32_t)!valid;
+}
+
+int timeParse(const char *str, int len, Time *out) {
+    if (str == NULL || out == NULL) return TIME_NULL;
+
+    char buf[8] = { '0' };
+    if (len == 8) {
+        memcpy(buf, str, 8);
+    } else if (len == 7) {
+        memcpy(buf + 1, str, 7);
+    } else {
+        return TIME_INVALID;
+    }
+
+    int32_t total = parseWord(load8(buf));
+    if (total < 0) return TIME_INVALID;
+
+    out->seconds = total;
+    return TIME_OK;
+}
+
+int timeParseBatch(const char *str, int stride, Time *out, int n) {
+    if (str == NULL || out == NULL) return TIME_NULL;
+    if (stride < 8) return TIME_INVALID;
+
+    int32_t invalid = 0;
+    for(int i = 0; i < n; i++) {
+        int32_t total = parseWord(load8(str + (size_t)i * stride));
+        out[i].seconds = total;
+        invalid |= total;
+    }
+
+    return invalid < 0 ? TIME_INVALID : TIME_OK;
+}
+
+/** The two digits of 'value' < 100, tens first, in the two lowest bytes. */
+static inline uint64_t twoDigits(uint32_t value) {
+    uint32_t tens = (value * 103) >> 10;    /* value / 10, for value < 179 */
+    return ('0' + tens) | ('0' + value - 10 * tens) << 8;
+}
+
+int timeFormat(Time t, char *buf) {
+    if (buf == NULL) return TIME_NULL;
+    if (t.seconds < 0 || t.seconds >= TIME_DAY_SECONDS) return TIME_INVALID;
+
+    uint64_t word = twoDigits(timeHourV(t)) | (uint64_t)':' << 16
+                  | twoDigits(timeMinuteV(t)) << 24 | (uint64_t)':' << 40
+                  | twoDigits(timeSecondV(t)) << 48;
+
+    for(int i = 0; i < 8; i++) {
+        buf[i] = (char)(word >> (8 * i));
+    }
+
+    return TIME_OK;
 }
 
 void timePrint(PtTime t) {
@@ -134,5 +213,7 @@ void timePrint(PtTime t) {
     }
 
     // Print in hh:mm:ss format
-    printf("%02d:%02d:%02d\n", t->hours, t->minutes, t->seconds);
+    char buf[8];
+    timeFormat(*t, buf);
+    printf("%.8s\n", buf);
 }
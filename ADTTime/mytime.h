@@ -12,12 +12,28 @@
  */
 #pragma once
 
+#include <stdint.h>
+
 #define TIME_OK       0    /**< Operation completed successfully */
 #define TIME_NULL     1    /**< Null pointer received */
 #define TIME_INVALID  2    /**< Invalid time values provided */
 
-/** @brief Opaque structure representing a time (hour, minute, second). */
-struct time;
+#define TIME_DAY_SECONDS 86400    /**< Number of seconds in a day */
+
+/**
+ * @brief A time of the day, stored as the number of seconds since 00:00:00,
+ * in [0, 86399].
+ * 
+ * Times can be used by value, with the 'V' operations (e.g., timeAddV),
+ * which neither allocate memory nor fail, and in arrays, with the 'Batch'
+ * operations (e.g., timeAddBatch); or through PtTime pointers to allocated
+ * times, whose operations (e.g., timeAdd) compute by value and allocate
+ * the result.
+ */
+typedef struct time {
+    int32_t seconds;
+} Time;
+
 typedef struct time* PtTime;
 
 /*
@@ -37,6 +53,187 @@ PtTime timeNow(void);
 
 */
 
+/**
+ * @brief Makes a time, by value, from the given hour, minute, and second.
+ * 
+ * The values must be valid, as for timeCreate; they are not checked.
+ * 
+ * @param hour Hour value.
+ * @param minute Minute value.
+ * @param second Second value.
+ * @return The time hour:minute:second.
+ */
+static inline Time timeV(int hour, int minute, int second) {
+    Time t = { 3600 * hour + 60 * minute + second };
+    return t;
+}
+
+/**
+ * @brief Makes a time, by value, from a number of seconds since 00:00:00.
+ * 
+ * Wraps around at 24:00:00, also for negative values
+ * (e.g., -1 is 23:59:59).
+ * 
+ * @param totalSeconds Number of seconds.
+ * @return The time 'totalSeconds' after 00:00:00, modulo 86400 seconds.
+ */
+static inline Time timeFromSecondsV(int32_t totalSeconds) {
+    int32_t seconds = totalSeconds % TIME_DAY_SECONDS;
+    Time t = { seconds < 0 ? seconds + TIME_DAY_SECONDS : seconds };
+    return t;
+}
+
+/** @brief Retrieves the hour component of a time, by value. */
+static inline int timeHourV(Time t) {
+    return t.seconds / 3600;
+}
+
+/** @brief Retrieves the minute component of a time, by value. */
+static inline int timeMinuteV(Time t) {
+    return t.seconds / 60 % 60;
+}
+
+/** @brief Retrieves the second component of a time, by value. */
+static inline int timeSecondV(Time t) {
+    return t.seconds % 60;
+}
+
+/**
+ * @brief Adds two times, by value, wrapping around at 24:00:00.
+ * 
+ * @param t1 First operand.
+ * @param t2 Second operand.
+ * @return t1 + t2, modulo 86400 seconds.
+ */
+static inline Time timeAddV(Time t1, Time t2) {
+    int32_t total = t1.seconds + t2.seconds;
+    /* branch-free: subtract a day if the sum reached 24:00:00 */
+    total -= TIME_DAY_SECONDS & -(int32_t)(total >= TIME_DAY_SECONDS);
+    Time t = { total };
+    return t;
+}
+
+/**
+ * @brief Subtracts two times, by value, wrapping around at 00:00:00.
+ * 
+ * Example: 12:30:00 - 10:15:30 = 02:14:30 and 10:15:30 - 12:30:00 = 21:45:30
+ * 
+ * @param t1 First operand.
+ * @param t2 Second operand.
+ * @return t1 - t2, modulo 86400 seconds.
+ */
+static inline Time timeDiffV(Time t1, Time t2) {
+    int32_t total = t1.seconds - t2.seconds;
+    /* branch-free: add a day if the difference is negative */
+    total += TIME_DAY_SECONDS & (total >> 31);
+    Time t = { total };
+    return t;
+}
+
+/**
+ * @brief Compares two times, by value (similarly to strcmp).
+ * 
+ * @param t1 First operand.
+ * @param t2 Second operand.
+ * @return -1 if t1 is earlier than t2, 0 if they are equal, 1 if t1 is later than t2.
+ */
+static inline int timeCompareV(Time t1, Time t2) {
+    return (t1.seconds > t2.seconds) - (t1.seconds < t2.seconds);
+}
+
+/**
+ * @brief Adds, element-wise, two arrays of times: out[i] = t1[i] + t2[i].
+ * 
+ * Branch-free, so that compilers vectorize it (e.g., GCC with -O3).
+ * 'out' may be the same array as 't1' or 't2'.
+ * 
+ * @param t1 First array of operands.
+ * @param t2 Second array of operands.
+ * @param out Array to store the results.
+ * @param n Number of elements.
+ * @return TIME_OK if successful, TIME_NULL if any array is NULL.
+ */
+int timeAddBatch(const Time *t1, const Time *t2, Time *out, int n);
+
+/**
+ * @brief Adds the same time to all times of an array: out[i] = t[i] + offset.
+ * 
+ * Branch-free, so that compilers vectorize it (e.g., GCC with -O3).
+ * 'out' may be the same array as 't'.
+ * 
+ * @param t Array of operands.
+ * @param offset Time to add.
+ * @param out Array to store the results.
+ * @param n Number of elements.
+ * @return TIME_OK if successful, TIME_NULL if any array is NULL.
+ */
+int timeShiftBatch(const Time *t, Time offset, Time *out, int n);
+
+/**
+ * @brief Subtracts, element-wise, two arrays of times: out[i] = t1[i] - t2[i].
+ * 
+ * Branch-free, so that compilers vectorize it (e.g., GCC with -O3).
+ * 'out' may be the same array as 't1' or 't2'.
+ * 
+ * @param t1 First array of operands.
+ * @param t2 Second array of operands.
+ * @param out Array to store the results.
+ * @param n Number of elements.
+ * @return TIME_OK if successful, TIME_NULL if any array is NULL.
+ */
+int timeDiffBatch(const Time *t1, const Time *t2, Time *out, int n);
+
+/**
+ * @brief Compares, element-wise, two arrays of times:
+ * result[i] = timeCompareV(t1[i], t2[i]).
+ * 
+ * Branch-free, so that compilers vectorize it (e.g., GCC with -O3).
+ * 
+ * @param t1 First array of operands.
+ * @param t2 Second array of operands.
+ * @param result Array to store the results (-1, 0 or 1).
+ * @param n Number of elements.
+ * @return TIME_OK if successful, TIME_NULL if any array is NULL.
+ */
+int timeCompareBatch(const Time *t1, const Time *t2, int *result, int n);
+
+/**
+ * @brief Parses a time in the format "HH:MM:SS" (or "H:MM:SS").
+ * 
+ * @param str Characters to parse (need not be NUL-terminated).
+ * @param len Number of characters, 8 (or 7).
+ * @param out Address to store the time.
+ * @return TIME_OK if successful, TIME_NULL if 'str' or 'out' are NULL,
+ * TIME_INVALID if the characters are not a valid time.
+ */
+int timeParse(const char *str, int len, Time *out);
+
+/**
+ * @brief Parses a column of fixed-width times, in the format "HH:MM:SS".
+ * 
+ * The i-th time is at str + i * stride, e.g., for stride 9, "HH:MM:SS\n"
+ * lines. Each time is converted within a 64-bit word, without branches.
+ * Invalid times are stored with -1 seconds, which no valid time has.
+ * 
+ * @param str Column to parse.
+ * @param stride Distance between consecutive times, at least 8.
+ * @param out Array to store the times.
+ * @param n Number of times.
+ * @return TIME_OK if successful, TIME_NULL if 'str' or 'out' are NULL,
+ * TIME_INVALID if 'stride' < 8 or any time is invalid.
+ */
+int timeParseBatch(const char *str, int stride, Time *out, int n);
+
+/**
+ * @brief Formats a time as "HH:MM:SS".
+ * 
+ * @param t The time.
+ * @param buf Address to store the 8 characters (not NUL-terminated).
+ * @return TIME_OK if successful, TIME_NULL if 'buf' is NULL,
+ * TIME_INVALID if 't' is not in [0, 86399] seconds.
+ */
+int timeFormat(Time t, char *buf);
+
 /**
  * @brief Creates a new Time instance with the given hour, minute, and second.
  * 
@@ -52,6 +249,23 @@ PtTime timeNow(void);
  */
 PtTime timeCreate(int hour, int minute, int second);
 
+/**
+ * @brief Creates a new Time instance from a value.
+ * 
+ * @param value The time, in [0, 86399] seconds.
+ * @return A pointer to a new Time instance, or NULL if the value is invalid or there is no memory.
+ */
+PtTime timeCreateV(Time value);
+
+/**
+ * @brief Retrieves the value of a Time instance.
+ * 
+ * @param t Pointer to a Time instance.
+ * @param value Address to store the value.
+ * @return TIME_OK if successful, TIME_NULL if input is NULL.
+ */
+int timeValue(PtTime t, Time *value);
+
 /**
  * @brief Destroys a Time instance and sets the pointer to NULL.
  * 
@@ -0,0 +1,120 @@
+/**
+ * @file timeBatchMain.c
+ * @brief Verifies the 'Batch' operations of mytime.h against the PtTime
+ * operations, and times them over arrays of time-of-day records.
+ *
+ * Usage: prog [n]
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+#include "mytime.h"
+
+#define DEFAULT_N 10000000
+#define REPETITIONS 10
+
+static double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static Time randomTime() {
+    return timeFromSecondsV(rand() % TIME_DAY_SECONDS);
+}
+
+int main(int argc, char **argv) {
+    int n = (argc > 1) ? atoi(argv[1]) : DEFAULT_N;
+    if(n < 1) {
+        printf("Usage: %s [n]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /* clock in and clock out times of 'n' records */
+    Time *in = malloc(n * sizeof(Time));
+    Time *out = malloc(n * sizeof(Time));
+    Time *worked = malloc(n * sizeof(Time));
+    Time *next = malloc(n * sizeof(Time));
+    int *order = malloc(n * sizeof(int));
+
+    if(!in || !out || !worked || !next || !order) {
+        printf("Could not allocate arrays.\n");
+        return EXIT_FAILURE;
+    }
+
+    srand(42);
+    for(int i = 0; i < n; i++) {
+        in[i] = randomTime();
+        out[i] = randomTime();
+    }
+
+    /* worked time with PtTime, allocating each operand and result */
+    double start = seconds();
+    long checksum = 0;
+    bool passed = true;
+    for(int i = 0; i < n; i++) {
+        PtTime tIn = timeCreateV(in[i]);
+        PtTime tOut = timeCreateV(out[i]);
+        PtTime tWorked = timeDiff(tOut, tIn);
+
+        int total;
+        timeToSeconds(tWorked, &total);
+        checksum += total;
+
+        timeDestroy(&tIn);
+        timeDestroy(&tOut);
+        timeDestroy(&tWorked);
+    }
+    double elapsedPt = seconds() - start;
+
+    /* the same with packed times; the first run also touches the pages of 'worked' */
+    timeDiffBatch(out, in, worked, n);
+    start = seconds();
+    for(int r = 0; r < REPETITIONS; r++) {
+        timeDiffBatch(out, in, worked, n);
+    }
+    double elapsedBatch = (seconds() - start) / REPETITIONS;
+
+    long batchChecksum = 0;
+    for(int i = 0; i < n; i++) batchChecksum += worked[i].seconds;
+    passed &= (checksum == batchChecksum);
+
+    /* the remaining operations, against their 'V' counterparts */
+    Time eightHours = timeV(8, 0, 0);
+
+    timeShiftBatch(out, eightHours, next, n);
+    timeCompareBatch(worked, next, order, n);
+    timeAddBatch(next, worked, next, n);
+
+    start = seconds();
+    for(int r = 0; r < REPETITIONS; r++) {
+        timeShiftBatch(out, eightHours, next, n);
+        timeCompareBatch(worked, next, order, n);
+        timeAddBatch(next, worked, next, n);
+    }
+    double elapsedOthers = (seconds() - start) / REPETITIONS;
+
+    for(int i = 0; i < n; i++) {
+        Time shifted = timeAddV(out[i], eightHours);
+        passed &= (order[i] == timeCompareV(worked[i], shifted));
+        passed &= (next[i].seconds == timeAddV(shifted, worked[i]).seconds);
+        passed &= (next[i].seconds >= 0 && next[i].seconds < TIME_DAY_SECONDS);
+    }
+
+    printf("Batch operations %s the PtTime and 'V' operations.\n\n",
+            passed ? "match" : "DO NOT MATCH");
+
+    printf("Time of the difference of %d pairs of times (ns per element):\n", n);
+    printf("%-14s: %7.2f\n", "PtTime", elapsedPt * 1e9 / n);
+    printf("%-14s: %7.2f (%.0fx)\n", "timeDiffBatch", elapsedBatch * 1e9 / n, elapsedPt / elapsedBatch);
+    printf("%-14s: %7.2f (shift, compare and add)\n", "other batches", elapsedOthers * 1e9 / n);
+
+    free(in); free(out); free(worked); free(next); free(order);
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
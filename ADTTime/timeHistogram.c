@@ -0,0 +1,165 @@
+#include <stdlib.h>
+#include <string.h>
+#include "timeHistogram.h"
+
+#define DAY_MINUTES 1440
+#define DAY_HOURS   24
+
+typedef struct timeHistogram {
+    long seconds[TIME_DAY_SECONDS];
+    long minutes[DAY_MINUTES];      /* rollup: minutes[m] is the sum of seconds[60m .. 60m + 59] */
+    long hours[DAY_HOURS];          /* rollup: hours[h] is the sum of minutes[60h .. 60h + 59] */
+    long total;
+} TimeHistogram;
+
+static inline int isValid(Time t) {
+    return t.seconds >= 0 && t.seconds < TIME_DAY_SECONDS;
+}
+
+/**
+ * @brief Auxiliary function to sum the counts of the seconds before
+ * 'end' (in [0, 86400]), using whole hours and minutes where possible.
+ */
+static long prefixSum(PtTimeHistogram hist, int end) {
+    long sum = 0;
+
+    int hourEnd = end / 3600;
+    for(int h = 0; h < hourEnd; h++) sum += hist->hours[h];
+
+    int minuteEnd = end / 60;
+    for(int m = hourEnd * 60; m < minuteEnd; m++) sum += hist->minutes[m];
+
+    for(int s = minuteEnd * 60; s < end; s++) sum += hist->seconds[s];
+
+    return sum;
+}
+
+PtTimeHistogram timeHistogramCreate() {
+    PtTimeHistogram hist = (PtTimeHistogram)calloc(1, sizeof(TimeHistogram));
+    return hist; // NULL if there is no memory
+}
+
+int timeHistogramDestroy(PtTimeHistogram *ptHist) {
+    if (ptHist == NULL || *ptHist == NULL) return TIME_NULL;
+
+    free(*ptHist);
+    *ptHist = NULL;
+
+    return TIME_OK;
+}
+
+int timeHistogramClear(PtTimeHistogram hist) {
+    if (hist == NULL) return TIME_NULL;
+
+    memset(hist, 0, sizeof(TimeHistogram));
+
+    return TIME_OK;
+}
+
+int timeHistogramAdd(PtTimeHistogram hist, Time t, long count) {
+    if (hist == NULL) return TIME_NULL;
+    if (!isValid(t)) return TIME_INVALID;
+
+    hist->seconds[t.seconds] += count;
+    hist->minutes[t.seconds / 60] += count;
+    hist->hours[t.seconds / 3600] += count;
+    hist->total += count;
+
+    return TIME_OK;
+}
+
+int timeHistogramAddBatch(PtTimeHistogram hist, const Time *times, int n) {
+    if (hist == NULL || times == NULL) return TIME_NULL;
+
+    int rc = TIME_OK;
+    for(int i = 0; i < n; i++) {
+        if (timeHistogramAdd(hist, times[i], 1) != TIME_OK) rc = TIME_INVALID;
+    }
+
+    return rc;
+}
+
+int timeHistogramCount(PtTimeHistogram hist, Time t, long *count) {
+    if (hist == NULL || count == NULL) return TIME_NULL;
+    if (!isValid(t)) return TIME_INVALID;
+
+    *count = hist->seconds[t.seconds];
+    return TIME_OK;
+}
+
+int timeHistogramMinuteCount(PtTimeHistogram hist, Time t, long *count) {
+    if (hist == NULL || count == NULL) return TIME_NULL;
+    if (!isValid(t)) return TIME_INVALID;
+
+    *count = hist->minutes[t.seconds / 60];
+    return TIME_OK;
+}
+
+int timeHistogramHourCount(PtTimeHistogram hist, Time t, long *count) {
+    if (hist == NULL || count == NULL) return TIME_NULL;
+    if (!isValid(t)) return TIME_INVALID;
+
+    *count = hist->hours[t.seconds / 3600];
+    return TIME_OK;
+}
+
+int timeHistogramTotal(PtTimeHistogram hist, long *count) {
+    if (hist == NULL || count == NULL) return TIME_NULL;
+
+    *count = hist->total;
+    return TIME_OK;
+}
+
+int timeHistogramSum(PtTimeHistogram hist, Time from, Time to, long *sum) {
+    if (hist == NULL || sum == NULL) return TIME_NULL;
+    if (!isValid(from) || !isValid(to)) return TIME_INVALID;
+
+    long toEnd = prefixSum(hist, to.seconds + 1);
+    long beforeFrom = prefixSum(hist, from.seconds);
+
+    if (from.seconds <= to.seconds) {
+        *sum = toEnd - beforeFrom;
+    } else {
+        // Wraps around midnight: from 'from' to 23:59:59, then from 00:00:00 to 'to'
+        *sum = (hist->total - beforeFrom) + toEnd;
+    }
+
+    return TIME_OK;
+}
+
+int timeHistogramWindow(PtTimeHistogram hist, PtTime from, PtTime to, long *sum) {
+    if (hist == NULL || from == NULL || to == NULL || sum == NULL) return TIME_NULL;
+
+    Time fromValue, toValue;
+    timeValue(from, &fromValue);
+    timeValue(to, &toValue);
+
+    return timeHistogramSum(hist, fromValue, toValue, sum);
+}
+
+int timeHistogramBusiestWindow(PtTimeHistogram hist, int width, Time *start, long *sum) {
+    if (hist == NULL || start == NULL || sum == NULL) return TIME_NULL;
+    if (width < 1 || width > TIME_DAY_SECONDS) return TIME_INVALID;
+
+    // Window starting at 00:00:00, then slide it one second at a time
+    long window = prefixSum(hist, width);
+    long best = window;
+    int bestStart = 0;
+
+    for(int s = 1; s < TIME_DAY_SECONDS; s++) {
+        int last = s + width - 1;
+        if (last >= TIME_DAY_SECONDS) last -= TIME_DAY_SECONDS;
+
+        window += hist->seconds[last] - hist->seconds[s - 1];
+
+        if (window > best) {
+            best = window;
+            bestStart = s;
+        }
+    }
+
+    *start = timeFromSecondsV(bestStart);
+    *sum = best;
+
+    return TIME_OK;
+}
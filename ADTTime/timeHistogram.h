@@ -0,0 +1,154 @@
+/**
+ * @file timeHistogram.h
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @brief Specification of the time-of-day histogram
+ *
+ * A histogram counts events per second of the day, in 86400 slots
+ * indexed by Time, and keeps per-minute and per-hour rollups up to date
+ * on each increment. The rollups make every query bounded by a constant:
+ * the sum over any range of times adds at most 24 hours, 2 * 59 minutes
+ * and 2 * 59 seconds, instead of up to 86400 seconds.
+ *
+ * Ranges are inclusive and wrap around at 24:00:00, i.e., the range
+ * from 23:00:00 to 01:00:00 covers two hours and one second.
+ *
+ * @bug No known bugs.
+ */
+#pragma once
+
+#include "mytime.h"
+
+/** @brief Opaque structure representing a time-of-day histogram. */
+struct timeHistogram;
+typedef struct timeHistogram* PtTimeHistogram;
+
+/**
+ * @brief Creates a new histogram, with all counts at zero.
+ *
+ * @return A pointer to a new histogram, or NULL if there is no memory.
+ */
+PtTimeHistogram timeHistogramCreate();
+
+/**
+ * @brief Destroys a histogram and sets the pointer to NULL.
+ *
+ * @param ptHist Address of the histogram pointer.
+ * @return TIME_OK if destroyed successfully, TIME_NULL if input is NULL.
+ */
+int timeHistogramDestroy(PtTimeHistogram *ptHist);
+
+/**
+ * @brief Sets all counts of a histogram to zero.
+ *
+ * @param hist Pointer to a histogram.
+ * @return TIME_OK if successful, TIME_NULL if input is NULL.
+ */
+int timeHistogramClear(PtTimeHistogram hist);
+
+/**
+ * @brief Adds to the count of a second of the day, in O(1) time.
+ *
+ * @param hist Pointer to a histogram.
+ * @param t Second of the day.
+ * @param count Number of events to add (may be negative, to remove events).
+ * @return TIME_OK if successful, TIME_NULL if input is NULL,
+ * TIME_INVALID if 't' is not in [0, 86399] seconds.
+ */
+int timeHistogramAdd(PtTimeHistogram hist, Time t, long count);
+
+/**
+ * @brief Counts one event at each time of an array, e.g., parsed
+ * by timeParseBatch.
+ *
+ * Invalid times are skipped.
+ *
+ * @param hist Pointer to a histogram.
+ * @param times Array of times.
+ * @param n Number of times.
+ * @return TIME_OK if successful, TIME_NULL if any input is NULL,
+ * TIME_INVALID if any time is not in [0, 86399] seconds.
+ */
+int timeHistogramAddBatch(PtTimeHistogram hist, const Time *times, int n);
+
+/**
+ * @brief Retrieves the count of a second of the day.
+ *
+ * @param hist Pointer to a histogram.
+ * @param t Second of the day.
+ * @param count Address to store the count.
+ * @return TIME_OK if successful, TIME_NULL if any input is NULL,
+ * TIME_INVALID if 't' is not in [0, 86399] seconds.
+ */
+int timeHistogramCount(PtTimeHistogram hist, Time t, long *count);
+
+/**
+ * @brief Retrieves the count of the minute that contains a time.
+ *
+ * @param hist Pointer to a histogram.
+ * @param t Time within the minute (e.g., 10:15:00 for 10:15).
+ * @param count Address to store the count.
+ * @return TIME_OK if successful, TIME_NULL if any input is NULL,
+ * TIME_INVALID if 't' is not in [0, 86399] seconds.
+ */
+int timeHistogramMinuteCount(PtTimeHistogram hist, Time t, long *count);
+
+/**
+ * @brief Retrieves the count of the hour that contains a time.
+ *
+ * @param hist Pointer to a histogram.
+ * @param t Time within the hour (e.g., 10:00:00 for 10h).
+ * @param count Address to store the count.
+ * @return TIME_OK if successful, TIME_NULL if any input is NULL,
+ * TIME_INVALID if 't' is not in [0, 86399] seconds.
+ */
+int timeHistogramHourCount(PtTimeHistogram hist, Time t, long *count);
+
+/**
+ * @brief Retrieves the count of all events of a histogram.
+ *
+ * @param hist Pointer to a histogram.
+ * @param count Address to store the count.
+ * @return TIME_OK if successful, TIME_NULL if any input is NULL.
+ */
+int timeHistogramTotal(PtTimeHistogram hist, long *count);
+
+/**
+ * @brief Sums the counts of a range of times, in O(1) time.
+ *
+ * @param hist Pointer to a histogram.
+ * @param from First time of the range.
+ * @param to Last time of the range (earlier than 'from' if the range wraps around).
+ * @param sum Address to store the sum.
+ * @return TIME_OK if successful, TIME_NULL if any input is NULL,
+ * TIME_INVALID if 'from' or 'to' are not in [0, 86399] seconds.
+ */
+int timeHistogramSum(PtTimeHistogram hist, Time from, Time to, long *sum);
+
+/**
+ * @brief Sums the counts of the window of times between two Time instances.
+ *
+ * Example: the events of the last five minutes up to 'now' are those
+ * of the window from timeDiff(now, 00:04:59) to 'now'.
+ *
+ * @param hist Pointer to a histogram.
+ * @param from First time of the window.
+ * @param to Last time of the window (earlier than 'from' if the window wraps around).
+ * @param sum Address to store the sum.
+ * @return TIME_OK if successful, TIME_NULL if any input is NULL.
+ */
+int timeHistogramWindow(PtTimeHistogram hist, PtTime from, PtTime to, long *sum);
+
+/**
+ * @brief Finds the window of a given width with the most events,
+ * sliding it over the whole day (including windows that wrap around).
+ *
+ * Takes O(86400) time. Ties are resolved by the earliest start.
+ *
+ * @param hist Pointer to a histogram.
+ * @param width Width of the window, in seconds, in [1, 86400].
+ * @param start Address to store the first time of the window.
+ * @param sum Address to store the sum of the window.
+ * @return TIME_OK if successful, TIME_NULL if any input is NULL,
+ * TIME_INVALID if 'width' is not in [1, 86400].
+ */
+int timeHistogramBusiestWindow(PtTimeHistogram hist, int width, Time *start, long *sum);
@@ -0,0 +1,179 @@
+/**
+ * @file timeHistogramMain.c
+ * @brief Verifies the queries of timeHistogram.h against direct sums,
+ * and times the histogram against a PtMap keyed by the seconds of the day.
+ *
+ * Usage: prog [n]
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+#include "mytime.h"
+#include "timeHistogram.h"
+#include "map.h"
+
+#define DEFAULT_N 10000000
+#define MAP_EVENTS 100000    /* the map takes O(keys) per event */
+#define QUERIES 1000000
+#define MAP_QUERIES 1000
+
+static double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/** A time of the day, concentrated around 09:00 and 14:00. */
+static Time randomEvent() {
+    int peak = (rand() % 2) ? 9 * 3600 : 14 * 3600;
+    int spread = rand() % 7200 - rand() % 7200;
+    return timeFromSecondsV((rand() % 4 == 0) ? rand() : peak + spread);
+}
+
+/** Direct sum of the seconds from 'from' to 'to', wrapping around. */
+static long directSum(const long *counts, int from, int to) {
+    long sum = 0;
+    for(int s = from; ; s = (s + 1) % TIME_DAY_SECONDS) {
+        sum += counts[s];
+        if(s == to) break;
+    }
+    return sum;
+}
+
+static void addValue(MapKey key, MapValue value, void *context) {
+    (void)key;
+    *(long*)context += value;
+}
+
+int main(int argc, char **argv) {
+    int n = (argc > 1) ? atoi(argv[1]) : DEFAULT_N;
+    if(n < MAP_EVENTS) {
+        printf("Usage: %s [n >= %d]\n", argv[0], MAP_EVENTS);
+        return EXIT_FAILURE;
+    }
+
+    Time *events = malloc(n * sizeof(Time));
+    long *counts = calloc(TIME_DAY_SECONDS, sizeof(long));
+    PtTimeHistogram hist = timeHistogramCreate();
+
+    if(!events || !counts || !hist) {
+        printf("Could not allocate memory.\n");
+        return EXIT_FAILURE;
+    }
+
+    srand(42);
+    for(int i = 0; i < n; i++) {
+        events[i] = randomEvent();
+        counts[events[i].seconds]++;
+    }
+
+    double start = seconds();
+    timeHistogramAddBatch(hist, events, n);
+    double elapsedAdd = seconds() - start;
+
+    /* verification against the direct sums */
+    bool passed = true;
+    long value, total;
+
+    timeHistogramTotal(hist, &total);
+    passed &= (total == n);
+
+    for(int s = 0; s < TIME_DAY_SECONDS; s++) {
+        Time t = timeFromSecondsV(s);
+        timeHistogramCount(hist, t, &value);
+        passed &= (value == counts[s]);
+
+        timeHistogramMinuteCount(hist, t, &value);
+        passed &= (value == directSum(counts, s - s % 60, s - s % 60 + 59));
+
+        timeHistogramHourCount(hist, t, &value);
+        passed &= (value == directSum(counts, s - s % 3600, s - s % 3600 + 3599));
+    }
+
+    for(int q = 0; q < 2000; q++) {
+        Time from = timeFromSecondsV(rand()), to = timeFromSecondsV(rand());
+        timeHistogramSum(hist, from, to, &value);
+        passed &= (value == directSum(counts, from.seconds, to.seconds));
+    }
+
+    /* the busiest five minutes, against sliding a direct sum */
+    Time busiest;
+    long busiestSum, best = -1;
+    timeHistogramBusiestWindow(hist, 300, &busiest, &busiestSum);
+    for(int s = 0; s < TIME_DAY_SECONDS; s++) {
+        long sum = directSum(counts, s, (s + 299) % TIME_DAY_SECONDS);
+        if(sum > best) best = sum;
+    }
+    passed &= (busiestSum == best);
+    passed &= (directSum(counts, busiest.seconds, (busiest.seconds + 299) % TIME_DAY_SECONDS) == best);
+
+    /* a window between two PtTime, wrapping around midnight */
+    PtTime from = timeCreate(23, 30, 0);
+    PtTime to = timeCreate(0, 29, 59);
+    timeHistogramWindow(hist, from, to, &value);
+    passed &= (value == directSum(counts, 23 * 3600 + 30 * 60, 29 * 60 + 59));
+    timeDestroy(&from);
+    timeDestroy(&to);
+
+    printf("Histogram queries %s the direct sums.\n", passed ? "match" : "DO NOT MATCH");
+
+    char buf[8];
+    timeFormat(busiest, buf);
+    printf("Busiest five minutes start at %.8s, with %ld of %ld events.\n\n", buf, busiestSum, total);
+
+    /* timing of the range queries */
+    Time *ranges = malloc(2 * QUERIES * sizeof(Time));
+    if(ranges == NULL) {
+        printf("Could not allocate memory.\n");
+        return EXIT_FAILURE;
+    }
+    for(int q = 0; q < 2 * QUERIES; q++) ranges[q] = timeFromSecondsV(rand());
+
+    long checksum = 0;
+    start = seconds();
+    for(int q = 0; q < QUERIES; q++) {
+        timeHistogramSum(hist, ranges[2 * q], ranges[2 * q + 1], &value);
+        checksum += value;
+    }
+    double elapsedSum = seconds() - start;
+
+    /* the same with a PtMap, on fewer events and queries */
+    PtMap map = mapCreate();
+    start = seconds();
+    for(int i = 0; i < MAP_EVENTS; i++) {
+        MapValue *count;
+        mapGetOrInsertPtr(map, events[i].seconds, 0, &count);
+        (*count)++;
+    }
+    double elapsedMapAdd = seconds() - start;
+
+    long mapChecksum = 0;
+    start = seconds();
+    for(int q = 0; q < MAP_QUERIES; q++) {
+        int lo = ranges[2 * q].seconds, hi = ranges[2 * q + 1].seconds;
+        if(lo <= hi) {
+            mapRange(map, lo, hi, addValue, &mapChecksum);
+        } else {
+            mapRange(map, lo, TIME_DAY_SECONDS - 1, addValue, &mapChecksum);
+            mapRange(map, 0, hi, addValue, &mapChecksum);
+        }
+    }
+    double elapsedMapSum = seconds() - start;
+    mapDestroy(&map);
+
+    printf("%-10s: %10.1f ns/event, %10.1f ns/range sum (%d events)\n", "PtMap",
+           elapsedMapAdd * 1e9 / MAP_EVENTS, elapsedMapSum * 1e9 / MAP_QUERIES, MAP_EVENTS);
+    printf("%-10s: %10.1f ns/event, %10.1f ns/range sum (%d events)\n", "histogram",
+           elapsedAdd * 1e9 / n, elapsedSum * 1e9 / QUERIES, n);
+    printf("(checksums %ld, %ld)\n", checksum, mapChecksum);
+
+    timeHistogramDestroy(&hist);
+    free(events); free(counts); free(ranges);
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
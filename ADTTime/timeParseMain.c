@@ -0,0 +1,150 @@
+/**
+ * @file timeParseMain.c
+ * @brief Verifies timeParse, timeParseBatch and timeFormat against
+ * sscanf and snprintf, and compares their throughputs on a log column
+ * of "HH:MM:SS\n" lines.
+ *
+ * Usage: prog [n]
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include "mytime.h"
+
+#define DEFAULT_N 10000000
+#define LINE 9  /* "HH:MM:SS\n" */
+
+static double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static void report(const char *name, double elapsed, int n) {
+    printf("%-26s: %8.2f ns/record, %8.1f M records/s\n", name, elapsed * 1e9 / n, n / elapsed / 1e6);
+}
+
+/** Checks that timeParse accepts exactly the valid times, comparing with sscanf. */
+static bool verifyParse() {
+    const char *samples[] = { "00:00:00", "23:59:59", "09:22:40", "9:22:40", "24:00:00", "12:60:00",
+                              "12:00:60", "12-00-00", "1a:00:00", "12:00:0", "12:00:000", "  :00:00",
+                              "/0:00:00", ":0:00:00", "12;00:00", "99:99:99" };
+    bool passed = true;
+
+    for(size_t i = 0; i < sizeof(samples) / sizeof(samples[0]); i++) {
+        const char *s = samples[i];
+        int len = strlen(s);
+        int h, m, sec, consumed = 0;
+        bool expected = sscanf(s, "%2d:%2d:%2d%n", &h, &m, &sec, &consumed) == 3 && consumed == len
+                        && s[len - 3] == ':' && s[len - 6] == ':' && s[0] != ' '
+                        && h >= 0 && h < 24 && m >= 0 && m < 60 && sec >= 0 && sec < 60;
+
+        Time t;
+        int rc = timeParse(s, len, &t);
+        bool ok = (rc == TIME_OK) == expected;
+        if(ok && expected) ok = (t.seconds == timeV(h, m, sec).seconds);
+
+        if(!ok) printf("timeParse(\"%s\") FAILED\n", s);
+        passed &= ok;
+    }
+
+    return passed;
+}
+
+int main(int argc, char **argv) {
+    int n = (argc > 1) ? atoi(argv[1]) : DEFAULT_N;
+    if(n < 1) {
+        printf("Usage: %s [n]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    char *log = malloc((size_t)n * LINE + 1);
+    char *formatted = malloc((size_t)n * LINE + 1);
+    Time *times = malloc(n * sizeof(Time));
+    Time *parsed = malloc(n * sizeof(Time));
+
+    if(!log || !formatted || !times || !parsed) {
+        printf("Could not allocate arrays.\n");
+        return EXIT_FAILURE;
+    }
+
+    srand(42);
+    for(int i = 0; i < n; i++) {
+        char line[32];
+        times[i] = timeFromSecondsV(rand() % TIME_DAY_SECONDS);
+        snprintf(line, sizeof(line), "%02d:%02d:%02d\n",
+                 timeHourV(times[i]), timeMinuteV(times[i]), timeSecondV(times[i]));
+        memcpy(log + (size_t)i * LINE, line, LINE);
+    }
+
+    bool passed = verifyParse();
+
+    printf("Throughput over %d lines \"HH:MM:SS\\n\":\n", n);
+
+    /* parsing; sscanf needs each line as a string, as read by fgets */
+    double start = seconds();
+    long checksum = 0;
+    for(int i = 0; i < n; i++) {
+        char line[LINE + 1];
+        memcpy(line, log + (size_t)i * LINE, LINE);
+        line[LINE] = '\0';
+
+        int h, m, s;
+        sscanf(line, "%d:%d:%d", &h, &m, &s);
+        PtTime t = timeCreate(h, m, s);
+        int total;
+        timeToSeconds(t, &total);
+        checksum += total;
+        timeDestroy(&t);
+    }
+    report("sscanf + timeCreate", seconds() - start, n);
+
+    start = seconds();
+    long parseChecksum = 0;
+    for(int i = 0; i < n; i++) {
+        Time t;
+        timeParse(log + (size_t)i * LINE, 8, &t);
+        parseChecksum += t.seconds;
+    }
+    report("timeParse", seconds() - start, n);
+    passed &= (parseChecksum == checksum);
+
+    memset(parsed, 0, n * sizeof(Time));
+    start = seconds();
+    passed &= (timeParseBatch(log, LINE, parsed, n) == TIME_OK);
+    report("timeParseBatch", seconds() - start, n);
+    passed &= (memcmp(parsed, times, n * sizeof(Time)) == 0);
+
+    /* formatting */
+    memset(formatted, 0, (size_t)n * LINE + 1);
+    start = seconds();
+    for(int i = 0; i < n; i++) {
+        char line[32];
+        snprintf(line, sizeof(line), "%02d:%02d:%02d\n",
+                 timeHourV(times[i]), timeMinuteV(times[i]), timeSecondV(times[i]));
+        memcpy(formatted + (size_t)i * LINE, line, LINE);
+    }
+    report("snprintf", seconds() - start, n);
+
+    memset(formatted, 0, (size_t)n * LINE + 1);
+    start = seconds();
+    for(int i = 0; i < n; i++) {
+        char *line = formatted + (size_t)i * LINE;
+        timeFormat(times[i], line);
+        line[8] = '\n';
+    }
+    report("timeFormat", seconds() - start, n);
+    passed &= (memcmp(formatted, log, (size_t)n * LINE) == 0);
+
+    printf("\nResults %s sscanf and snprintf.\n", passed ? "match" : "DO NOT MATCH");
+
+    free(log); free(formatted); free(times); free(parsed);
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,339 @@
+/**
+ * @file benchCommon.c
+ *
+ * @brief Provides an implementation of the support code shared by
+ * the benchmark drivers.
+ *
+ * Every run is forked into a child process, which sends its
+ * BenchResult back through a pipe; the parent obtains the peak RSS of
+ * the child from wait4. Allocation counts are only available when
+ * compiled with BENCH_COUNT_ALLOCS defined and linked with the
+ * corresponding --wrap options (see the makefile); otherwise they are
+ * reported as -1.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "benchCommon.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+#define MAX_SIZES 32
+#define DEFAULT_BUDGET 1.0
+#define RANDOM_SEED 0x9E3779B97F4A7C15ULL
+
+/** Terms of the zeta function summed exactly; the tail is integrated. */
+#define ZETA_EXACT_TERMS 1000000
+
+static long allocCount = 0;
+static long freeCount = 0;
+
+#ifdef BENCH_COUNT_ALLOCS
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+void* __wrap_malloc(size_t size) {
+	allocCount++;
+	return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+	allocCount++;
+	return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void *ptr, size_t size) {
+	allocCount++;
+	return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void *ptr) {
+	if (ptr != NULL) freeCount++;
+	__real_free(ptr);
+}
+
+#endif
+
+static double budgetSeconds;
+static struct timespec deadline;
+static struct timespec beginTime;
+static long beginAllocs, beginFrees;
+static uint64_t randomState;
+
+static double secondsBetween(struct timespec start, struct timespec end) {
+	return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+static void startBudget(void) {
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+	deadline.tv_sec += (time_t)budgetSeconds;
+	deadline.tv_nsec += (long)((budgetSeconds - (time_t)budgetSeconds) * 1e9);
+	if (deadline.tv_nsec >= 1000000000L) {
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000L;
+	}
+}
+
+void benchBegin(BenchResult *result) {
+	result->ops = 0;
+	result->seconds = 0;
+	result->complete = false;
+
+	beginAllocs = allocCount;
+	beginFrees = freeCount;
+
+	/* the setup and the measured operations have a budget each */
+	startBudget();
+	clock_gettime(CLOCK_MONOTONIC, &beginTime);
+}
+
+void benchEnd(BenchResult *result, long ops, bool complete) {
+	struct timespec endTime;
+	clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+	result->ops = ops;
+	result->seconds = secondsBetween(beginTime, endTime);
+	result->complete = complete;
+
+#ifdef BENCH_COUNT_ALLOCS
+	result->allocs = allocCount - beginAllocs;
+	result->frees = freeCount - beginFrees;
+#else
+	result->allocs = -1;
+	result->frees = -1;
+#endif
+}
+
+bool benchTimeUp(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return secondsBetween(deadline, now) > 0;
+}
+
+long benchOps(int size) {
+	return (size > BENCH_MIN_OPS) ? size : BENCH_MIN_OPS;
+}
+
+uint64_t benchRandom(void) {
+	randomState ^= randomState >> 12;
+	randomState ^= randomState << 25;
+	randomState ^= randomState >> 27;
+	return randomState * 0x2545F4914F6CDD1DULL;
+}
+
+int benchRandomBelow(int n) {
+	return (int)((benchRandom() >> 32) % (uint64_t)n);
+}
+
+int benchKey(int i) {
+	/* multiplication by an odd constant is a bijection modulo 2^32 */
+	return (int)((uint32_t)i * 2654435761u);
+}
+
+static double zeta(int n, double theta) {
+	int exactTerms = (n < ZETA_EXACT_TERMS) ? n : ZETA_EXACT_TERMS;
+
+	double sum = 0;
+	for (int i = 1; i <= exactTerms; i++) {
+		sum += 1.0 / pow(i, theta);
+	}
+
+	if (n > exactTerms) {
+		sum += (pow(n, 1 - theta) - pow(exactTerms, 1 - theta)) / (1 - theta);
+	}
+
+	return sum;
+}
+
+/* Gray et al., "Quickly generating billion-record synthetic databases" */
+void benchZipfInit(BenchZipf *zipf, int n, double theta) {
+	zipf->n = n;
+	zipf->theta = theta;
+	zipf->alpha = 1.0 / (1.0 - theta);
+	zipf->zetan = zeta(n, theta);
+	zipf->eta = (1.0 - pow(2.0 / n, 1.0 - theta)) / (1.0 - zeta(2, theta) / zipf->zetan);
+}
+
+int benchZipfNext(BenchZipf *zipf) {
+	double u = (benchRandom() >> 11) * (1.0 / 9007199254740992.0); /* [0, 1[ */
+	double uz = u * zipf->zetan;
+
+	if (uz < 1.0) return 0;
+	if (uz < 1.0 + pow(0.5, zipf->theta)) return (zipf->n > 1) ? 1 : 0;
+
+	int value = (int)(zipf->n * pow(zipf->eta * u - zipf->eta + 1.0, zipf->alpha));
+
+	return (value < zipf->n) ? value : zipf->n - 1;
+}
+
+/**
+ * Runs a workload in a child process.
+ * Returns 'true' if it finished its setup, with measurements
+ * in 'result' and the peak RSS (in KB) in 'ptMaxRss'.
+ */
+static bool runChild(const BenchWorkload *workload, int size, double budget,
+						BenchResult *result, long *ptMaxRss) {
+	int fds[2];
+	if (pipe(fds) != 0) return false;
+
+	fflush(stdout);
+
+	pid_t pid = fork();
+	if (pid < 0) {
+		close(fds[0]);
+		close(fds[1]);
+		return false;
+	}
+
+	if (pid == 0) {
+		close(fds[0]);
+
+		randomState = RANDOM_SEED;
+		budgetSeconds = budget;
+		startBudget();
+
+		BenchResult childResult;
+		memset(&childResult, 0, sizeof(childResult));
+		if (!workload->run(size, &childResult)) _exit(EXIT_FAILURE);
+
+		ssize_t written = write(fds[1], &childResult, sizeof(childResult));
+		_exit(written == sizeof(childResult) ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	close(fds[1]);
+
+	size_t received = 0;
+	ssize_t count;
+	while (received < sizeof(BenchResult) &&
+			(count = read(fds[0], (char*)result + received, sizeof(BenchResult) - received)) > 0) {
+		received += count;
+	}
+	close(fds[0]);
+
+	int status;
+	struct rusage usage;
+	if (wait4(pid, &status, 0, &usage) < 0) return false;
+
+	*ptMaxRss = usage.ru_maxrss;
+
+	return received == sizeof(BenchResult) && WIFEXITED(status) &&
+			WEXITSTATUS(status) == EXIT_SUCCESS;
+}
+
+static void printResult(bool json, const char *adt, const char *backend, const char *workload,
+						int size, const BenchResult *result, long maxRss) {
+	double nsPerOp = (result->ops > 0) ? result->seconds * 1e9 / result->ops : 0;
+	double opsPerSec = (result->seconds > 0) ? result->ops / result->seconds : 0;
+
+	if (json) {
+		printf("{\"adt\":\"%s\",\"backend\":\"%s\",\"workload\":\"%s\",\"size\":%d,"
+				"\"ops\":%ld,\"ns_per_op\":%.2f,\"ops_per_sec\":%.0f,\"peak_rss_kb\":%ld,"
+				"\"allocs\":%ld,\"frees\":%ld,\"complete\":%s}\n",
+				adt, backend, workload, size, result->ops, nsPerOp, opsPerSec, maxRss,
+				result->allocs, result->frees, result->complete ? "true" : "false");
+	}
+	else {
+		printf("%s,%s,%s,%d,%ld,%.2f,%.0f,%ld,%ld,%ld,%d\n",
+				adt, backend, workload, size, result->ops, nsPerOp, opsPerSec, maxRss,
+				result->allocs, result->frees, result->complete ? 1 : 0);
+	}
+}
+
+static int parseSizes(char *list, int *sizes) {
+	int count = 0;
+	for (char *token = strtok(list, ","); token != NULL && count < MAX_SIZES;
+			token = strtok(NULL, ",")) {
+		int size = atoi(token);
+		if (size < 1) return 0;
+		sizes[count++] = size;
+	}
+	return count;
+}
+
+static void printUsage(const char *program) {
+	fprintf(stderr, "Usage: %s [--sizes 10,100,...] [--budget seconds] "
+			"[--workload name] [--format csv|json] [--no-header]\n", program);
+}
+
+int benchMain(int argc, char **argv, const char *adt, const char *backend,
+				const BenchWorkload *workloads, int count) {
+	int sizes[MAX_SIZES];
+	int numSizes = 0;
+	for (int size = 10; size <= 10000000; size *= 10) sizes[numSizes++] = size;
+
+	double budget = DEFAULT_BUDGET;
+	const char *only = NULL;
+	bool json = false;
+	bool header = true;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) {
+			numSizes = parseSizes(argv[++i], sizes);
+			if (numSizes == 0) {
+				printUsage(argv[0]);
+				return EXIT_FAILURE;
+			}
+		}
+		else if (strcmp(argv[i], "--budget") == 0 && i + 1 < argc) {
+			budget = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--workload") == 0 && i + 1 < argc) {
+			only = argv[++i];
+		}
+		else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+			json = (strcmp(argv[++i], "json") == 0);
+		}
+		else if (strcmp(argv[i], "--no-header") == 0) {
+			header = false;
+		}
+		else {
+			printUsage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (budget <= 0) {
+		printUsage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if (header && !json) {
+		printf("adt,backend,workload,size,ops,ns_per_op,ops_per_sec,"
+				"peak_rss_kb,allocs,frees,complete\n");
+	}
+
+	for (int w = 0; w < count; w++) {
+		if (only != NULL && strcmp(only, workloads[w].name) != 0) continue;
+
+		for (int s = 0; s < numSizes; s++) {
+			BenchResult result;
+			long maxRss = 0;
+
+			if (!runChild(&workloads[w], sizes[s], budget, &result, &maxRss)) {
+				fprintf(stderr, "%s/%s/%s: setup of size %d did not finish, "
+						"skipping larger sizes\n", adt, backend, workloads[w].name, sizes[s]);
+				break;
+			}
+
+			printResult(json, adt, backend, workloads[w].name, sizes[s], &result, maxRss);
+
+			/* larger sizes would not finish either */
+			if (!result.complete) break;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
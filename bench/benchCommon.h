@@ -0,0 +1,170 @@
+/**
+ * @file benchCommon.h
+ * @brief Definition of the support code shared by the benchmark
+ * drivers of the ADTs (benchStack.c, benchQueue.c, benchList.c and
+ * benchMap.c).
+ *
+ * Each driver is linked against one backend of an ADT and defines a set
+ * of workloads; benchMain runs every workload for every size, each run
+ * in a child process so that its peak resident set size (RSS) can be
+ * measured on its own, and prints one CSV row (or JSON object) per run.
+ *
+ * A workload first builds its data structure (setup) and then measures
+ * a number of operations between benchBegin and benchEnd. Each phase
+ * is bounded by its own time budget: workloads poll BENCH_TIME_UP in their
+ * loops and stop early, in which case the run is reported as incomplete
+ * and larger sizes of that workload are skipped.
+ *
+ * Calls to malloc, calloc, realloc and free are counted when linking
+ * with -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Minimum number of measured operations, so small sizes can be timed. */
+#define BENCH_MIN_OPS 1000000L
+
+/** Number of operations between two checks of the time budget. */
+#define BENCH_CHECK_INTERVAL 16
+
+/** True, at every BENCH_CHECK_INTERVAL iterations, if the time budget ran out. */
+#define BENCH_TIME_UP(i) (((i) % BENCH_CHECK_INTERVAL) == 0 && benchTimeUp())
+
+/** Measurements of a run. */
+typedef struct benchResult {
+	long ops;			/* operations measured */
+	double seconds;		/* time taken by those operations */
+	long allocs;		/* calls to malloc, calloc and realloc during them */
+	long frees;			/* calls to free during them */
+	bool complete;		/* false if the time budget ran out */
+} BenchResult;
+
+/**
+ * @brief A workload: builds a data structure with 'size' elements
+ * and measures operations on it.
+ *
+ * @return 'true' if measurements are in 'result', or
+ * @return 'false' if the setup did not finish (time budget or memory)
+ */
+typedef bool (*BenchWorkloadFn)(int size, BenchResult *result);
+
+/** A named workload. */
+typedef struct benchWorkload {
+	const char *name;
+	BenchWorkloadFn run;
+} BenchWorkload;
+
+/**
+ * @brief Runs the workloads of a driver, as instructed by the
+ * command-line arguments, and prints the results.
+ *
+ * Usage: prog [--sizes 10,100,...] [--budget seconds]
+ *             [--workload name] [--format csv|json] [--no-header]
+ *
+ * @param argc [in] number of command-line arguments
+ * @param argv [in] command-line arguments
+ * @param adt [in] name of the ADT
+ * @param backend [in] name of the backend linked into the driver
+ * @param workloads [in] array of workloads
+ * @param count [in] number of workloads
+ *
+ * @return EXIT_SUCCESS, or
+ * @return EXIT_FAILURE if the arguments are invalid
+ */
+int benchMain(int argc, char **argv, const char *adt, const char *backend,
+				const BenchWorkload *workloads, int count);
+
+/**
+ * @brief Starts measuring operations.
+ *
+ * @param result [in] measurements of the run
+ */
+void benchBegin(BenchResult *result);
+
+/**
+ * @brief Stops measuring operations.
+ *
+ * @param result [in] measurements of the run
+ * @param ops [in] number of operations performed since benchBegin
+ * @param complete [in] 'false' if stopped by the time budget
+ */
+void benchEnd(BenchResult *result, long ops, bool complete);
+
+/**
+ * @brief Checks whether the time budget of the current run ran out.
+ *
+ * @return 'true' if it ran out, or
+ * @return 'false' otherwise
+ */
+bool benchTimeUp(void);
+
+/**
+ * @brief Number of operations to measure for a given size.
+ *
+ * @param size [in] number of elements of the data structure
+ *
+ * @return the greater of 'size' and BENCH_MIN_OPS
+ */
+long benchOps(int size);
+
+/**
+ * @brief Generates a pseudo-random number (xorshift64*).
+ *
+ * The sequence restarts at every run, so all backends see the same one.
+ *
+ * @return a pseudo-random 64-bit number
+ */
+uint64_t benchRandom(void);
+
+/**
+ * @brief Generates a pseudo-random integer in [0, n - 1].
+ *
+ * @param n [in] upper bound (exclusive), greater than zero
+ *
+ * @return a pseudo-random integer
+ */
+int benchRandomBelow(int n);
+
+/**
+ * @brief Maps 0, 1, 2, ... to distinct keys scattered over the
+ * range of 'int', so that keys are not inserted in ascending order.
+ *
+ * @param i [in] index of the key
+ *
+ * @return the key
+ */
+int benchKey(int i);
+
+/** State of a generator of Zipf-distributed integers. */
+typedef struct benchZipf {
+	int n;
+	double theta;
+	double alpha;
+	double zetan;
+	double eta;
+} BenchZipf;
+
+/**
+ * @brief Initializes a generator of Zipf-distributed integers
+ * in [0, n - 1], where 0 is the most frequent one.
+ *
+ * @param zipf [in] address of the generator
+ * @param n [in] number of distinct integers
+ * @param theta [in] skew, in ]0, 1[ (e.g., 0.99)
+ */
+void benchZipfInit(BenchZipf *zipf, int n, double theta);
+
+/**
+ * @brief Generates a Zipf-distributed integer.
+ *
+ * @param zipf [in] address of the generator
+ *
+ * @return an integer in [0, n - 1]
+ */
+int benchZipfNext(BenchZipf *zipf);
@@ -0,0 +1,183 @@
+/**
+ * @file benchList.c
+ *
+ * @brief Provides the benchmark driver of the ADT List.
+ * Please note that the ListElem type must be defined as 'int'.
+ *
+ * The backend is chosen at link time; BACKEND names it in the output.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include <stdlib.h>
+#include "benchCommon.h"
+#include "list.h"
+
+#ifndef BACKEND
+#define BACKEND "unknown"
+#endif
+
+/** Creates a list with 'size' elements, or NULL if the setup did not finish. */
+static PtList createFilled(int size) {
+	PtList list = listCreate();
+	if (list == NULL) return NULL;
+
+	for (int i = 0; i < size; i++) {
+		if (BENCH_TIME_UP(i) || listAdd(list, i, i) != LIST_OK) {
+			listDestroy(&list);
+			return NULL;
+		}
+	}
+
+	return list;
+}
+
+/** Appends 'size' elements and clears the list with 'clear', repeatedly. */
+static bool fillClear(int size, BenchResult *result, int (*clear)(PtList)) {
+	PtList list = listCreate();
+	if (list == NULL) return false;
+
+	long ops = benchOps(size), done = 0;
+	bool complete = true;
+
+	benchBegin(result);
+	while (done < ops && complete) {
+		for (int i = 0; i < size; i++, done++) {
+			if (BENCH_TIME_UP(done)) {
+				complete = false;
+				break;
+			}
+			listAdd(list, i, i);
+		}
+		clear(list);
+	}
+	benchEnd(result, done, complete);
+
+	listDestroy(&list);
+	return true;
+}
+
+/** Appends 'size' elements and clears the list, repeatedly. */
+static bool appendClear(int size, BenchResult *result) {
+	return fillClear(size, result, listClear);
+}
+
+/** Same as appendClear, but the list keeps its memory when cleared. */
+static bool appendClearRetain(int size, BenchResult *result) {
+	return fillClear(size, result, listClearRetain);
+}
+
+/** Gets the elements by ascending rank, repeatedly. */
+static bool getSequential(int size, BenchResult *result) {
+	PtList list = createFilled(size);
+	if (list == NULL) return false;
+
+	long ops = benchOps(size), done;
+	ListElem elem;
+
+	benchBegin(result);
+	for (done = 0; done < ops; done++) {
+		if (BENCH_TIME_UP(done)) break;
+		listGet(list, (int)(done % size), &elem);
+	}
+	benchEnd(result, done, done >= ops);
+
+	listDestroy(&list);
+	return true;
+}
+
+/** Gets elements at uniformly random ranks. */
+static bool getRandom(int size, BenchResult *result) {
+	PtList list = createFilled(size);
+	if (list == NULL) return false;
+
+	long ops = benchOps(size), done;
+	ListElem elem;
+
+	benchBegin(result);
+	for (done = 0; done < ops; done++) {
+		if (BENCH_TIME_UP(done)) break;
+		listGet(list, benchRandomBelow(size), &elem);
+	}
+	benchEnd(result, done, done >= ops);
+
+	listDestroy(&list);
+	return true;
+}
+
+/** Sets (70%) or gets (30%) elements at uniformly random ranks. */
+static bool mixedRandom(int size, BenchResult *result) {
+	PtList list = createFilled(size);
+	if (list == NULL) return false;
+
+	long ops = benchOps(size), done;
+	ListElem elem;
+
+	benchBegin(result);
+	for (done = 0; done < ops; done++) {
+		if (BENCH_TIME_UP(done)) break;
+		int rank = benchRandomBelow(size);
+		if (benchRandomBelow(10) < 7) listSet(list, rank, (int)done, &elem);
+		else listGet(list, rank, &elem);
+	}
+	benchEnd(result, done, done >= ops);
+
+	listDestroy(&list);
+	return true;
+}
+
+/** Inserts and removes one element at a time, at uniformly random ranks. */
+static bool insertRemoveRandom(int size, BenchResult *result) {
+	PtList list = createFilled(size);
+	if (list == NULL) return false;
+
+	long ops = benchOps(size), done;
+	ListElem elem;
+
+	benchBegin(result);
+	for (done = 0; done < ops; done += 2) {
+		if (BENCH_TIME_UP(done)) break;
+		listAdd(list, benchRandomBelow(size + 1), (int)done);
+		listRemove(list, benchRandomBelow(size + 1), &elem);
+	}
+	benchEnd(result, done, done >= ops);
+
+	listDestroy(&list);
+	return true;
+}
+
+/** Inserts and removes one element at a time, at rank 0. */
+static bool insertRemoveFront(int size, BenchResult *result) {
+	PtList list = createFilled(size);
+	if (list == NULL) return false;
+
+	long ops = benchOps(size), done;
+	ListElem elem;
+
+	benchBegin(result);
+	for (done = 0; done < ops; done += 2) {
+		if (BENCH_TIME_UP(done)) break;
+		listAdd(list, 0, (int)done);
+		listRemove(list, 0, &elem);
+	}
+	benchEnd(result, done, done >= ops);
+
+	listDestroy(&list);
+	return true;
+}
+
+static const BenchWorkload workloads[] = {
+	{ "append-clear", appendClear },
+	{ "append-clear-retain", appendClearRetain },
+	{ "get-sequential", getSequential },
+	{ "get-random", getRandom },
+	{ "mixed-random", mixedRandom },
+	{ "insert-remove-random", insertRemoveRandom },
+	{ "insert-remove-front", insertRemoveFront }
+};
+
+int main(int argc, char** argv) {
+	return benchMain(argc, argv, "list", BACKEND, workloads,
+						sizeof(workloads) / sizeof(workloads[0]));
+}
@@ -0,0 +1,238 @@
+/**
+ * @file benchMap.c
+ *
+ * @brief Provides the benchmark driver of the ADT Map.
+ * Please note that the MapKey and MapValue types must be 
+ * defined as 'int'.
+ *
+ * The map holds the keys benchKey(0), ..., benchKey(size - 1), inserted
+ * in that order. Zipf-distributed lookups map the popularity rank of a
+ * key to its insertion index through a permutation, so that popular
+ * keys are not simply the first ones inserted.
+ *
+ * The backend is chosen at link time; BACKEND names it in the output.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include <stdlib.h>
+#include "benchCommon.h"
+#include "map.h"
+
+#ifndef BACKEND
+#define BACKEND "unknown"
+#endif
+
+#define ZIPF_THETA 0.99
+
+/** Prime, coprime with the (power of ten) sizes, used to permute indices. */
+#define PERMUTATION_PRIME 1000003L
+
+/** Keeps results from being optimized away. */
+static volatile long sink;
+
+/** Creates a map with 'size' keys, or NULL if the setup did not finish. */
+static PtMap createFilled(int size) {
+	PtMap map = mapCreate();
+	if (map == NULL) return NULL;
+
+	for (int i = 0; i < size; i++) {
+		if (BENCH_TIME_UP(i) || mapPut(map, benchKey(i), i) != MAP_OK) {
+			mapDestroy(&map);
+			return NULL;
+		}
+	}
+
+	return map;
+}
+
+static int zipfKey(BenchZipf *zipf, int size) {
+	return benchKey((int)(benchZipfNext(zipf) * PERMUTATION_PRIME % size));
+}
+
+/** Puts 'size' keys and clears the map with 'clear', repeatedly. */
+static bool fillClear(int size, BenchResult *result, int (*clear)(PtMap)) {
+	PtMap map = mapCreate();
+	if (map == NULL) return false;
+
+	long ops = benchOps(size), done = 0;
+	bool complete = true;
+
+	benchBegin(result);
+	while (done < ops && complete) {
+		for (int i = 0; i < size; i++, done++) {
+			if (BENCH_TIME_UP(done)) {
+				complete = false;
+				break;
+			}
+			mapPut(map, benchKey(i), i);
+		}
+		clear(map);
+	}
+	benchEnd(result, done, complete);
+
+	mapDestroy(&map);
+	return true;
+}
+
+/** Puts 'size' keys and clears the map, repeatedly. */
+static bool putClear(int size, BenchResult *result) {
+	return fillClear(size, result, mapClear);
+}
+
+/** Same as putClear, but the map keeps its memory when cleared. */
+static bool putClearRetain(int size, BenchResult *result) {
+	return fillClear(size, result, mapClearRetain);
+}
+
+/** Gets uniformly random keys, all present. */
+static bool getHit(int size, BenchResult *result) {
+	PtMap map = createFilled(size);
+	if (map == NULL) return false;
+
+	long ops = benchOps(size), done;
+	MapValue value;
+
+	benchBegin(result);
+	for (done = 0; done < ops; done++) {
+		if (BENCH_TIME_UP(done)) break;
+		mapGet(map, benchKey(benchRandomBelow(size)), &value);
+	}
+	benchEnd(result, done, done >= ops);
+
+	mapDestroy(&map);
+	return true;
+}
+
+/** Gets keys that are not present. */
+static bool getMiss(int size, BenchResult *result) {
+	PtMap map = createFilled(size);
+	if (map == NULL) return false;
+
+	long ops = benchOps(size), done;
+	MapValue value;
+
+	benchBegin(result);
+	for (done = 0; done < ops; done++) {
+		if (BENCH_TIME_UP(done)) break;
+		mapGet(map, benchKey(size + benchRandomBelow(size)), &value);
+	}
+	benchEnd(result, done, done >= ops);
+
+	mapDestroy(&map);
+	return true;
+}
+
+/** Gets Zipf-distributed keys, all present. */
+static bool getZipf(int size, BenchResult *result) {
+	PtMap map = createFilled(size);
+	if (map == NULL) return false;
+
+	BenchZipf zipf;
+	benchZipfInit(&zipf, size, ZIPF_THETA);
+
+	long ops = benchOps(size), done;
+	MapValue value;
+
+	benchBegin(result);
+	for (done = 0; done < ops; done++) {
+		if (BENCH_TIME_UP(done)) break;
+		mapGet(map, zipfKey(&zipf, size), &value);
+	}
+	benchEnd(result, done, done >= ops);
+
+	mapDestroy(&map);
+	return true;
+}
+
+/** Gets (90%) or updates (10%) Zipf-distributed keys. */
+static bool mixedZipf(int size, BenchResult *result) {
+	PtMap map = createFilled(size);
+	if (map == NULL) return false;
+
+	BenchZipf zipf;
+	benchZipfInit(&zipf, size, ZIPF_THETA);
+
+	long ops = benchOps(size), done;
+	MapValue value;
+
+	benchBegin(result);
+	for (done = 0; done < ops; done++) {
+		if (BENCH_TIME_UP(done)) break;
+		int key = zipfKey(&zipf, size);
+		if (benchRandomBelow(10) == 0) mapPut(map, key, (int)done);
+		else mapGet(map, key, &value);
+	}
+	benchEnd(result, done, done >= ops);
+
+	mapDestroy(&map);
+	return true;
+}
+
+/** Removes a uniformly random key and puts it back. */
+static bool removePut(int size, BenchResult *result) {
+	PtMap map = createFilled(size);
+	if (map == NULL) return false;
+
+	long ops = benchOps(size), done;
+	MapValue value;
+
+	benchBegin(result);
+	for (done = 0; done < ops; done += 2) {
+		if (BENCH_TIME_UP(done)) break;
+		int key = benchKey(benchRandomBelow(size));
+		mapRemove(map, key, &value);
+		mapPut(map, key, value);
+	}
+	benchEnd(result, done, done >= ops);
+
+	mapDestroy(&map);
+	return true;
+}
+
+/** Visits all entries with an iterator, repeatedly; one operation per entry. */
+static bool iterate(int size, BenchResult *result) {
+	PtMap map = createFilled(size);
+	if (map == NULL) return false;
+
+	long ops = benchOps(size), done = 0;
+	long sum = 0;
+	bool complete = true;
+	MapIterator it;
+
+	benchBegin(result);
+	while (done < ops && complete) {
+		mapIterBegin(map, &it);
+		while (mapIterNext(&it)) {
+			if (BENCH_TIME_UP(done)) {
+				complete = false;
+				break;
+			}
+			sum += mapIterValue(&it);
+			done++;
+		}
+	}
+	benchEnd(result, done, complete);
+
+	sink = sum;
+
+	mapDestroy(&map);
+	return true;
+}
+
+static const BenchWorkload workloads[] = {
+	{ "put-clear", putClear },
+	{ "put-clear-retain", putClearRetain },
+	{ "get-hit", getHit },
+	{ "get-miss", getMiss },
+	{ "get-zipf", getZipf },
+	{ "mixed-zipf", mixedZipf },
+	{ "remove-put", removePut },
+	{ "iterate", iterate }
+};
+
+int main(int argc, char** argv) {
+	return benchMain(argc, argv, "map", BACKEND, workloads,
+						sizeof(workloads) / sizeof(workloads[0]));
+}
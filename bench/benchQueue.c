@@ -0,0 +1,128 @@
+/**
+ * @file benchQueue.c
+ *
+ * @brief Provides the benchmark driver of the ADT Queue.
+ * Please note that the QueueElem type must be defined as 'char'.
+ *
+ * The backend is chosen at link time; BACKEND names it in the output.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include <stdlib.h>
+#include "benchCommon.h"
+#include "queue.h"
+
+#ifndef BACKEND
+#define BACKEND "unknown"
+#endif
+
+/** Creates a queue with 'size' elements, or NULL if the setup did not finish. */
+static PtQueue createFilled(int size) {
+	PtQueue queue = queueCreate();
+	if (queue == NULL) return NULL;
+
+	for (int i = 0; i < size; i++) {
+		if (BENCH_TIME_UP(i) || queueEnqueue(queue, (char)i) != QUEUE_OK) {
+			queueDestroy(&queue);
+			return NULL;
+		}
+	}
+
+	return queue;
+}
+
+/** Enqueues 'size' elements and clears the queue with 'clear', repeatedly. */
+static bool fillClear(int size, BenchResult *result, int (*clear)(PtQueue)) {
+	PtQueue queue = queueCreate();
+	if (queue == NULL) return false;
+
+	long ops = benchOps(size), done = 0;
+	bool complete = true;
+
+	benchBegin(result);
+	while (done < ops && complete) {
+		for (int i = 0; i < size; i++, done++) {
+			if (BENCH_TIME_UP(done)) {
+				complete = false;
+				break;
+			}
+			queueEnqueue(queue, (char)i);
+		}
+		clear(queue);
+	}
+	benchEnd(result, done, complete);
+
+	queueDestroy(&queue);
+	return true;
+}
+
+/** Enqueues 'size' elements and clears the queue, repeatedly. */
+static bool enqueueClear(int size, BenchResult *result) {
+	return fillClear(size, result, queueClear);
+}
+
+/** Same as enqueueClear, but the queue keeps its memory when cleared. */
+static bool enqueueClearRetain(int size, BenchResult *result) {
+	return fillClear(size, result, queueClearRetain);
+}
+
+/** Enqueues and dequeues one element at a time, on a queue of 'size' elements. */
+static bool enqueueDequeue(int size, BenchResult *result) {
+	PtQueue queue = createFilled(size);
+	if (queue == NULL) return false;
+
+	long ops = benchOps(size), done;
+	QueueElem elem;
+
+	benchBegin(result);
+	for (done = 0; done < ops; done += 2) {
+		if (BENCH_TIME_UP(done)) break;
+		queueEnqueue(queue, (char)done);
+		queueDequeue(queue, &elem);
+	}
+	benchEnd(result, done, done >= ops);
+
+	queueDestroy(&queue);
+	return true;
+}
+
+/** Random enqueues, dequeues and peeks, on a queue of 0 to 2 * 'size' elements. */
+static bool mixed(int size, BenchResult *result) {
+	PtQueue queue = createFilled(size);
+	if (queue == NULL) return false;
+
+	long ops = benchOps(size), done, current = size;
+	QueueElem elem;
+
+	benchBegin(result);
+	for (done = 0; done < ops; done++) {
+		if (BENCH_TIME_UP(done)) break;
+		int op = benchRandomBelow(3);
+		if (op == 0 && current >= 2 * size) op = 1;	/* stay within [0, 2 * size] */
+		if (op == 1 && current == 0) op = 0;
+
+		switch (op) {
+			case 0: queueEnqueue(queue, (char)done); current++; break;
+			case 1: queueDequeue(queue, &elem); current--; break;
+			default: queueFront(queue, &elem); break;
+		}
+	}
+	benchEnd(result, done, done >= ops);
+
+	queueDestroy(&queue);
+	return true;
+}
+
+static const BenchWorkload workloads[] = {
+	{ "enqueue-clear", enqueueClear },
+	{ "enqueue-clear-retain", enqueueClearRetain },
+	{ "enqueue-dequeue", enqueueDequeue },
+	{ "mixed", mixed }
+};
+
+int main(int argc, char** argv) {
+	return benchMain(argc, argv, "queue", BACKEND, workloads,
+						sizeof(workloads) / sizeof(workloads[0]));
+}
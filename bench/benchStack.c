@@ -0,0 +1,128 @@
+/**
+ * @file benchStack.c
+ *
+ * @brief Provides the benchmark driver of the ADT Stack.
+ * Please note that the StackElem type must be defined as 'int'.
+ *
+ * The backend is chosen at link time; BACKEND names it in the output.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include <stdlib.h>
+#include "benchCommon.h"
+#include "stack.h"
+
+#ifndef BACKEND
+#define BACKEND "unknown"
+#endif
+
+/** Creates a stack with 'size' elements, or NULL if the setup did not finish. */
+static PtStack createFilled(int size) {
+	PtStack stack = stackCreate();
+	if (stack == NULL) return NULL;
+
+	for (int i = 0; i < size; i++) {
+		if (BENCH_TIME_UP(i) || stackPush(stack, i) != STACK_OK) {
+			stackDestroy(&stack);
+			return NULL;
+		}
+	}
+
+	return stack;
+}
+
+/** Pushes 'size' elements and clears the stack with 'clear', repeatedly. */
+static bool fillClear(int size, BenchResult *result, int (*clear)(PtStack)) {
+	PtStack stack = stackCreate();
+	if (stack == NULL) return false;
+
+	long ops = benchOps(size), done = 0;
+	bool complete = true;
+
+	benchBegin(result);
+	while (done < ops && complete) {
+		for (int i = 0; i < size; i++, done++) {
+			if (BENCH_TIME_UP(done)) {
+				complete = false;
+				break;
+			}
+			stackPush(stack, i);
+		}
+		clear(stack);
+	}
+	benchEnd(result, done, complete);
+
+	stackDestroy(&stack);
+	return true;
+}
+
+/** Pushes 'size' elements and clears the stack, repeatedly. */
+static bool pushClear(int size, BenchResult *result) {
+	return fillClear(size, result, stackClear);
+}
+
+/** Same as pushClear, but the stack keeps its memory when cleared. */
+static bool pushClearRetain(int size, BenchResult *result) {
+	return fillClear(size, result, stackClearRetain);
+}
+
+/** Pushes and pops one element at a time, on a stack of 'size' elements. */
+static bool pushPop(int size, BenchResult *result) {
+	PtStack stack = createFilled(size);
+	if (stack == NULL) return false;
+
+	long ops = benchOps(size), done;
+	StackElem elem;
+
+	benchBegin(result);
+	for (done = 0; done < ops; done += 2) {
+		if (BENCH_TIME_UP(done)) break;
+		stackPush(stack, (int)done);
+		stackPop(stack, &elem);
+	}
+	benchEnd(result, done, done >= ops);
+
+	stackDestroy(&stack);
+	return true;
+}
+
+/** Random pushes, pops and peeks, on a stack of 0 to 2 * 'size' elements. */
+static bool mixed(int size, BenchResult *result) {
+	PtStack stack = createFilled(size);
+	if (stack == NULL) return false;
+
+	long ops = benchOps(size), done, current = size;
+	StackElem elem;
+
+	benchBegin(result);
+	for (done = 0; done < ops; done++) {
+		if (BENCH_TIME_UP(done)) break;
+		int op = benchRandomBelow(3);
+		if (op == 0 && current >= 2 * size) op = 1;	/* stay within [0, 2 * size] */
+		if (op == 1 && current == 0) op = 0;
+
+		switch (op) {
+			case 0: stackPush(stack, (int)done); current++; break;
+			case 1: stackPop(stack, &elem); current--; break;
+			default: stackPeek(stack, &elem); break;
+		}
+	}
+	benchEnd(result, done, done >= ops);
+
+	stackDestroy(&stack);
+	return true;
+}
+
+static const BenchWorkload workloads[] = {
+	{ "push-clear", pushClear },
+	{ "push-clear-retain", pushClearRetain },
+	{ "push-pop", pushPop },
+	{ "mixed", mixed }
+};
+
+int main(int argc, char** argv) {
+	return benchMain(argc, argv, "stack", BACKEND, workloads,
+						sizeof(workloads) / sizeof(workloads[0]));
+}
@@ -0,0 +1,144 @@
+/**
+ * @file adtStats.c
+ *
+ * @brief Provides an implementation of the statistics of the
+ * collection ADTs.
+ *
+ * A latency 'v' below ADT_HISTOGRAM_SUB_BUCKETS has a bucket of its
+ * own; otherwise, with 'e' the position of its most significant bit,
+ * it falls in one of the ADT_HISTOGRAM_SUB_BUCKETS buckets that split
+ * [2^e, 2^(e+1)), selected by the bits that follow the most significant one.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "adtStats.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static const char *operationNames[ADT_OP_KINDS] = { "insert", "lookup", "remove" };
+
+void adtStatsInit(AdtStats *stats) {
+	memset(stats, 0, sizeof(AdtStats));
+
+#ifdef ADT_STATS
+	stats->enabled = true;
+#endif
+}
+
+uint64_t adtStatsClock(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+static int bucketOf(uint64_t value) {
+	if (value < ADT_HISTOGRAM_SUB_BUCKETS) return (int)value;
+
+	int msb = 63 - __builtin_clzll(value);
+	if (msb > ADT_HISTOGRAM_MAX_BITS) return ADT_HISTOGRAM_BUCKETS - 1;
+
+	int sub = (int)(value >> (msb - ADT_HISTOGRAM_SUB_BITS)) & (ADT_HISTOGRAM_SUB_BUCKETS - 1);
+
+	return (msb - ADT_HISTOGRAM_SUB_BITS + 1) * ADT_HISTOGRAM_SUB_BUCKETS + sub;
+}
+
+/** Greatest value that falls in 'bucket'. */
+static long highestOf(int bucket) {
+	if (bucket < ADT_HISTOGRAM_SUB_BUCKETS) return bucket;
+
+	int msb = bucket / ADT_HISTOGRAM_SUB_BUCKETS + ADT_HISTOGRAM_SUB_BITS - 1;
+	int sub = bucket % ADT_HISTOGRAM_SUB_BUCKETS;
+	long width = 1L << (msb - ADT_HISTOGRAM_SUB_BITS);
+
+	return (1L << msb) + (sub + 1) * width - 1;
+}
+
+void adtStatsRecord(AdtStats *stats, AdtOperation kind, uint64_t nanoseconds) {
+	AdtHistogram *histogram = &stats->latency[kind];
+
+	stats->operations[kind]++;
+
+	histogram->count++;
+	histogram->buckets[bucketOf(nanoseconds)]++;
+	if ((long)nanoseconds > histogram->max) histogram->max = (long)nanoseconds;
+}
+
+void adtStatsProbes(AdtStats *stats, long count) {
+	stats->searches++;
+	stats->probes += count;
+	if (count > stats->maxProbes) stats->maxProbes = count;
+}
+
+void adtStatsMerge(AdtStats *into, const AdtStats *from) {
+	for (int kind = 0; kind < ADT_OP_KINDS; kind++) {
+		AdtHistogram *histogram = &into->latency[kind];
+		const AdtHistogram *other = &from->latency[kind];
+
+		into->operations[kind] += from->operations[kind];
+
+		histogram->count += other->count;
+		if (other->max > histogram->max) histogram->max = other->max;
+		for (int b = 0; b < ADT_HISTOGRAM_BUCKETS; b++) {
+			histogram->buckets[b] += other->buckets[b];
+		}
+	}
+
+	into->searches += from->searches;
+	into->probes += from->probes;
+	if (from->maxProbes > into->maxProbes) into->maxProbes = from->maxProbes;
+	into->reallocations += from->reallocations;
+	into->bytesAllocated += from->bytesAllocated;
+}
+
+long adtHistogramPercentile(const AdtHistogram *histogram, double percentile) {
+	if (histogram->count == 0) return 0;
+
+	long rank = (long)(percentile / 100.0 * histogram->count + 0.5);
+	if (rank < 1) rank = 1;
+
+	long seen = 0;
+	for (int b = 0; b < ADT_HISTOGRAM_BUCKETS; b++) {
+		seen += histogram->buckets[b];
+		if (seen >= rank) {
+			long highest = highestOf(b);
+			return (highest < histogram->max) ? highest : histogram->max;
+		}
+	}
+
+	return histogram->max;
+}
+
+void adtStatsPrint(const AdtStats *stats) {
+	if (!stats->enabled) {
+		printf("(Statistics DISABLED: compile with ADT_STATS defined)\n");
+		return;
+	}
+
+	printf("Operations: %ld inserts, %ld lookups, %ld removes\n",
+			stats->operations[ADT_OP_INSERT], stats->operations[ADT_OP_LOOKUP],
+			stats->operations[ADT_OP_REMOVE]);
+
+	printf("Probes: %ld in %ld searches (%.2f on average, %ld at most)\n",
+			stats->probes, stats->searches,
+			(stats->searches > 0) ? (double)stats->probes / stats->searches : 0.0,
+			stats->maxProbes);
+
+	printf("Memory: %ld bytes allocated, %ld reallocations\n",
+			stats->bytesAllocated, stats->reallocations);
+
+	for (int kind = 0; kind < ADT_OP_KINDS; kind++) {
+		const AdtHistogram *histogram = &stats->latency[kind];
+		if (histogram->count == 0) continue;
+
+		printf("Latency of %-6s (ns): p50 %ld, p99 %ld, p99.9 %ld, max %ld\n",
+				operationNames[kind],
+				adtHistogramPercentile(histogram, 50),
+				adtHistogramPercentile(histogram, 99),
+				adtHistogramPercentile(histogram, 99.9),
+				histogram->max);
+	}
+}
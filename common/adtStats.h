@@ -0,0 +1,172 @@
+/**
+ * @file adtStats.h
+ * @brief Definition of the statistics recorded by each instance
+ * of the collection ADTs (Stack, Queue, List and Map).
+ *
+ * Statistics are opt-in: they are only recorded when the ADTs are
+ * compiled with ADT_STATS defined (e.g., 'make hashtable STATS=1').
+ * Otherwise, the ADT_STATS_* macros below expand to nothing, so the
+ * instances are neither larger nor slower, and the *Stats operation
+ * of each ADT returns statistics with 'enabled' set to false.
+ *
+ * Each instance counts its single-element operations by kind (insert,
+ * lookup and remove; see AdtOperation), the probes of its searches,
+ * i.e., the keys compared or the slots or nodes visited, the
+ * reallocations of its arrays and the bytes it allocated. The latency
+ * of each kind of operation is recorded in a histogram of logarithmic
+ * buckets, each power of two of nanoseconds split in
+ * ADT_HISTOGRAM_SUB_BUCKETS linear buckets (as in HdrHistogram), so
+ * percentiles are reported within 1 / ADT_HISTOGRAM_SUB_BUCKETS of
+ * their value.
+ *
+ * Recording is not thread-safe: the statistics of an instance must
+ * only be updated by one thread at a time.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Linear buckets in each power of two; must be a power of two. */
+#define ADT_HISTOGRAM_SUB_BUCKETS 8
+
+/** log2(ADT_HISTOGRAM_SUB_BUCKETS). */
+#define ADT_HISTOGRAM_SUB_BITS 3
+
+/** Latencies up to 2^ADT_HISTOGRAM_MAX_BITS ns (about 18 minutes) are recorded. */
+#define ADT_HISTOGRAM_MAX_BITS 40
+
+/** Values below ADT_HISTOGRAM_SUB_BUCKETS, then each power of two up to the maximum. */
+#define ADT_HISTOGRAM_BUCKETS \
+	((ADT_HISTOGRAM_MAX_BITS - ADT_HISTOGRAM_SUB_BITS + 2) * ADT_HISTOGRAM_SUB_BUCKETS)
+
+/** Kinds of operations, e.g., ADT_OP_INSERT for stackPush or mapPut. */
+typedef enum adtOperation {
+	ADT_OP_INSERT,
+	ADT_OP_LOOKUP,
+	ADT_OP_REMOVE,
+	ADT_OP_KINDS		/* number of kinds */
+} AdtOperation;
+
+/** Histogram of latencies, in nanoseconds. */
+typedef struct adtHistogram {
+	long count;
+	long max;
+	long buckets[ADT_HISTOGRAM_BUCKETS];
+} AdtHistogram;
+
+/** Statistics of an instance. */
+typedef struct adtStats {
+	bool enabled;			/* false if compiled without ADT_STATS */
+	long operations[ADT_OP_KINDS];
+	long searches;			/* searches that recorded probes */
+	long probes;			/* keys compared or slots/nodes visited, in total */
+	long maxProbes;			/* probes of the longest search */
+	long reallocations;		/* arrays or tables resized */
+	long bytesAllocated;	/* in total, including reallocations */
+	AdtHistogram latency[ADT_OP_KINDS];
+} AdtStats;
+
+#ifdef ADT_STATS
+
+/** Declares the statistics of an instance, as a member of its struct. */
+#define ADT_STATS_MEMBER AdtStats stats;
+
+#define ADT_STATS_INIT(stats) adtStatsInit(&(stats))
+
+/** Starts timing an operation, declaring the variable 'start'. */
+#define ADT_STATS_START(start) uint64_t start = adtStatsClock()
+
+/** Counts an operation of a given kind, timed since ADT_STATS_START. */
+#define ADT_STATS_STOP(stats, kind, start) \
+	adtStatsRecord(&(stats), (kind), adtStatsClock() - (start))
+
+#define ADT_STATS_PROBES(stats, count) adtStatsProbes(&(stats), (count))
+
+#define ADT_STATS_ALLOC(stats, bytes) ((stats).bytesAllocated += (long)(bytes))
+
+#define ADT_STATS_REALLOC(stats, bytes) \
+	((stats).reallocations++, (stats).bytesAllocated += (long)(bytes))
+
+/** Copies the statistics of an instance to '*ptStats'. */
+#define ADT_STATS_COPY(stats, ptStats) (*(ptStats) = (stats))
+
+/** Adds the statistics of a part of an instance (e.g., a shard) to '*ptStats'. */
+#define ADT_STATS_MERGE(stats, ptStats) adtStatsMerge((ptStats), &(stats))
+
+#else
+
+#define ADT_STATS_MEMBER
+#define ADT_STATS_INIT(stats) ((void)0)
+#define ADT_STATS_START(start) ((void)0)
+#define ADT_STATS_STOP(stats, kind, start) ((void)0)
+#define ADT_STATS_PROBES(stats, count) ((void)0)
+#define ADT_STATS_ALLOC(stats, bytes) ((void)0)
+#define ADT_STATS_REALLOC(stats, bytes) ((void)0)
+#define ADT_STATS_COPY(stats, ptStats) adtStatsInit(ptStats)
+#define ADT_STATS_MERGE(stats, ptStats) ((void)0)
+
+#endif
+
+/**
+ * @brief Initializes statistics with no records.
+ *
+ * @param stats [in] address of the statistics
+ */
+void adtStatsInit(AdtStats *stats);
+
+/**
+ * @brief Reads a monotonic clock.
+ *
+ * @return current time, in nanoseconds
+ */
+uint64_t adtStatsClock(void);
+
+/**
+ * @brief Counts an operation and records its latency.
+ *
+ * @param stats [in] address of the statistics
+ * @param kind [in] kind of the operation
+ * @param nanoseconds [in] latency of the operation
+ */
+void adtStatsRecord(AdtStats *stats, AdtOperation kind, uint64_t nanoseconds);
+
+/**
+ * @brief Records the probes of a search.
+ *
+ * @param stats [in] address of the statistics
+ * @param count [in] keys compared or slots/nodes visited by the search
+ */
+void adtStatsProbes(AdtStats *stats, long count);
+
+/**
+ * @brief Adds statistics to others, e.g., to combine those
+ * recorded separately by each shard of an instance.
+ *
+ * @param into [in] address of the statistics to add to
+ * @param from [in] address of the statistics to add
+ */
+void adtStatsMerge(AdtStats *into, const AdtStats *from);
+
+/**
+ * @brief Computes a percentile of the latencies in a histogram.
+ *
+ * @param histogram [in] address of the histogram
+ * @param percentile [in] percentile, in [0, 100]
+ *
+ * @return the greatest latency of the bucket holding the percentile, or
+ * @return 0 if the histogram is empty
+ */
+long adtHistogramPercentile(const AdtHistogram *histogram, double percentile);
+
+/**
+ * @brief Prints statistics, with the 50th, 99th and 99.9th percentiles
+ * and the maximum of the latency of each kind of operation.
+ *
+ * @param stats [in] address of the statistics
+ */
+void adtStatsPrint(const AdtStats *stats);
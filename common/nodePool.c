@@ -0,0 +1,223 @@
+/**
+ * @file nodePool.c
+ *
+ * @brief Provides an implementation of the node pool with
+ * a list of chunks and a free list of released nodes.
+ *
+ * Chunks grow geometrically (from MIN_CHUNK_NODES up to
+ * MAX_CHUNK_NODES nodes), so a pool holding n nodes
+ * owns O(log n + n / MAX_CHUNK_NODES) chunks.
+ *
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#include "nodePool.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+#define MIN_CHUNK_NODES 16
+#define MAX_CHUNK_NODES 4096
+
+/** Header of each chunk (or of each node, with NODEPOOL_USE_MALLOC). */
+typedef union blockHeader {
+	struct {
+		union blockHeader *next;
+		union blockHeader *prev;
+	} link;
+	max_align_t alignment;	/* nodes that follow the header are suitably aligned */
+} BlockHeader;
+
+/** A released node is reused to hold the link of the free list. */
+typedef struct freeNode {
+	struct freeNode *next;
+} FreeNode;
+
+typedef struct nodePoolImpl {
+	size_t nodeSize;
+	BlockHeader *blocks;		/* list of chunks (or of nodes) */
+	FreeNode *freeList;
+	size_t freeCount;			/* nodes in the free list */
+	char *unused;				/* never allocated nodes of the newest chunk */
+	size_t unusedCount;
+	size_t nextChunkNodes;
+	size_t bytesAllocated;		/* since creation */
+} NodePoolImpl;
+
+PtNodePool nodePoolCreate(size_t nodeSize) {
+	PtNodePool pool = (PtNodePool)malloc(sizeof(NodePoolImpl));
+	if (pool == NULL) return NULL;
+
+	/* a node must be able to hold, and be aligned for, the free list link */
+	nodeSize = (nodeSize + sizeof(FreeNode) - 1) / sizeof(FreeNode) * sizeof(FreeNode);
+
+	pool->nodeSize = nodeSize;
+	pool->blocks = NULL;
+	pool->freeList = NULL;
+	pool->freeCount = 0;
+	pool->unused = NULL;
+	pool->unusedCount = 0;
+	pool->nextChunkNodes = MIN_CHUNK_NODES;
+	pool->bytesAllocated = 0;
+
+	return pool;
+}
+
+int nodePoolDestroy(PtNodePool *ptPool) {
+	PtNodePool pool = *ptPool;
+	if (pool == NULL) return NODEPOOL_NULL;
+
+	nodePoolReset(pool);
+	free(pool);
+
+	*ptPool = NULL;
+
+	return NODEPOOL_OK;
+}
+
+size_t nodePoolBytesAllocated(PtNodePool pool) {
+	if (pool == NULL) return 0;
+
+	return pool->bytesAllocated;
+}
+
+#ifndef NODEPOOL_USE_MALLOC
+
+static bool addChunk(PtNodePool pool, size_t nodes) {
+	size_t bytes = sizeof(BlockHeader) + nodes * pool->nodeSize;
+
+	BlockHeader *chunk = (BlockHeader*)malloc(bytes);
+	if (chunk == NULL) return false;
+
+	pool->bytesAllocated += bytes;
+
+	chunk->link.next = pool->blocks;
+	pool->blocks = chunk;
+
+	pool->unused = (char*)(chunk + 1);
+	pool->unusedCount = nodes;
+
+	return true;
+}
+
+void* nodePoolAlloc(PtNodePool pool) {
+	if (pool == NULL) return NULL;
+
+	if (pool->freeList != NULL) {
+		FreeNode *node = pool->freeList;
+		pool->freeList = node->next;
+		pool->freeCount--;
+		return node;
+	}
+
+	if (pool->unusedCount == 0) {
+		if (!addChunk(pool, pool->nextChunkNodes)) return NULL;
+		if (pool->nextChunkNodes < MAX_CHUNK_NODES) pool->nextChunkNodes *= 2;
+	}
+
+	void *node = pool->unused;
+	pool->unused += pool->nodeSize;
+	pool->unusedCount--;
+
+	return node;
+}
+
+void nodePoolFree(PtNodePool pool, void *node) {
+	if (pool == NULL || node == NULL) return;
+
+	FreeNode *released = (FreeNode*)node;
+	released->next = pool->freeList;
+	pool->freeList = released;
+	pool->freeCount++;
+}
+
+int nodePoolReserve(PtNodePool pool, size_t count) {
+	if (pool == NULL) return NODEPOOL_NULL;
+
+	if (pool->freeCount + pool->unusedCount >= count) return NODEPOOL_OK;
+
+	/* the new chunk replaces the newest one: keep its unused nodes */
+	while (pool->unusedCount > 0) {
+		nodePoolFree(pool, pool->unused);
+		pool->unused += pool->nodeSize;
+		pool->unusedCount--;
+	}
+
+	if (!addChunk(pool, count - pool->freeCount)) return NODEPOOL_NO_MEMORY;
+
+	return NODEPOOL_OK;
+}
+
+int nodePoolReset(PtNodePool pool) {
+	if (pool == NULL) return NODEPOOL_NULL;
+
+	BlockHeader *current = pool->blocks;
+	while (current != NULL) {
+		BlockHeader *remove = current;
+		current = current->link.next;
+		free(remove);
+	}
+
+	pool->blocks = NULL;
+	pool->freeList = NULL;
+	pool->freeCount = 0;
+	pool->unused = NULL;
+	pool->unusedCount = 0;
+
+	return NODEPOOL_OK;
+}
+
+#else /* NODEPOOL_USE_MALLOC: one block per node, linked to allow nodePoolReset */
+
+void* nodePoolAlloc(PtNodePool pool) {
+	if (pool == NULL) return NULL;
+
+	BlockHeader *block = (BlockHeader*)malloc(sizeof(BlockHeader) + pool->nodeSize);
+	if (block == NULL) return NULL;
+
+	pool->bytesAllocated += sizeof(BlockHeader) + pool->nodeSize;
+
+	block->link.prev = NULL;
+	block->link.next = pool->blocks;
+	if (pool->blocks != NULL) pool->blocks->link.prev = block;
+	pool->blocks = block;
+
+	return block + 1;
+}
+
+void nodePoolFree(PtNodePool pool, void *node) {
+	if (pool == NULL || node == NULL) return;
+
+	BlockHeader *block = (BlockHeader*)node - 1;
+
+	if (block->link.prev != NULL) block->link.prev->link.next = block->link.next;
+	else pool->blocks = block->link.next;
+	if (block->link.next != NULL) block->link.next->link.prev = block->link.prev;
+
+	free(block);
+}
+
+int nodePoolReserve(PtNodePool pool, size_t count) {
+	if (pool == NULL) return NODEPOOL_NULL;
+
+	(void)count; /* nodes are allocated one by one */
+
+	return NODEPOOL_OK;
+}
+
+int nodePoolReset(PtNodePool pool) {
+	if (pool == NULL) return NODEPOOL_NULL;
+
+	BlockHeader *current = pool->blocks;
+	while (current != NULL) {
+		BlockHeader *remove = current;
+		current = current->link.next;
+		free(remove);
+	}
+
+	pool->blocks = NULL;
+
+	return NODEPOOL_OK;
+}
+
+#endif
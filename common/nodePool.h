@@ -0,0 +1,114 @@
+/**
+ * @file nodePool.h
+ * @brief Definition of a pool allocator of fixed-size nodes.
+ * 
+ * Defines the type PtNodePool and associated operations. A pool
+ * hands out nodes carved from large chunks and keeps released nodes
+ * in a free list for reuse, so allocating or releasing a node is O(1)
+ * and does not call malloc/free. All nodes of a pool are released
+ * at once, in O(number of chunks), by nodePoolReset or nodePoolDestroy.
+ * 
+ * Linked data structures own one pool per instance, so that nodes of
+ * different instances never share chunks.
+ * 
+ * Compiling with NODEPOOL_USE_MALLOC defined makes every node an 
+ * individual malloc'ed block, so that tools such as AddressSanitizer
+ * or Valgrind can track each node. This is meant for debugging only.
+ * 
+ * @author Bruno Silva (brunomnsilva@gmail.com)
+ * @bug No known bugs.
+ */
+
+#pragma once
+
+#define NODEPOOL_OK           0
+#define NODEPOOL_NULL         1
+#define NODEPOOL_NO_MEMORY    2
+
+#include <stddef.h>
+
+/** Forward declaration of the data structure. */
+struct nodePoolImpl;
+
+/** Definition of pointer to the  data stucture. */
+typedef struct nodePoolImpl *PtNodePool;
+
+/**
+ * @brief Creates a new empty pool.
+ * 
+ * @param nodeSize [in] size, in bytes, of each node (e.g., sizeof(Node))
+ * 
+ * @return PtNodePool pointer to allocated data structure, or
+ * @return NULL if unsufficient memory for allocation
+ */
+PtNodePool nodePoolCreate(size_t nodeSize);
+
+/**
+ * @brief Free all resources of a pool, including all its nodes.
+ * 
+ * @param ptPool [in] ADDRESS OF pointer to the pool
+ * 
+ * @return NODEPOOL_OK if success, or
+ * @return NODEPOOL_NULL if '*ptPool' is NULL 
+ */
+int nodePoolDestroy(PtNodePool *ptPool);
+
+/**
+ * @brief Allocates a node from a pool.
+ * 
+ * The contents of the node are undefined.
+ * 
+ * @param pool [in] pointer to the pool
+ * 
+ * @return address of the node, or
+ * @return NULL if unsufficient memory for allocation or 'pool' is NULL
+ */
+void* nodePoolAlloc(PtNodePool pool);
+
+/**
+ * @brief Returns a node to the pool it was allocated from.
+ * 
+ * @param pool [in] pointer to the pool
+ * @param node [in] address of the node
+ */
+void nodePoolFree(PtNodePool pool, void *node);
+
+/**
+ * @brief Reserves memory for a number of nodes.
+ * 
+ * Ensures that the next 'count' calls to nodePoolAlloc do not
+ * allocate memory, by allocating a single chunk if needed.
+ * With NODEPOOL_USE_MALLOC defined, this does nothing.
+ * 
+ * @param pool [in] pointer to the pool
+ * @param count [in] number of nodes to reserve
+ * 
+ * @return NODEPOOL_OK if successful, or
+ * @return NODEPOOL_NO_MEMORY if unsufficient memory for allocation, or
+ * @return NODEPOOL_NULL if 'pool' is NULL 
+ */
+int nodePoolReserve(PtNodePool pool, size_t count);
+
+/**
+ * @brief Releases all nodes of a pool at once.
+ * 
+ * All addresses previously returned by nodePoolAlloc become
+ * invalid; the pool remains usable.
+ * 
+ * @param pool [in] pointer to the pool
+ * 
+ * @return NODEPOOL_OK if successful, or
+ * @return NODEPOOL_NULL if 'pool' is NULL 
+ */
+int nodePoolReset(PtNodePool pool);
+
+/**
+ * @brief Retrieves the number of bytes a pool allocated since its
+ * creation, including memory already released.
+ * 
+ * @param pool [in] pointer to the pool
+ * 
+ * @return number of bytes, or
+ * @return 0 if 'pool' is NULL 
+ */
+size_t nodePoolBytesAllocated(PtNodePool pool);